@@ -18,7 +18,7 @@ NSString *const UAAttributePlatform = @"ios";
 @implementation UAAttributeAPIClient
 
 + (instancetype)clientWithConfig:(UARuntimeConfig *)config {
-    return [UAAttributeAPIClient clientWithConfig:config session:[UARequestSession sessionWithConfig:config]];
+    return [UAAttributeAPIClient clientWithConfig:config session:[UARequestSession sessionWithConfig:config priority:UARequestPriorityRegistration]];
 }
 
 + (instancetype)clientWithConfig:(UARuntimeConfig *)config session:(UARequestSession *)session {
@@ -1,7 +1,7 @@
 /* Copyright Airship and Contributors */
 
 #import <Foundation/Foundation.h>
-#import "UAUtils.h"
+#import "UAUtils+Internal.h"
 #import "UAChannel.h"
 #import "UAAttributePendingMutations+Internal.h"
 #import "UAAttributeMutations+Internal.h"
@@ -68,7 +68,7 @@ NSString *const UAAttributeRemoveActionKey = @"remove";
 - (NSArray <NSDictionary *>*)mutationsPayload:(UAAttributeMutations *)mutations timestampedWithDate:(UADate *)date {
     NSMutableArray *mutableArr = [NSMutableArray arrayWithArray:mutations.mutationsPayload];
 
-    NSDateFormatter *isoDateFormatter = [UAUtils ISODateFormatterUTCWithDelimiter];
+    NSDateFormatter *isoDateFormatter = [UAUtils sharedISODateFormatterUTCWithDelimiter];
     NSString *timestamp = [isoDateFormatter stringFromDate:date.now];
 
     for (int i = 0; i < mutableArr.count; i++) {
@@ -275,6 +275,29 @@ typedef NS_ENUM(NSInteger, UAAutomationScheduleReadyResult) {
                      edits:(UAScheduleEdits *)edits
          completionHandler:(void (^)(UASchedule * __nullable))completionHandler;
 
+/**
+ * Edits schedules and schedules new ones in a single store transaction, with one fetch
+ * for all the edited schedules and one save.
+ *
+ * @param edits The edits to apply, keyed by schedule identifier.
+ * @param scheduleInfos The schedule infos of the new schedules.
+ * @param metadata The new schedules' optional metadata.
+ * @param completionHandler The completion handler with the new schedules.
+ */
+- (void)editSchedules:(NSDictionary<NSString *, UAScheduleEdits *> *)edits
+     newScheduleInfos:(NSArray<UAScheduleInfo *> *)scheduleInfos
+             metadata:(nullable NSDictionary *)metadata
+    completionHandler:(nullable void (^)(NSArray<UASchedule *> *))completionHandler;
+
+/**
+ * Gets schedule identifiers keyed by group, without loading the schedules.
+ *
+ * @param predicate An optional predicate to filter the schedules.
+ * @param completionHandler The completion handler with the schedule identifiers keyed by group.
+ */
+- (void)getScheduleIDsByGroupWithPredicate:(nullable NSPredicate *)predicate
+                         completionHandler:(void (^)(NSDictionary<NSString *, NSString *> *))completionHandler;
+
 @end
 
 NS_ASSUME_NONNULL_END
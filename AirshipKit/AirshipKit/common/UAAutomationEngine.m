@@ -14,11 +14,28 @@
 #import "UACustomEvent+Internal.h"
 #import "NSJSONSerialization+UAAdditions.h"
 #import "UAJSONPredicate.h"
+#import "UAJSONCompiledPredicate+Internal.h"
 #import "UAGlobal.h"
 #import "UAirship.h"
 #import "UAApplicationMetrics.h"
 #import "UAScheduleEdits+Internal.h"
 #import "UAAppStateTrackerFactory+Internal.h"
+#import "UATimerQueue+Internal.h"
+
+/**
+ * Maximum number of compiled trigger predicates kept in memory.
+ */
+static NSUInteger const UAAutomationEnginePredicateCacheLimit = 1000;
+
+/**
+ * Maximum number of decoded schedules kept in memory.
+ */
+static NSUInteger const UAAutomationEngineScheduleCacheLimit = 1000;
+
+/**
+ * Expiry timer identifier.
+ */
+static NSString * const UAAutomationEngineExpiryTimerID = @"expiry";
 
 @interface UAAutomationStateCondition : NSObject
 
@@ -44,9 +61,63 @@
 
 @end
 
+/**
+ * An immutable snapshot of the app state used to check schedule conditions.
+ */
+@interface UAAutomationConditionsState : NSObject
+
+@property (nonatomic, copy, readonly, nullable) NSString *screen;
+@property (nonatomic, copy, readonly, nullable) NSString *regionID;
+@property (nonatomic, assign, readonly) BOOL foregrounded;
+
+- (instancetype)initWithScreen:(nullable NSString *)screen regionID:(nullable NSString *)regionID foregrounded:(BOOL)foregrounded;
+
+@end
+
+@implementation UAAutomationConditionsState
+
+- (instancetype)initWithScreen:(NSString *)screen regionID:(NSString *)regionID foregrounded:(BOOL)foregrounded {
+    self = [super init];
+    if (self) {
+        _screen = [screen copy];
+        _regionID = [regionID copy];
+        _foregrounded = foregrounded;
+    }
+    return self;
+}
+
+@end
+
+/**
+ * A decoded schedule and the modification stamp of the data it was decoded from.
+ */
+@interface UAAutomationCachedSchedule : NSObject
+
+@property (nonatomic, strong, nonnull) UASchedule *schedule;
+@property (nonatomic, strong, nonnull) NSNumber *modificationStamp;
+
+- (instancetype)initWithSchedule:(UASchedule *)schedule modificationStamp:(NSNumber *)modificationStamp;
+
+@end
+
+@implementation UAAutomationCachedSchedule
+
+- (instancetype)initWithSchedule:(UASchedule *)schedule modificationStamp:(NSNumber *)modificationStamp {
+    self = [super init];
+    if (self) {
+        self.schedule = schedule;
+        self.modificationStamp = modificationStamp;
+    }
+    return self;
+}
+
+@end
+
 @interface UAAutomationEngine()
 @property (nonatomic, strong) id<UAAppStateTracker> appStateTracker;
-@property (nonatomic, strong) UATimerScheduler *timerScheduler;
+@property (nonatomic, strong) UATimerQueue *timerQueue;
+@property (nonatomic, strong) UATimerQueue *expiryTimerQueue;
+@property (nonatomic, strong, nullable) NSDate *nextExpiryDate;
 @property (nonnull, strong) UADispatcher *dispatcher;
 @property (nonnull, strong) UIApplication *application;
 @property (nonnull, strong) NSNotificationCenter *notificationCenter;
@@ -54,12 +125,15 @@
 
 @property (nonatomic, copy) NSString *currentScreen;
 @property (nonatomic, copy, nullable) NSString * currentRegion;
-@property (nonatomic, strong) NSMutableArray *activeTimers;
 @property (nonatomic, assign) UIBackgroundTaskIdentifier backgroundTaskIdentifier;
 @property (nonatomic, assign) BOOL isStarted;
 @property (nonnull, strong) NSMutableDictionary *stateConditions;
 @property (atomic, assign) BOOL paused;
-@property (nonatomic, readonly) BOOL isForegrounded;
+@property (atomic, strong) UAAutomationConditionsState *conditionsState;
+@property (nonatomic, strong) NSMutableSet<NSString *> *executionAttemptIDs;
+@property (nonatomic, assign) NSUInteger executionAttemptsGeneration;
+@property (nonatomic, strong) NSCache<NSData *, id> *predicateCache;
+@property (nonatomic, strong) NSCache<NSString *, UAAutomationCachedSchedule *> *scheduleCache;
 
 @end
 
@@ -83,15 +157,23 @@
     if (self) {
         self.automationStore = automationStore;
         self.appStateTracker = appStateTracker;
-        self.timerScheduler = timerScheduler;
+        self.timerQueue = [UATimerQueue timerQueueWithTimerScheduler:timerScheduler date:date];
+        self.expiryTimerQueue = [UATimerQueue timerQueueWithTimerScheduler:timerScheduler date:date];
         self.notificationCenter = notificationCenter;
         self.dispatcher = dispatcher;
         self.application = application;
         self.date = date;
 
-        self.activeTimers = [NSMutableArray array];
         self.stateConditions = [NSMutableDictionary dictionary];
+        self.executionAttemptIDs = [NSMutableSet set];
+        self.conditionsState = [[UAAutomationConditionsState alloc] initWithScreen:nil regionID:nil foregrounded:NO];
         self.paused = NO;
+
+        self.predicateCache = [[NSCache alloc] init];
+        self.predicateCache.countLimit = UAAutomationEnginePredicateCacheLimit;
+
+        self.scheduleCache = [[NSCache alloc] init];
+        self.scheduleCache.countLimit = UAAutomationEngineScheduleCacheLimit;
     }
 
     return self;
@@ -150,6 +232,7 @@
                                     name:UARegionEventAdded
                                   object:nil];
 
+    [self updateConditionsState];
     [self cleanSchedules];
     [self resetExecutingSchedules];
     [self rescheduleTimers];
@@ -167,6 +250,7 @@
     }
 
     [self cancelTimers];
+    [self cancelExpiryTimer];
     self.appStateTracker.stateTrackerDelegate = nil;
     [self.notificationCenter removeObserver:self];
     [self.stateConditions removeAllObjects];
@@ -202,8 +286,6 @@
         return;
     }
 
-    [self cleanSchedules];
-
     // Create a schedule to save
     UASchedule *schedule = [UASchedule scheduleWithIdentifier:[NSUUID UUID].UUIDString
                                                          info:scheduleInfo
@@ -211,11 +293,12 @@
 
     // Try to save the schedule
     UA_WEAKIFY(self);
-    [self.automationStore saveSchedule:schedule completionHandler:^(BOOL success) {
+    [self saveSchedules:@[schedule] completionHandler:^(BOOL success) {
         UA_STRONGIFY(self);
 
         // If saving the schedule was successful, process any compound triggers
         if (success) {
+            [self scheduleExpiryTimerForSchedules:@[schedule]];
             [self.dispatcher dispatchAsync:^{
                 UA_STRONGIFY(self);
                 [self checkCompoundTriggerState:@[schedule]];
@@ -231,8 +314,6 @@
 }
 
 - (void)scheduleMultiple:(NSArray<UAScheduleInfo *> *)scheduleInfos metadata:(nullable NSDictionary *)metadata completionHandler:(void (^)(NSArray <UASchedule *> *))completionHandler {
-    [self cleanSchedules];
-
     // Create schedules to save (only allow valid schedules)
     NSMutableArray<UASchedule *> *schedules = [NSMutableArray arrayWithCapacity:scheduleInfos.count];
 
@@ -251,10 +332,11 @@
 
     // Try to save the schedules
     UA_WEAKIFY(self);
-    [self.automationStore saveSchedules:schedules completionHandler:^(BOOL success) {
+    [self saveSchedules:schedules completionHandler:^(BOOL success) {
         UA_STRONGIFY(self);
 
         if (success) {
+            [self scheduleExpiryTimerForSchedules:schedules];
             [self.dispatcher dispatchAsync:^{
                 UA_STRONGIFY(self);
                 [self checkCompoundTriggerState:schedules];
@@ -270,6 +352,8 @@
 }
 
 - (void)cancelScheduleWithID:(NSString *)identifier {
+    [self invalidateExecutionAttempts];
+
     UA_WEAKIFY(self)
     [self.automationStore getSchedule:identifier completionHandler:^(UAScheduleData * _Nullable scheduleData) {
         UA_STRONGIFY(self)
@@ -277,11 +361,18 @@
         [self notifyDelegateOnScheduleCancelled:schedule];
     }];
 
-    [self.automationStore deleteSchedule:identifier];
+    // The decoded schedule is dropped on the store's queue with the data, so a queued lookup can not cache it again
+    [self.automationStore deleteSchedule:identifier completionHandler:^{
+        UA_STRONGIFY(self)
+        [self.scheduleCache removeObjectForKey:identifier];
+    }];
+
     [self cancelTimersWithIdentifiers:[NSSet setWithArray:@[identifier]]];
 }
 
 - (void)cancelAll {
+    [self invalidateExecutionAttempts];
+
     UA_WEAKIFY(self)
     [self.automationStore getAllSchedules:^(NSArray<UAScheduleData *> * _Nonnull scheduleDatas) {
         UA_STRONGIFY(self)
@@ -290,11 +381,18 @@
             [self notifyDelegateOnScheduleCancelled:schedule];
         }
     }];
-    [self.automationStore deleteAllSchedules];
+    [self.automationStore deleteAllSchedules:^{
+        UA_STRONGIFY(self)
+        [self.scheduleCache removeAllObjects];
+    }];
+
+    [self.predicateCache removeAllObjects];
     [self cancelTimers];
 }
 
 - (void)cancelSchedulesWithGroup:(NSString *)group {
+    [self invalidateExecutionAttempts];
+
     UA_WEAKIFY(self)
     [self.automationStore getSchedules:group completionHandler:^(NSArray<UAScheduleData *> * _Nonnull scheduleDatas) {
         UA_STRONGIFY(self)
@@ -304,7 +402,11 @@
         }
     }];
 
-    [self.automationStore deleteSchedules:group];
+    // The group's identifiers are not known up front, so all decoded schedules are dropped
+    [self.automationStore deleteSchedules:group completionHandler:^{
+        UA_STRONGIFY(self)
+        [self.scheduleCache removeAllObjects];
+    }];
     [self cancelTimersWithGroup:group];
 }
 
@@ -384,59 +486,196 @@
                      edits:(UAScheduleEdits *)edits
          completionHandler:(void (^)(UASchedule *))completionHandler {
 
+    [self invalidateExecutionAttempts];
+
     UA_WEAKIFY(self)
     [self.automationStore getSchedule:identifier includingExpired:YES completionHandler:^(UAScheduleData * _Nullable scheduleData) {
         UA_STRONGIFY(self)
 
         UASchedule *schedule = nil;
         if (scheduleData) {
-            [UAAutomationEngine applyEdits:edits toData:scheduleData];
+            schedule = [self applyEdits:edits toScheduleData:scheduleData];
+        }
 
-            BOOL overLimit = [scheduleData isOverLimit];
-            BOOL isExpired = [scheduleData isExpired];
+        if (completionHandler) {
+            [self.dispatcher dispatchAsync:^{
+                completionHandler(schedule);
+            }];
+        }
+    }];
+}
 
-            // Check if the schedule needs to be rehabilitated or finished due to the edits
-            if ([scheduleData.executionState unsignedIntegerValue] == UAScheduleStateFinished && !overLimit && !isExpired) {
-                NSDate *finishDate = scheduleData.executionStateChangeDate;
-                scheduleData.executionState = @(UAScheduleStateIdle);
+- (void)editSchedules:(NSDictionary<NSString *, UAScheduleEdits *> *)edits
+     newScheduleInfos:(NSArray<UAScheduleInfo *> *)scheduleInfos
+             metadata:(nullable NSDictionary *)metadata
+    completionHandler:(void (^)(NSArray<UASchedule *> *))completionHandler {
+
+    if (edits.count) {
+        [self invalidateExecutionAttempts];
+    }
 
-                schedule = [self scheduleFromData:scheduleData];
+    // Create schedules to save (only allow valid schedules)
+    NSMutableArray<UASchedule *> *schedules = [NSMutableArray arrayWithCapacity:scheduleInfos.count];
+    for (UAScheduleInfo *scheduleInfo in scheduleInfos) {
+        if (scheduleInfo.isValid) {
+            UASchedule *schedule = [UASchedule scheduleWithIdentifier:[NSUUID UUID].UUIDString info:scheduleInfo metadata:metadata];
+            [schedules addObject:schedule];
+        }
+    }
 
-                // Handle any state changes that might have been missed while the schedule was finished
-                UA_WEAKIFY(self);
-                [self.dispatcher dispatchAsync:^{
-                    UA_STRONGIFY(self);
-                    [self checkCompoundTriggerState:@[schedule] forStateNewerThanDate:finishDate];
-                }];
-            } else if ([scheduleData.executionState unsignedIntegerValue] != UAScheduleStateFinished && (overLimit || isExpired)) {
-                schedule = [self scheduleFromData:scheduleData];
+    UA_WEAKIFY(self)
+    void (^savedHandler)(BOOL) = ^(BOOL success) {
+        UA_STRONGIFY(self)
 
-                if (overLimit) {
-                    [self notifyDelegateOnScheduleLimitReached:schedule];
-                }
-                if (isExpired) {
-                    [self notifyDelegateOnScheduleExpired:schedule];
-                }
-                [self finishSchedule:scheduleData];
-            }
+        if (success && schedules.count) {
+            [self scheduleExpiryTimerForSchedules:schedules];
+            [self.dispatcher dispatchAsync:^{
+                UA_STRONGIFY(self);
+                [self checkCompoundTriggerState:schedules];
+            }];
         }
 
         if (completionHandler) {
             [self.dispatcher dispatchAsync:^{
-                completionHandler(schedule);
+                completionHandler(success ? schedules : @[]);
             }];
         }
+    };
+
+    [self.automationStore editSchedulesWithIDs:edits.allKeys editBlock:^(NSArray<UAScheduleData *> *schedulesData) {
+        UA_STRONGIFY(self)
+        for (UAScheduleData *scheduleData in schedulesData) {
+            [self applyEdits:edits[scheduleData.identifier] toScheduleData:scheduleData];
+        }
+    } newSchedules:schedules completionHandler:^(BOOL success) {
+        UA_STRONGIFY(self)
+
+        // The edits are saved even if the new schedules are over the limit, so only retry the new schedules
+        if (!success && schedules.count && self) {
+            [self retrySaveSchedules:schedules completionHandler:savedHandler];
+            return;
+        }
+
+        savedHandler(success);
     }];
 }
 
+- (void)getScheduleIDsByGroupWithPredicate:(NSPredicate *)predicate
+                         completionHandler:(void (^)(NSDictionary<NSString *, NSString *> *))completionHandler {
+    [self.automationStore getScheduleIDsByGroupWithPredicate:predicate completionHandler:^(NSDictionary<NSString *, NSString *> *scheduleIDs) {
+        [self.dispatcher dispatchAsync:^{
+            completionHandler(scheduleIDs);
+        }];
+    }];
+}
+
+/**
+ * Applies edits to the schedule data, and rehabilitates or finishes the schedule if needed.
+ * Must be called on the store's queue.
+ *
+ * @return The schedule if the edits changed its state, otherwise nil.
+ */
+- (nullable UASchedule *)applyEdits:(UAScheduleEdits *)edits toScheduleData:(UAScheduleData *)scheduleData {
+    UASchedule *schedule = nil;
+
+    [UAAutomationEngine applyEdits:edits toData:scheduleData];
+
+    BOOL overLimit = [scheduleData isOverLimit];
+    BOOL isExpired = [scheduleData isExpired];
+
+    // Check if the schedule needs to be rehabilitated or finished due to the edits
+    if ([scheduleData.executionState unsignedIntegerValue] == UAScheduleStateFinished && !overLimit && !isExpired) {
+        NSDate *finishDate = scheduleData.executionStateChangeDate;
+        scheduleData.executionState = @(UAScheduleStateIdle);
+
+        schedule = [self scheduleFromData:scheduleData];
+
+        // Handle any state changes that might have been missed while the schedule was finished
+        UA_WEAKIFY(self);
+        [self.dispatcher dispatchAsync:^{
+            UA_STRONGIFY(self);
+            [self checkCompoundTriggerState:@[schedule] forStateNewerThanDate:finishDate];
+        }];
+    } else if ([scheduleData.executionState unsignedIntegerValue] != UAScheduleStateFinished && (overLimit || isExpired)) {
+        schedule = [self scheduleFromData:scheduleData];
+
+        if (overLimit) {
+            [self notifyDelegateOnScheduleLimitReached:schedule];
+        }
+        if (isExpired) {
+            [self notifyDelegateOnScheduleExpired:schedule];
+        }
+        [self finishSchedule:scheduleData];
+    }
+
+    // Edits may move the end date or grace period
+    [self scheduleExpiryTimerForScheduleData:scheduleData];
+
+    return schedule;
+}
+
 #pragma mark -
 #pragma mark Private
 
-- (BOOL)isForegrounded {
-    return self.appStateTracker.state == UAApplicationStateActive;
+/**
+ * Saves the schedules. If the save fails, the expiry pass is run and the save is retried once.
+ *
+ * @param schedules The schedules.
+ * @param completionHandler Completion handler called on the store's queue with the result.
+ */
+- (void)saveSchedules:(NSArray<UASchedule *> *)schedules completionHandler:(void (^)(BOOL))completionHandler {
+    UA_WEAKIFY(self)
+    [self.automationStore saveSchedules:schedules completionHandler:^(BOOL success) {
+        UA_STRONGIFY(self)
+        if (success || !self) {
+            completionHandler(success);
+            return;
+        }
+
+        [self retrySaveSchedules:schedules completionHandler:completionHandler];
+    }];
+}
+
+/**
+ * Runs the expiry pass and saves the schedules again. Expired schedules count against the schedule limit
+ * until the expiry pass deletes them, and the expiry timer does not fire while the app is suspended.
+ *
+ * @param schedules The schedules.
+ * @param completionHandler Completion handler called on the store's queue with the result.
+ */
+- (void)retrySaveSchedules:(NSArray<UASchedule *> *)schedules completionHandler:(void (^)(BOOL))completionHandler {
+    UA_LDEBUG(@"Unable to save schedules, removing expired schedules and retrying.");
+
+    // Store blocks run in order, so the save runs after the expiry pass
+    [self cleanSchedules];
+    [self.automationStore saveSchedules:schedules completionHandler:completionHandler];
+}
+
+/**
+ * Publishes the current screen, region and app state for checking schedule conditions
+ * off the main queue. Must be called on the main queue whenever one of them changes.
+ */
+- (void)updateConditionsState {
+    self.conditionsState = [self currentConditionsState];
+}
+
+/**
+ * Reads the current screen, region and app state. Must be called on the main queue.
+ */
+- (UAAutomationConditionsState *)currentConditionsState {
+    BOOL foregrounded = self.appStateTracker.state == UAApplicationStateActive;
+    return [[UAAutomationConditionsState alloc] initWithScreen:self.currentScreen
+                                                      regionID:self.currentRegion
+                                                  foregrounded:foregrounded];
 }
 
+/**
+ * Finishes expired schedules and deletes finished schedules past their grace period, then schedules the
+ * expiry timer for the next deadline.
+ */
 - (void)cleanSchedules {
+    __block NSDate *nextExpiryDate = nil;
+
     UA_WEAKIFY(self)
     // Expired schedules
     [self.automationStore getActiveExpiredSchedules:^(NSArray<UAScheduleData *> *schedulesData) {
@@ -448,31 +687,130 @@
 
     // Finished schedules
     [self.automationStore getSchedulesWithStates:@[@(UAScheduleStateFinished)] completionHandler:^(NSArray<UAScheduleData *> *schedulesData) {
+        UA_STRONGIFY(self)
         for (UAScheduleData *scheduleData in schedulesData) {
-            NSDate *finishDate;
-
-            // If grace period is unset - use the executionStateChangeDate as finishDate to avoid unnecessarily keeping schedules around until distant future.
-            if (scheduleData.editGracePeriod == 0) {
-                finishDate = scheduleData.executionStateChangeDate;
-            } else {
-                // If the grace period is set - follow the end date behavior outlined in the specification.
-                finishDate = [scheduleData.end dateByAddingTimeInterval:[scheduleData.editGracePeriod doubleValue]];
-            }
+            NSDate *finishDate = [self expiryDateForScheduleData:scheduleData];
 
             if ([finishDate compare:self.date.now] == NSOrderedAscending) {
-                [scheduleData.managedObjectContext deleteObject:scheduleData];
+                [self deleteScheduleData:scheduleData];
+            } else if (!nextExpiryDate || [finishDate compare:nextExpiryDate] == NSOrderedAscending) {
+                nextExpiryDate = finishDate;
             }
         }
     }];
+
+    // Store callbacks run in order, so this runs after both of the above
+    [self.automationStore getNextActiveEndDate:^(NSDate *endDate) {
+        UA_STRONGIFY(self)
+        if (endDate && (!nextExpiryDate || [endDate compare:nextExpiryDate] == NSOrderedAscending)) {
+            nextExpiryDate = endDate;
+        }
+
+        [self scheduleExpiryTimerForDate:nextExpiryDate];
+    }];
+}
+
+/**
+ * Returns the date the schedule data expires. For finished schedules this is the date it is deleted.
+ *
+ * @param scheduleData The schedule data.
+ * @return The expiry date.
+ */
+- (nullable NSDate *)expiryDateForScheduleData:(UAScheduleData *)scheduleData {
+    if ([scheduleData.executionState unsignedIntegerValue] != UAScheduleStateFinished) {
+        return scheduleData.end;
+    }
+
+    // If grace period is unset - use the executionStateChangeDate as finishDate to avoid unnecessarily keeping schedules around until distant future.
+    if ([scheduleData.editGracePeriod doubleValue] <= 0) {
+        return scheduleData.executionStateChangeDate;
+    }
+
+    // If the grace period is set - follow the end date behavior outlined in the specification.
+    return [scheduleData.end dateByAddingTimeInterval:[scheduleData.editGracePeriod doubleValue]];
+}
+
+/**
+ * Schedules the expiry timer for the schedule data's expiry date. Must be called on the store's queue.
+ *
+ * @param scheduleData The schedule data.
+ */
+- (void)scheduleExpiryTimerForScheduleData:(UAScheduleData *)scheduleData {
+    if (scheduleData.isDeleted) {
+        return;
+    }
+
+    [self scheduleExpiryTimerForDate:[self expiryDateForScheduleData:scheduleData]];
+}
+
+/**
+ * Schedules the expiry timer for the earliest end date of the schedules.
+ *
+ * @param schedules The schedules.
+ */
+- (void)scheduleExpiryTimerForSchedules:(NSArray<UASchedule *> *)schedules {
+    NSDate *endDate = nil;
+    for (UASchedule *schedule in schedules) {
+        if (!endDate || [schedule.info.end compare:endDate] == NSOrderedAscending) {
+            endDate = schedule.info.end;
+        }
+    }
+
+    [self scheduleExpiryTimerForDate:endDate];
+}
+
+/**
+ * Schedules the expiry timer for the date, unless it is already scheduled for an earlier date.
+ *
+ * @param date The expiry date.
+ */
+- (void)scheduleExpiryTimerForDate:(nullable NSDate *)date {
+    // Schedules without an end date never expire
+    if (!date || [date compare:[NSDate distantFuture]] != NSOrderedAscending) {
+        return;
+    }
+
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        if (self.nextExpiryDate && [self.nextExpiryDate compare:date] != NSOrderedDescending) {
+            return;
+        }
+
+        UA_LTRACE(@"Scheduling automation expiry timer for %@", date);
+        self.nextExpiryDate = date;
+        [self.expiryTimerQueue addTimerWithIdentifier:UAAutomationEngineExpiryTimerID
+                                                group:nil
+                                         timeInterval:[date timeIntervalSinceDate:self.date.now]
+                                                block:^{
+            UA_STRONGIFY(self)
+            UA_LTRACE(@"Automation expiry timer fired");
+            self.nextExpiryDate = nil;
+            [self cleanSchedules];
+        }];
+    }];
+}
+
+/**
+ * Cancels the expiry timer.
+ */
+- (void)cancelExpiryTimer {
+    [self.dispatcher dispatchAsync:^{
+        [self.expiryTimerQueue cancelAll];
+        self.nextExpiryDate = nil;
+    }];
 }
 
 #pragma mark -
 #pragma mark Event listeners
 
 - (void)applicationDidTransitionToForeground {
-    if (!self.activeTimers) {
-        [self rescheduleTimers];
-    }
+    [self updateConditionsState];
+
+    // The expiry timer does not fire while the app is suspended
+    [self cleanSchedules];
+
+    // Timers are only rescheduled when the engine starts, foregrounding does not refetch them
 
     // Update any dependent foreground triggers
     [self updateTriggersWithType:UAScheduleTriggerAppForeground argument:nil incrementAmount:1.0];
@@ -486,6 +824,7 @@
 }
 
 - (void)applicationDidTransitionToBackground {
+    [self updateConditionsState];
     [self updateTriggersWithType:UAScheduleTriggerAppBackground argument:nil incrementAmount:1.0];
     [self scheduleConditionsChanged];
 }
@@ -517,6 +856,8 @@
         self.currentRegion = nil;
     }
 
+    [self updateConditionsState];
+
     [self updateTriggersWithType:triggerType argument:event.payload incrementAmount:1.0];
 
     [self scheduleConditionsChanged];
@@ -530,6 +871,7 @@
     }
 
     self.currentScreen = screenName;
+    [self updateConditionsState];
     [self scheduleConditionsChanged];
 }
 
@@ -570,7 +912,7 @@
 
         // Process triggers
         for (UAScheduleTriggerData *trigger in triggers) {
-            UAJSONPredicate *predicate = [UAAutomationEngine predicateFromData:trigger.predicateData];
+            UAJSONCompiledPredicate *predicate = [self compiledPredicateFromData:trigger.predicateData];
             if (predicate && argument) {
                 if (![predicate evaluateObject:argument]) {
                     continue;
@@ -622,26 +964,20 @@
  * Starts a timer for the schedule.
  *
  * @param scheduleData The schedule's data.
+ * @param timeInterval The time interval in seconds.
+ * @param selector The selector called with the schedule's identifier when the timer fires.
  */
-
 - (void)startTimerForSchedule:(UAScheduleData *)scheduleData
                  timeInterval:(NSTimeInterval)timeInterval
                      selector:(SEL)selector {
 
-    NSMutableDictionary *userInfo = [NSMutableDictionary dictionary];
-    [userInfo setValue:scheduleData.identifier forKey:@"identifier"];
-    [userInfo setValue:scheduleData.group forKey:@"group"];
+    NSString *identifier = scheduleData.identifier;
+    NSString *group = scheduleData.group;
 
     UA_WEAKIFY(self);
     [self.dispatcher dispatchAsync:^{
         UA_STRONGIFY(self);
 
-        NSTimer *timer = [NSTimer timerWithTimeInterval:timeInterval <= 0 ? .1 : timeInterval
-                                                 target:self
-                                               selector:selector
-                                               userInfo:userInfo
-                                                repeats:NO];
-
         // Make sure we have a background task identifier before starting the timer
         if (self.backgroundTaskIdentifier == UIBackgroundTaskInvalid) {
             self.backgroundTaskIdentifier = [self.application beginBackgroundTaskWithExpirationHandler:^{
@@ -656,113 +992,95 @@
             }
         }
 
-        UA_LTRACE(@"Starting automation timer for %f seconds with user info %@", timeInterval, timer.userInfo);
-        [self.timerScheduler scheduleTimer:timer];
-        [self.activeTimers addObject:timer];
+        UA_LTRACE(@"Starting automation timer for %f seconds for schedule %@", timeInterval, identifier);
+        [self.timerQueue addTimerWithIdentifier:identifier group:group timeInterval:timeInterval block:^{
+            UA_STRONGIFY(self);
+            if (!self) {
+                return;
+            }
+
+            void (*timerFired)(id, SEL, NSString *) = (void *)[self methodForSelector:selector];
+            timerFired(self, selector, identifier);
+        }];
     }];
 }
 
 /**
- * Finishes the timer.
- *
- * @param timer The timer to finish.
+ * Finishes a fired timer, ending the background task once no timers are pending.
  */
-- (void)finishTimer:(NSTimer *)timer {
+- (void)finishTimer {
     [self.dispatcher dispatchAsync:^{
-        [timer invalidate];
-        [self.activeTimers removeObject:timer];
-
-        if (!self.activeTimers.count) {
+        if (!self.timerQueue.count) {
             [self endBackgroundTask];
         }
     }];
 }
 
 /**
- * Delay timer fired for a schedule. Method is called on the main queue.
+ * Delay timer fired for a schedule.
  *
  * Called from the main queue.
  *
- * @param timer The timer.
+ * @param identifier The schedule identifier.
  */
-- (void)delayTimerFired:(NSTimer *)timer {
-    if (!timer.isValid) {
-        return;
-    }
-
-    UA_LTRACE(@"Automation delay timer fired: %@", timer.userInfo);
-
-    NSString *identifier = timer.userInfo[@"identifier"];
+- (void)delayTimerFired:(NSString *)identifier {
+    UA_LTRACE(@"Automation delay timer fired: %@", identifier);
 
     UA_WEAKIFY(self);
     [self.automationStore getSchedule:identifier completionHandler:^(UAScheduleData * _Nullable scheduleData) {
         UA_STRONGIFY(self);
 
         // Verify we are still delayed
-        if (!scheduleData || [scheduleData.executionState intValue] != UAScheduleStateTimeDelayed) {
-            return;
-        }
-
-        // Check expired
-        if ([scheduleData isExpired]) {
-            [self handleExpiredScheduleData:scheduleData];
-            return;
+        if (scheduleData && [scheduleData.executionState intValue] == UAScheduleStateTimeDelayed) {
+            if ([scheduleData isExpired]) {
+                [self handleExpiredScheduleData:scheduleData];
+            } else {
+                // Delay -> Prepare
+                scheduleData.executionState = @(UAScheduleStatePreparingSchedule);
+                [self prepareSchedules:@[scheduleData]];
+            }
         }
 
-        // Delay -> Prepare
-        scheduleData.executionState = @(UAScheduleStatePreparingSchedule);
-        [self prepareSchedules:@[scheduleData]];
-
-        // Finish the timer
-        [self finishTimer:timer];
+        [self finishTimer];
     }];
 }
 
 /**
- * Interval timer fired for a schedule. Method is called on the main queue.
+ * Interval timer fired for a schedule.
  *
- * @param timer The timer.
+ * Called from the main queue.
+ *
+ * @param identifier The schedule identifier.
  */
-- (void)intervalTimerFired:(NSTimer *)timer {
-    if (!timer.isValid) {
-        return;
-    }
-
-    UA_LTRACE(@"Automation interval timer fired: %@", timer.userInfo);
-
-    NSString *identifier = timer.userInfo[@"identifier"];
+- (void)intervalTimerFired:(NSString *)identifier {
+    UA_LTRACE(@"Automation interval timer fired: %@", identifier);
 
     UA_WEAKIFY(self);
     [self.automationStore getSchedule:identifier completionHandler:^(UAScheduleData * _Nullable scheduleData) {
         UA_STRONGIFY(self);
 
         // Verify we are still paused
-        if (!scheduleData || [scheduleData.executionState intValue] != UAScheduleStatePaused) {
-            return;
-        }
-
-        // Check expired
-        if ([scheduleData isExpired]) {
-            [self handleExpiredScheduleData:scheduleData];
-            return;
-        }
-
-        // Capture the pause date
-        NSDate *pauseDate = scheduleData.executionStateChangeDate;
+        if (scheduleData && [scheduleData.executionState intValue] == UAScheduleStatePaused) {
+            if ([scheduleData isExpired]) {
+                [self handleExpiredScheduleData:scheduleData];
+            } else {
+                // Capture the pause date
+                NSDate *pauseDate = scheduleData.executionStateChangeDate;
 
-        // Paused -> Idle
-        scheduleData.executionState = @(UAScheduleStateIdle);
+                // Paused -> Idle
+                scheduleData.executionState = @(UAScheduleStateIdle);
 
-        // Check compound trigger state
-        UASchedule *schedule = [self scheduleFromData:scheduleData];
-        if (schedule) {
-            [self.dispatcher dispatchAsync:^{
-                [self checkCompoundTriggerState:@[schedule] forStateNewerThanDate:pauseDate];
-            }];
+                // Check compound trigger state
+                UASchedule *schedule = [self scheduleFromData:scheduleData];
+                if (schedule) {
+                    [self.dispatcher dispatchAsync:^{
+                        [self checkCompoundTriggerState:@[schedule] forStateNewerThanDate:pauseDate];
+                    }];
+                }
+            }
         }
 
-        // Finish the timer
-        [self finishTimer:timer];
+        [self finishTimer];
     }];
 }
 
@@ -773,19 +1091,11 @@
  */
 - (void)cancelTimersWithIdentifiers:(NSSet<NSString *> *)identifiers {
     [self.dispatcher dispatchAsync:^{
-        for (NSTimer *timer in [self.activeTimers copy]) {
-            if (!timer.isValid || !timer.userInfo) {
-                [self.activeTimers removeObject:timer];
-                continue;
-            }
-
-            if ([identifiers containsObject:timer.userInfo[@"identifier"]]) {
-                [timer invalidate];
-                [self.activeTimers removeObject:timer];
-            }
+        for (NSString *identifier in identifiers) {
+            [self.timerQueue cancelTimerWithIdentifier:identifier];
         }
 
-        if (!self.activeTimers.count) {
+        if (!self.timerQueue.count) {
             [self endBackgroundTask];
         }
     }];
@@ -798,19 +1108,9 @@
  */
 - (void)cancelTimersWithGroup:(NSString *)group {
     [self.dispatcher dispatchAsync:^{
-        for (NSTimer *timer in [self.activeTimers copy]) {
-            if (!timer.isValid || !timer.userInfo) {
-                [self.activeTimers removeObject:timer];
-                continue;
-            }
-
-            if ([group isEqualToString:timer.userInfo[@"group"]]) {
-                [timer invalidate];
-                [self.activeTimers removeObject:timer];
-            }
-        }
+        [self.timerQueue cancelTimersWithGroup:group];
 
-        if (!self.activeTimers.count) {
+        if (!self.timerQueue.count) {
             [self endBackgroundTask];
         }
     }];
@@ -821,13 +1121,7 @@
  */
 - (void)cancelTimers {
     [self.dispatcher dispatchAsync:^{
-        for (NSTimer *timer in self.activeTimers) {
-            if (timer.isValid) {
-                [timer invalidate];
-            }
-        }
-
-        [self.activeTimers removeAllObjects];
+        [self.timerQueue cancelAll];
         [self endBackgroundTask];
     }];
 }
@@ -968,10 +1262,7 @@
     [self.automationStore getSchedulesWithStates:@[@(UAScheduleStateWaitingScheduleConditions)]
                                completionHandler:^(NSArray<UAScheduleData *> *schedulesData) {
                                    UA_STRONGIFY(self);
-                                   schedulesData = [self sortedScheduleDataByPriority:schedulesData];
-                                   for (UAScheduleData *scheduleData in schedulesData) {
-                                       [self attemptExecution:scheduleData];
-                                   }
+                                   [self attemptExecution:[self sortedScheduleDataByPriority:schedulesData]];
                                }];
 }
 
@@ -979,26 +1270,27 @@
  * Checks if a schedule that is pending execution is able to be executed.
  *
  * @param scheduleDelay The UAScheduleDelay to check.
+ * @param state The conditions state.
  * @return YES if conditions are satisfied, otherwise NO.
  */
-- (BOOL)isScheduleConditionsSatisfied:(UAScheduleDelay *)scheduleDelay {
+- (BOOL)isScheduleConditionsSatisfied:(UAScheduleDelay *)scheduleDelay state:(UAAutomationConditionsState *)state {
     if (!scheduleDelay) {
         return YES;
     }
 
-    if (scheduleDelay.screens && ![scheduleDelay.screens containsObject:self.currentScreen]) {
+    if (scheduleDelay.screens && ![scheduleDelay.screens containsObject:state.screen]) {
         return NO;
     }
 
-    if (scheduleDelay.regionID && ![scheduleDelay.regionID isEqualToString:self.currentRegion]) {
+    if (scheduleDelay.regionID && ![scheduleDelay.regionID isEqualToString:state.regionID]) {
         return NO;
     }
 
-    if (scheduleDelay.appState == UAScheduleDelayAppStateForeground && !self.isForegrounded) {
+    if (scheduleDelay.appState == UAScheduleDelayAppStateForeground && !state.foregrounded) {
         return NO;
     }
 
-    if (scheduleDelay.appState == UAScheduleDelayAppStateBackground && self.isForegrounded) {
+    if (scheduleDelay.appState == UAScheduleDelayAppStateBackground && state.foregrounded) {
         return NO;
     }
 
@@ -1093,11 +1385,11 @@
                 switch (prepareResult) {
                     case UAAutomationSchedulePrepareResultCancel:
                         [self notifyDelegateOnScheduleCancelled:[self scheduleFromData:scheduleData]];
-                        [scheduleData.managedObjectContext deleteObject:scheduleData];
+                        [self deleteScheduleData:scheduleData];
                         break;
                     case UAAutomationSchedulePrepareResultContinue:
                         scheduleData.executionState = @(UAScheduleStateWaitingScheduleConditions);
-                        [self attemptExecution:scheduleData];
+                        [self attemptExecution:@[scheduleData]];
                         break;
                     case UAAutomationSchedulePrepareResultSkip:
                         scheduleData.executionState = @(UAScheduleStateIdle);
@@ -1125,77 +1417,189 @@
     }];
 }
 
-- (void)attemptExecution:(UAScheduleData *)scheduleData {
-    NSNumber *currentExecutionState = scheduleData.executionState;
-
-    if ([currentExecutionState intValue] != UAScheduleStateWaitingScheduleConditions) {
-        UA_LERR(@"Unable to execute schedule. Schedule is in the wrong state: %@", currentExecutionState);
-        return;
-    }
-
-    // Verify the schedule is not expired
-    if ([scheduleData isExpired]) {
-        [self handleExpiredScheduleData:scheduleData];
+/**
+ * Attempts to execute schedules that are waiting on schedule conditions. Must be called on the store's queue.
+ *
+ * Schedule conditions are checked against the published conditions state without blocking on the main
+ * queue. Schedules with satisfied conditions are then checked with the delegate and executed on the main
+ * queue in a single dispatch.
+ *
+ * @param schedulesData The schedules' data, in priority order.
+ */
+- (void)attemptExecution:(NSArray<UAScheduleData *> *)schedulesData {
+    if (self.paused) {
         return;
     }
 
-    UASchedule *schedule = [self scheduleFromData:scheduleData];
+    UAAutomationConditionsState *state = self.conditionsState;
+    NSMutableArray<UASchedule *> *schedules = [NSMutableArray array];
 
-    if (!schedule) {
-        return;
+    NSUInteger generation;
+    @synchronized (self.executionAttemptIDs) {
+        generation = self.executionAttemptsGeneration;
     }
 
-    // Execution state must be read and written on the context's private queue
-    __block NSNumber *nextExecutionState = currentExecutionState;
+    for (UAScheduleData *scheduleData in schedulesData) {
+        NSNumber *currentExecutionState = scheduleData.executionState;
 
-    // Conditions and action executions must be run on the main queue.
-    UA_WEAKIFY(self)
-    [self.dispatcher doSync:^{
-        UA_STRONGIFY(self)
+        if ([currentExecutionState intValue] != UAScheduleStateWaitingScheduleConditions) {
+            UA_LERR(@"Unable to execute schedule. Schedule is in the wrong state: %@", currentExecutionState);
+            continue;
+        }
 
-        if (self.paused) {
-            return;
+        // Verify the schedule is not expired
+        if ([scheduleData isExpired]) {
+            [self handleExpiredScheduleData:scheduleData];
+            continue;
+        }
+
+        UASchedule *schedule = [self scheduleFromData:scheduleData];
+        if (!schedule) {
+            continue;
         }
 
-        if (![self isScheduleConditionsSatisfied:schedule.info.delay]) {
+        if (![self isScheduleConditionsSatisfied:schedule.info.delay state:state]) {
             UA_LDEBUG("Schedule:%@ is not ready to execute. Conditions not satisfied", schedule);
-            return;
+            continue;
         }
 
+        @synchronized (self.executionAttemptIDs) {
+            // Already waiting on the main queue
+            if ([self.executionAttemptIDs containsObject:schedule.identifier]) {
+                continue;
+            }
+
+            [self.executionAttemptIDs addObject:schedule.identifier];
+        }
+
+        [schedules addObject:schedule];
+    }
+
+    if (!schedules.count) {
+        return;
+    }
+
+    // Delegate checks and action executions must be run on the main queue.
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
         id<UAAutomationEngineDelegate> delegate = self.delegate;
 
-        switch ([delegate isScheduleReadyToExecute:schedule]) {
-            case UAAutomationScheduleReadyResultInvalidate: {
-                UA_LTRACE("Attempted to execute an invalid schedule:%@.", schedule);
-                nextExecutionState = @(UAScheduleStatePreparingSchedule);
-                [self prepareScheduleWithIdentifier:schedule.identifier];
-                break;
+        // The published state may be stale, so check the conditions again before executing
+        UAAutomationConditionsState *currentState = [self currentConditionsState];
+
+        for (UASchedule *schedule in schedules) {
+            // Schedules cancelled or edited since they were checked are checked again against the store
+            if (![self isExecutionAttemptCurrent:generation]) {
+                [self retryExecutionAttempt:schedule.identifier];
+                continue;
+            }
+
+            UAAutomationScheduleReadyResult result = UAAutomationScheduleReadyResultNotReady;
+            if (!self.paused && [self isScheduleConditionsSatisfied:schedule.info.delay state:currentState]) {
+                result = [delegate isScheduleReadyToExecute:schedule];
             }
-            case UAAutomationScheduleReadyResultContinue: {
-                UA_LTRACE("Execute schedule:%@.", schedule);
 
-                [delegate executeSchedule:schedule completionHandler:^{
-                    UA_STRONGIFY(self)
-                    [self.automationStore getSchedule:schedule.identifier completionHandler:^(UAScheduleData * _Nullable scheduleData) {
+            switch (result) {
+                case UAAutomationScheduleReadyResultInvalidate: {
+                    UA_LTRACE("Attempted to execute an invalid schedule:%@.", schedule);
+                    [self finishExecutionAttempt:schedule.identifier executionState:@(UAScheduleStatePreparingSchedule)];
+                    [self prepareScheduleWithIdentifier:schedule.identifier];
+                    break;
+                }
+                case UAAutomationScheduleReadyResultContinue: {
+                    UA_LTRACE("Execute schedule:%@.", schedule);
+
+                    // Queue the state update before executing so it is applied before the execution finishes
+                    [self finishExecutionAttempt:schedule.identifier executionState:@(UAScheduleStateExecuting)];
+
+                    [delegate executeSchedule:schedule completionHandler:^{
                         UA_STRONGIFY(self)
-                        [self scheduleFinishedExecuting:scheduleData];
+                        [self.automationStore getSchedule:schedule.identifier includingExpired:YES completionHandler:^(UAScheduleData * _Nullable scheduleData) {
+                            UA_STRONGIFY(self)
+                            [self scheduleFinishedExecuting:scheduleData];
+                        }];
                     }];
-                }];
-
-                nextExecutionState = @(UAScheduleStateExecuting); // executing
-                break;
-            }
-            case UAAutomationScheduleReadyResultNotReady: {
-                UA_LTRACE("Attempted to execute schedule:%@ that is not ready.", schedule);
-                break;
+                    break;
+                }
+                case UAAutomationScheduleReadyResultNotReady: {
+                    UA_LTRACE("Attempted to execute schedule:%@ that is not ready.", schedule);
+                    [self finishExecutionAttempt:schedule.identifier executionState:nil];
+                    break;
+                }
             }
         }
     }];
+}
+
+/**
+ * Invalidates the execution attempts waiting on the main queue. Called before a schedule is cancelled
+ * or edited, so an attempt checked against the old schedule data is not executed.
+ */
+- (void)invalidateExecutionAttempts {
+    @synchronized (self.executionAttemptIDs) {
+        self.executionAttemptsGeneration++;
+    }
+}
+
+/**
+ * Checks if no schedules were cancelled or edited since an execution attempt started.
+ *
+ * @param generation The execution attempts generation when the attempt started.
+ * @return YES if the attempt is still current, otherwise NO.
+ */
+- (BOOL)isExecutionAttemptCurrent:(NSUInteger)generation {
+    @synchronized (self.executionAttemptIDs) {
+        return generation == self.executionAttemptsGeneration;
+    }
+}
+
+/**
+ * Ends an invalidated execution attempt and attempts the schedule again if it still exists and
+ * is still waiting on schedule conditions. The store's queue runs the pending cancels and edits first.
+ *
+ * @param identifier The schedule identifier.
+ */
+- (void)retryExecutionAttempt:(NSString *)identifier {
+    UA_WEAKIFY(self)
+    [self.automationStore getSchedule:identifier includingExpired:YES completionHandler:^(UAScheduleData * _Nullable scheduleData) {
+        UA_STRONGIFY(self)
+        @synchronized (self.executionAttemptIDs) {
+            [self.executionAttemptIDs removeObject:identifier];
+        }
+
+        if ([scheduleData.executionState intValue] == UAScheduleStateWaitingScheduleConditions) {
+            [self attemptExecution:@[scheduleData]];
+        }
+    }];
+}
 
-    // Update execution state if necessary
-    if (![currentExecutionState isEqual:nextExecutionState]) {
-        scheduleData.executionState = nextExecutionState;
+/**
+ * Finishes an execution attempt, updating the schedule's execution state if it is still waiting
+ * on schedule conditions. The state is applied even if the schedule expired during the attempt.
+ *
+ * @param identifier The schedule identifier.
+ * @param executionState The new execution state, or nil to leave the schedule waiting.
+ */
+- (void)finishExecutionAttempt:(NSString *)identifier executionState:(nullable NSNumber *)executionState {
+    if (!executionState) {
+        @synchronized (self.executionAttemptIDs) {
+            [self.executionAttemptIDs removeObject:identifier];
+        }
+        return;
     }
+
+    UA_WEAKIFY(self)
+    [self.automationStore getSchedule:identifier includingExpired:YES completionHandler:^(UAScheduleData * _Nullable scheduleData) {
+        UA_STRONGIFY(self)
+        if ([scheduleData.executionState intValue] == UAScheduleStateWaitingScheduleConditions) {
+            scheduleData.executionState = executionState;
+        }
+
+        @synchronized (self.executionAttemptIDs) {
+            [self.executionAttemptIDs removeObject:identifier];
+        }
+    }];
 }
 
 - (void)handleExpiredScheduleData:(nonnull UAScheduleData *)scheduleData {
@@ -1210,8 +1614,23 @@
 
     if ([scheduleData.editGracePeriod doubleValue] <= 0) {
         UA_LDEBUG(@"Deleting schedule: %@", scheduleData.identifier);
-        [scheduleData.managedObjectContext deleteObject:scheduleData];
+        [self deleteScheduleData:scheduleData];
+    } else {
+        [self scheduleExpiryTimerForScheduleData:scheduleData];
+    }
+}
+
+/**
+ * Deletes the schedule data and its decoded schedule. Must be called on the store's queue.
+ *
+ * @param scheduleData The schedule data.
+ */
+- (void)deleteScheduleData:(UAScheduleData *)scheduleData {
+    if (scheduleData.identifier) {
+        [self.scheduleCache removeObjectForKey:scheduleData.identifier];
     }
+
+    [scheduleData.managedObjectContext deleteObject:scheduleData];
 }
 
 - (void)scheduleFinishedExecuting:(UAScheduleData *)scheduleData {
@@ -1305,10 +1724,36 @@
 #pragma mark -
 #pragma mark Converters
 
+/**
+ * Gets the schedule for the schedule data. Schedules are decoded once per modification
+ * stamp, so repeated state transitions reuse the same immutable schedule.
+ *
+ * @param scheduleData The schedule data.
+ * @return The schedule, or nil if the data is invalid.
+ */
 - (UASchedule *)scheduleFromData:(UAScheduleData *)scheduleData {
+    NSString *identifier = scheduleData.identifier;
+    NSNumber *modificationStamp = scheduleData.modificationStamp ?: @(0);
+
+    UAAutomationCachedSchedule *cached = identifier ? [self.scheduleCache objectForKey:identifier] : nil;
+    if ([cached.modificationStamp isEqualToNumber:modificationStamp]) {
+        return cached.schedule;
+    }
+
+    UASchedule *schedule = [self decodeScheduleFromData:scheduleData];
+
+    if (schedule && identifier) {
+        cached = [[UAAutomationCachedSchedule alloc] initWithSchedule:schedule modificationStamp:modificationStamp];
+        [self.scheduleCache setObject:cached forKey:identifier];
+    }
+
+    return schedule;
+}
+
+- (UASchedule *)decodeScheduleFromData:(UAScheduleData *)scheduleData {
     UAScheduleInfoBuilder *builder = [[UAScheduleInfoBuilder alloc] init];
-    builder.triggers = [UAAutomationEngine triggersFromData:scheduleData.triggers];
-    builder.delay = [UAAutomationEngine delayFromData:scheduleData.delay];
+    builder.triggers = [self triggersFromData:scheduleData.triggers];
+    builder.delay = [self delayFromData:scheduleData.delay];
     builder.group = scheduleData.group;
     builder.data = scheduleData.data;
     builder.start = scheduleData.start;
@@ -1332,19 +1777,19 @@
 
     if (!schedule) {
         UA_LERR(@"Failed to parse schedule data. Deleting %@", scheduleData.identifier);
-        [scheduleData.managedObjectContext deleteObject:scheduleData];
+        [self deleteScheduleData:scheduleData];
     }
 
     return schedule;
 }
 
-+ (NSArray<UAScheduleTrigger *> *)triggersFromData:(NSSet<UAScheduleTriggerData *> *)data {
+- (NSArray<UAScheduleTrigger *> *)triggersFromData:(NSSet<UAScheduleTriggerData *> *)data {
     NSMutableArray *triggers = [NSMutableArray array];
 
     for (UAScheduleTriggerData *triggerData in data) {
         UAScheduleTrigger *trigger = [UAScheduleTrigger triggerWithType:(UAScheduleTriggerType)[triggerData.type integerValue]
                                                                    goal:triggerData.goal
-                                                              predicate:[UAAutomationEngine predicateFromData:triggerData.predicateData]];
+                                                              predicate:[self predicateFromData:triggerData.predicateData]];
 
         [triggers addObject:trigger];
     }
@@ -1353,7 +1798,7 @@
 }
 
 
-+ (UAScheduleDelay *)delayFromData:(UAScheduleDelayData *)data {
+- (UAScheduleDelay *)delayFromData:(UAScheduleDelayData *)data {
     if (!data) {
         return nil;
     }
@@ -1365,18 +1810,42 @@
             builder.screens = [NSJSONSerialization JSONObjectWithData:screenData options:NSJSONReadingMutableContainers error:nil];
         }
         builder.regionID = data.regionID;
-        builder.cancellationTriggers = [UAAutomationEngine triggersFromData:data.cancellationTriggers];
+        builder.cancellationTriggers = [self triggersFromData:data.cancellationTriggers];
         builder.appState = [data.appState integerValue];
     }];
 }
 
-+ (UAJSONPredicate *)predicateFromData:(NSData *)data {
+/**
+ * Gets the compiled predicate for the trigger's predicate data.
+ *
+ * Predicates are cached by their serialized data, so an edited or replaced predicate
+ * is compiled again while repeated events only evaluate an already built predicate.
+ *
+ * @param data The predicate data.
+ * @return The compiled predicate, or nil if the data is nil or invalid.
+ */
+- (UAJSONCompiledPredicate *)compiledPredicateFromData:(NSData *)data {
     if (!data) {
         return nil;
     }
 
+    id cached = [self.predicateCache objectForKey:data];
+    if (cached) {
+        return cached == [NSNull null] ? nil : cached;
+    }
+
     id json = [NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingMutableContainers error:nil];
-    return [UAJSONPredicate predicateWithJSON:json error:nil];
+    UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSON:json error:nil];
+    UAJSONCompiledPredicate *compiledPredicate = predicate ? [UAJSONCompiledPredicate compiledPredicateWithPredicate:predicate] : nil;
+
+    // Cache invalid predicates as well so they are not parsed again on every event
+    [self.predicateCache setObject:compiledPredicate ?: [NSNull null] forKey:data];
+
+    return compiledPredicate;
+}
+
+- (UAJSONPredicate *)predicateFromData:(NSData *)data {
+    return [self compiledPredicateFromData:data].predicate;
 }
 
 + (void)applyEdits:(UAScheduleEdits *)edits toData:(UAScheduleData *)scheduleData {
@@ -1411,6 +1880,8 @@
     if (edits.metadata) {
         scheduleData.metadata = edits.metadata;
     }
+
+    [scheduleData incrementModificationStamp];
 }
 
 @end
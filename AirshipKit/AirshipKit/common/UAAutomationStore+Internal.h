@@ -62,6 +62,23 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)saveSchedules:(NSArray<UASchedule *> *)schedules completionHandler:(void (^)(BOOL))completionHandler;
 
+/**
+ * Edits existing schedules and saves new schedules in a single transaction. The edit block is
+ * called with the data of every schedule that was found, and the edits and new schedules
+ * are persisted with one save afterwards.
+ *
+ * @param scheduleIDs The identifiers of the schedules to edit, including ended schedules.
+ * @param editBlock Block called with the schedule data to edit.
+ * @param schedules The new schedules to save.
+ * @param completionHandler Completion handler when the operation is finished. `YES` if the
+ * changes were saved, `NO` if the changes failed to save or the new schedules would exceed
+ * the specified limit. The edits are still saved when the new schedules exceed the limit.
+ */
+- (void)editSchedulesWithIDs:(NSArray<NSString *> *)scheduleIDs
+                   editBlock:(void (^)(NSArray<UAScheduleData *> *))editBlock
+                newSchedules:(NSArray<UASchedule *> *)schedules
+           completionHandler:(void (^)(BOOL))completionHandler;
+
 /**
  * Deletes the schedule corresponding to the provided identifier.
  *
@@ -69,6 +86,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)deleteSchedule:(NSString *)scheduleID;
 
+/**
+ * Deletes the schedule corresponding to the provided identifier.
+ *
+ * @param scheduleID A schedule identifier.
+ * @param completionHandler Called on the store's queue, in the same block as the delete, once the delete is attempted.
+ */
+- (void)deleteSchedule:(NSString *)scheduleID completionHandler:(nullable void (^)(void))completionHandler;
+
 /**
  * Deletes all schedules corresponding to the provided identifier.
  *
@@ -76,11 +101,26 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)deleteSchedules:(NSString *)groupID;
 
+/**
+ * Deletes all schedules corresponding to the provided identifier.
+ *
+ * @param groupID A group identifier.
+ * @param completionHandler Called on the store's queue, in the same block as the delete, once the delete is attempted.
+ */
+- (void)deleteSchedules:(NSString *)groupID completionHandler:(nullable void (^)(void))completionHandler;
+
 /**
  * Deletes all schedules.
  */
 - (void)deleteAllSchedules;
 
+/**
+ * Deletes all schedules.
+ *
+ * @param completionHandler Called on the store's queue, in the same block as the delete, once the delete is attempted.
+ */
+- (void)deleteAllSchedules:(nullable void (^)(void))completionHandler;
+
 /**
  * Gets all schedules corresponding to the provided identifier.
  *
@@ -120,6 +160,16 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)getSchedule:(NSString *)scheduleID completionHandler:(void (^)(UAScheduleData * _Nullable))completionHandler;
 
+/**
+ * Gets schedule identifiers keyed by group, without loading the schedules. Schedules without
+ * a group are skipped, and if a group has several schedules only one of them is returned.
+ *
+ * @param predicate An optional predicate to filter the schedules.
+ * @param completionHandler Completion handler called back with the schedule identifiers keyed by group.
+ */
+- (void)getScheduleIDsByGroupWithPredicate:(nullable NSPredicate *)predicate
+                         completionHandler:(void (^)(NSDictionary<NSString *, NSString *> *))completionHandler;
+
 /**
  * Gets the schedules with the corresponding state.
  *
@@ -135,9 +185,19 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)getActiveExpiredSchedules:(void (^)(NSArray<UAScheduleData *> *))completionHandler;
 
+/**
+ * Gets the earliest future end date of any schedule that has not finished.
+ *
+ * @param completionHandler Completion handler called back with the end date, or nil if there are no such schedules.
+ */
+- (void)getNextActiveEndDate:(void (^)(NSDate * _Nullable))completionHandler;
+
 /**
  * Gets all active triggers corresponding to the provided schedule identifier and trigger type.
  *
+ * Triggers are served from an in-memory index keyed by trigger type that is loaded once when the store
+ * is opened. Changes made to the returned triggers are persisted in coalesced batches.
+ *
  * @param scheduleID A schedule identifier. If this parameter is nil, all schedules will be queried.
  * @param type A trigger type
  * @param completionHandler Completion handler called back with the retrieved trigger data.
@@ -146,6 +206,12 @@ NS_ASSUME_NONNULL_BEGIN
                      type:(UAScheduleTriggerType)type
         completionHandler:(void (^)(NSArray<UAScheduleTriggerData *> *triggers))completionHandler;
 
+/**
+ * Saves any trigger progress that is waiting on a coalesced save. Called automatically when the
+ * application enters the background or terminates.
+ */
+- (void)savePendingTriggerProgress;
+
 /**
  * Gets the schedule count.
  *
@@ -16,6 +16,12 @@
 #import "UAUtils+Internal.h"
 #import "UAJSONSerialization+Internal.h"
 #import "UAScheduleDataMigrator+Internal.h"
+#import "UADispatcher+Internal.h"
+
+/**
+ * Delay used to coalesce trigger progress saves.
+ */
+static NSTimeInterval const UAAutomationStoreTriggerSaveDelay = 1.0;
 
 @interface UAAutomationStore ()
 @property (nonatomic, strong) NSManagedObjectContext *managedContext;
@@ -24,6 +30,10 @@
 @property (nonatomic, assign) NSUInteger scheduleLimit;
 @property (nonatomic, assign) BOOL inMemory;
 @property (nonatomic, assign) BOOL finished;
+
+// Trigger index and save state must only be accessed on the context's private queue
+@property (nonatomic, strong, nullable) NSMutableDictionary<NSNumber *, NSMutableArray<UAScheduleTriggerData *> *> *triggerIndex;
+@property (nonatomic, assign) BOOL triggerSavePending;
 @end
 
 @implementation UAAutomationStore
@@ -63,6 +73,17 @@
                                                  selector:@selector(protectedDataAvailable)
                                                      name:UIApplicationProtectedDataDidBecomeAvailable
                                                    object:nil];
+
+        // Pending trigger progress would be lost if the app is suspended or killed before the coalesced save
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(savePendingTriggerProgress)
+                                                     name:UIApplicationDidEnterBackgroundNotification
+                                                   object:nil];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationWillTerminate)
+                                                     name:UIApplicationWillTerminateNotification
+                                                   object:nil];
     }
 
     return self;
@@ -91,6 +112,11 @@
     }
 }
 
+- (void)applicationWillTerminate {
+    [self savePendingTriggerProgress];
+    [self waitForIdle];
+}
+
 - (void)migrateData {
     [self safePerformBlock:^(BOOL isSafe) {
         if (!isSafe) {
@@ -114,6 +140,9 @@
         }
 
         [self.managedContext safeSave];
+
+        // Migrations may rewrite triggers, so (re)load the index afterwards
+        [self loadTriggerIndex];
     }];
 }
 
@@ -143,9 +172,13 @@
             return;
         }
 
-        [self addScheduleDataFromSchedule:schedule];
+        UAScheduleData *scheduleData = [self addScheduleDataFromSchedule:schedule];
+        BOOL success = [self.managedContext safeSave];
+        if (success) {
+            [self indexTriggersForScheduleData:scheduleData];
+        }
 
-        completionHandler([self.managedContext safeSave]);
+        completionHandler(success);
     }];
 }
 
@@ -165,26 +198,99 @@
         }
         
         // create managed object for each schedule
+        NSMutableArray<UAScheduleData *> *schedulesData = [NSMutableArray arrayWithCapacity:schedules.count];
         for (UASchedule *schedule in schedules) {
-            [self addScheduleDataFromSchedule:schedule];
+            [schedulesData addObject:[self addScheduleDataFromSchedule:schedule]];
         }
-        
-        completionHandler([self.managedContext safeSave]);
+
+        BOOL success = [self.managedContext safeSave];
+        if (success) {
+            for (UAScheduleData *scheduleData in schedulesData) {
+                [self indexTriggersForScheduleData:scheduleData];
+            }
+        }
+
+        completionHandler(success);
+    }];
+}
+
+- (void)editSchedulesWithIDs:(NSArray<NSString *> *)scheduleIDs
+                   editBlock:(void (^)(NSArray<UAScheduleData *> *))editBlock
+                newSchedules:(NSArray<UASchedule *> *)schedules
+           completionHandler:(void (^)(BOOL))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(NO);
+            return;
+        }
+
+        BOOL withinLimit = YES;
+        if (schedules.count) {
+            NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+            NSUInteger count = [self.managedContext countForFetchRequest:request error:nil];
+            if (count + schedules.count > self.scheduleLimit) {
+                UA_LERR(@"Max schedule limit reached. Unable to save new schedules.");
+                withinLimit = NO;
+            }
+        }
+
+        if (scheduleIDs.count) {
+            NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+            request.predicate = [NSPredicate predicateWithFormat:@"identifier IN %@", scheduleIDs];
+
+            NSError *error;
+            NSArray<UAScheduleData *> *result = [self.managedContext executeFetchRequest:request error:&error];
+
+            if (error) {
+                UA_LERR(@"Error fetching schedules %@", error);
+            } else {
+                editBlock(result);
+            }
+        }
+
+        // create managed object for each schedule
+        NSMutableArray<UAScheduleData *> *schedulesData = [NSMutableArray arrayWithCapacity:schedules.count];
+        if (withinLimit) {
+            for (UASchedule *schedule in schedules) {
+                [schedulesData addObject:[self addScheduleDataFromSchedule:schedule]];
+            }
+        }
+
+        BOOL success = [self.managedContext safeSave];
+        if (success) {
+            for (UAScheduleData *scheduleData in schedulesData) {
+                [self indexTriggersForScheduleData:scheduleData];
+            }
+        }
+
+        completionHandler(success && withinLimit);
     }];
 }
 
 - (void)deleteSchedule:(NSString *)scheduleID {
+    [self deleteSchedule:scheduleID completionHandler:nil];
+}
+
+- (void)deleteSchedule:(NSString *)scheduleID completionHandler:(void (^)(void))completionHandler {
     NSPredicate *predicate = [NSPredicate predicateWithFormat:@"identifier == %@", scheduleID];
-    [self deleteSchedulesWithPredicate:predicate];
+    [self deleteSchedulesWithPredicate:predicate completionHandler:completionHandler];
 }
 
 - (void)deleteSchedules:(NSString *)groupID {
+    [self deleteSchedules:groupID completionHandler:nil];
+}
+
+- (void)deleteSchedules:(NSString *)groupID completionHandler:(void (^)(void))completionHandler {
     NSPredicate *predicate = [NSPredicate predicateWithFormat:@"group == %@", groupID];
-    [self deleteSchedulesWithPredicate:predicate];
+    [self deleteSchedulesWithPredicate:predicate completionHandler:completionHandler];
 }
 
 - (void)deleteAllSchedules {
-    [self deleteSchedulesWithPredicate:nil];
+    [self deleteAllSchedules:nil];
+}
+
+- (void)deleteAllSchedules:(void (^)(void))completionHandler {
+    [self deleteSchedulesWithPredicate:nil completionHandler:completionHandler];
 }
 
 - (void)getSchedules:(NSString *)groupID completionHandler:(void (^)(NSArray<UAScheduleData *> *))completionHandler {
@@ -216,11 +322,75 @@
     [self getSchedule:scheduleID includingExpired:NO completionHandler:completionHandler];
 }
 
+- (void)getScheduleIDsByGroupWithPredicate:(NSPredicate *)predicate
+                         completionHandler:(void (^)(NSDictionary<NSString *, NSString *> *))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(@{});
+            return;
+        }
+
+        NSPredicate *groupPredicate = [NSPredicate predicateWithFormat:@"group != nil"];
+
+        // Only the identifier and group are read, no schedule objects are created
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+        request.predicate = predicate ? [NSCompoundPredicate andPredicateWithSubpredicates:@[groupPredicate, predicate]] : groupPredicate;
+        request.resultType = NSDictionaryResultType;
+        request.propertiesToFetch = @[@"identifier", @"group"];
+        request.fetchLimit = self.scheduleLimit;
+
+        NSError *error;
+        NSArray<NSDictionary *> *result = [self.managedContext executeFetchRequest:request error:&error];
+
+        if (error) {
+            UA_LERR(@"Error fetching schedule IDs %@", error);
+            completionHandler(@{});
+            return;
+        }
+
+        NSMutableDictionary<NSString *, NSString *> *scheduleIDs = [NSMutableDictionary dictionaryWithCapacity:result.count];
+        for (NSDictionary *entry in result) {
+            NSString *identifier = entry[@"identifier"];
+            if (identifier) {
+                scheduleIDs[entry[@"group"]] = identifier;
+            }
+        }
+
+        completionHandler(scheduleIDs);
+    }];
+}
+
 - (void)getActiveExpiredSchedules:(void (^)(NSArray<UAScheduleData *> *))completionHandler {
     NSPredicate *predicate = [NSPredicate predicateWithFormat:@"end <= %@ && executionState != %d", self.date.now, UAScheduleStateFinished];
     [self fetchSchedulesWithPredicate:predicate limit:self.scheduleLimit completionHandler:completionHandler];
 }
 
+- (void)getNextActiveEndDate:(void (^)(NSDate * _Nullable))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(nil);
+            return;
+        }
+
+        // Only the end date of the first schedule is read, sorted by the indexed end attribute
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+        request.predicate = [NSPredicate predicateWithFormat:@"end > %@ && executionState != %d", self.date.now, UAScheduleStateFinished];
+        request.sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"end" ascending:YES]];
+        request.resultType = NSDictionaryResultType;
+        request.propertiesToFetch = @[@"end"];
+        request.fetchLimit = 1;
+
+        NSError *error;
+        NSArray<NSDictionary *> *result = [self.managedContext executeFetchRequest:request error:&error];
+
+        if (error) {
+            UA_LERR(@"Error fetching schedule end date %@", error);
+        }
+
+        completionHandler(result.firstObject[@"end"]);
+    }];
+}
+
 - (void)getAllSchedules:(void (^)(NSArray<UAScheduleData *> *))completionHandler {
     [self fetchSchedulesWithPredicate:nil limit:self.scheduleLimit completionHandler:completionHandler];
 }
@@ -229,14 +399,41 @@
                      type:(UAScheduleTriggerType)type
         completionHandler:(void (^)(NSArray<UAScheduleTriggerData *> *triggers))completionHandler {
 
-    scheduleID = scheduleID ? : @"*";
+    NSDate *now = self.date.now;
 
-    NSString *format = @"(schedule.identifier LIKE %@ AND type = %ld AND start <= %@) AND ((delay != nil AND schedule.executionState in %@) OR (delay == nil AND schedule.executionState == %d))";
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(@[]);
+            return;
+        }
 
-    NSArray *cancelTriggerState = @[@(UAScheduleStateTimeDelayed), @(UAScheduleStateWaitingScheduleConditions), @(UAScheduleStatePreparingSchedule)];
-    NSPredicate *predicate = [NSPredicate predicateWithFormat:format, scheduleID, type, self.date.now, cancelTriggerState, UAScheduleStateIdle];
+        if (!self.triggerIndex) {
+            [self loadTriggerIndex];
+        }
 
-    [self fetchTriggersWithPredicate:predicate completionHandler:completionHandler];
+        NSMutableArray<UAScheduleTriggerData *> *indexedTriggers = self.triggerIndex[@(type)];
+        NSMutableArray<UAScheduleTriggerData *> *activeTriggers = [NSMutableArray array];
+        NSMutableIndexSet *removedIndexes = [NSMutableIndexSet indexSet];
+
+        [indexedTriggers enumerateObjectsUsingBlock:^(UAScheduleTriggerData *trigger, NSUInteger idx, BOOL *stop) {
+            // Triggers deleted through the context (cascade from a schedule delete) are dropped lazily
+            if (trigger.isDeleted || !trigger.managedObjectContext) {
+                [removedIndexes addIndex:idx];
+                return;
+            }
+
+            if ([self isTriggerActive:trigger scheduleID:scheduleID date:now]) {
+                [activeTriggers addObject:trigger];
+            }
+        }];
+
+        [indexedTriggers removeObjectsAtIndexes:removedIndexes];
+
+        completionHandler(activeTriggers);
+
+        // Goal progress updates are persisted in batches instead of once per event
+        [self scheduleTriggerSave];
+    }];
 }
 
 - (void)getScheduleCount:(void (^)(NSNumber *))completionHandler {
@@ -251,12 +448,23 @@
     }];
 }
 
-- (void)deleteSchedulesWithPredicate:(NSPredicate *)predicate {
+- (void)deleteSchedulesWithPredicate:(NSPredicate *)predicate completionHandler:(void (^)(void))completionHandler {
     [self safePerformBlock:^(BOOL isSafe) {
         if (!isSafe) {
+            if (completionHandler) {
+                completionHandler();
+            }
             return;
         }
 
+        // Flush pending trigger progress so the save does not touch rows removed by the batch delete
+        if (self.triggerSavePending) {
+            self.triggerSavePending = NO;
+            [self.managedContext safeSave];
+        }
+
+        [self removeIndexedTriggersForSchedulesMatchingPredicate:predicate];
+
         NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
         request.predicate = predicate;
 
@@ -275,10 +483,13 @@
 
         if (error) {
             UA_LERR(@"Error deleting entities %@", error);
-            return;
+        } else {
+            [self.managedContext safeSave];
         }
 
-        [self.managedContext safeSave];
+        if (completionHandler) {
+            completionHandler();
+        }
     }];
 }
 
@@ -306,32 +517,152 @@
     }];
 }
 
-- (void)fetchTriggersWithPredicate:(NSPredicate *)predicate completionHandler:(void (^)(NSArray<UAScheduleTriggerData *> *))completionHandler {
+#pragma mark -
+#pragma mark Trigger Index
+
+/**
+ * Loads all triggers into an in-memory index keyed by trigger type. Must be called on the context's queue.
+ */
+- (void)loadTriggerIndex {
+    NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleTriggerData"];
+    request.returnsObjectsAsFaults = NO;
+    request.relationshipKeyPathsForPrefetching = @[@"schedule", @"delay"];
+
+    NSError *error;
+    NSArray<UAScheduleTriggerData *> *result = [self.managedContext executeFetchRequest:request error:&error];
+
+    if (error) {
+        UA_LERR(@"Error fetching triggers %@", error);
+        self.triggerIndex = nil;
+        return;
+    }
+
+    self.triggerIndex = [NSMutableDictionary dictionary];
+    for (UAScheduleTriggerData *trigger in result) {
+        [self indexTrigger:trigger];
+    }
+
+    UA_LTRACE(@"Loaded %lu automation triggers", (unsigned long)result.count);
+}
+
+/**
+ * Adds a trigger to the index. Must be called on the context's queue.
+ */
+- (void)indexTrigger:(UAScheduleTriggerData *)trigger {
+    NSMutableArray *triggers = self.triggerIndex[trigger.type];
+    if (!triggers) {
+        triggers = [NSMutableArray array];
+        self.triggerIndex[trigger.type] = triggers;
+    }
+
+    [triggers addObject:trigger];
+}
+
+/**
+ * Adds the schedule's triggers and cancellation triggers to the index if the index is loaded. Must be called
+ * on the context's queue.
+ */
+- (void)indexTriggersForScheduleData:(UAScheduleData *)scheduleData {
+    if (!self.triggerIndex) {
+        return;
+    }
+
+    // Cancellation triggers are also related to the schedule, so a set avoids indexing them twice
+    NSMutableSet<UAScheduleTriggerData *> *triggers = [NSMutableSet setWithSet:scheduleData.triggers];
+    [triggers unionSet:scheduleData.delay.cancellationTriggers];
+
+    for (UAScheduleTriggerData *trigger in triggers) {
+        [self indexTrigger:trigger];
+    }
+}
+
+/**
+ * Removes any indexed triggers whose schedule matches the predicate. Must be called on the context's queue.
+ *
+ * @param predicate A schedule predicate, or nil to remove all triggers.
+ */
+- (void)removeIndexedTriggersForSchedulesMatchingPredicate:(nullable NSPredicate *)predicate {
+    if (!self.triggerIndex) {
+        return;
+    }
+
+    if (!predicate) {
+        [self.triggerIndex removeAllObjects];
+        return;
+    }
+
+    for (NSMutableArray<UAScheduleTriggerData *> *triggers in self.triggerIndex.allValues) {
+        NSIndexSet *matches = [triggers indexesOfObjectsPassingTest:^BOOL(UAScheduleTriggerData *trigger, NSUInteger idx, BOOL *stop) {
+            UAScheduleData *scheduleData = trigger.schedule ?: trigger.delay.schedule;
+            return !scheduleData || [predicate evaluateWithObject:scheduleData];
+        }];
+
+        [triggers removeObjectsAtIndexes:matches];
+    }
+}
+
+/**
+ * Checks if an indexed trigger is active. Mirrors the store's active trigger criteria: the trigger has started and
+ * either it is a cancellation trigger on a pending schedule or an execution trigger on an idle schedule.
+ */
+- (BOOL)isTriggerActive:(UAScheduleTriggerData *)trigger scheduleID:(nullable NSString *)scheduleID date:(NSDate *)date {
+    UAScheduleData *scheduleData = trigger.schedule;
+    if (!scheduleData) {
+        return NO;
+    }
+
+    if (scheduleID && ![scheduleID isEqualToString:scheduleData.identifier]) {
+        return NO;
+    }
+
+    if (!trigger.start || [trigger.start compare:date] == NSOrderedDescending) {
+        return NO;
+    }
+
+    UAScheduleState state = [scheduleData.executionState unsignedIntegerValue];
+
+    if (trigger.delay) {
+        return state == UAScheduleStateTimeDelayed ||
+               state == UAScheduleStateWaitingScheduleConditions ||
+               state == UAScheduleStatePreparingSchedule;
+    }
+
+    return state == UAScheduleStateIdle;
+}
+
+/**
+ * Schedules a save to persist trigger progress. Multiple calls within the save delay are coalesced. Must be
+ * called on the context's queue.
+ */
+- (void)scheduleTriggerSave {
+    if (self.triggerSavePending) {
+        return;
+    }
+
+    self.triggerSavePending = YES;
+
+    UA_WEAKIFY(self)
+    [[UADispatcher backgroundDispatcher] dispatchAfter:UAAutomationStoreTriggerSaveDelay block:^{
+        UA_STRONGIFY(self)
+        [self savePendingTriggerProgress];
+    }];
+}
+
+- (void)savePendingTriggerProgress {
     [self safePerformBlock:^(BOOL isSafe) {
-        if (!isSafe) {
-            completionHandler(@[]);
+        if (!isSafe || !self.triggerSavePending) {
             return;
         }
 
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleTriggerData"];
-        request.predicate = predicate;
-
-        NSError *error;
-        NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
-        if (error) {
-            UA_LERR(@"Error fetching triggers %@", error);
-            completionHandler(@[]);
-        } else {
-            completionHandler(result);
-            [self.managedContext safeSave];
-        }
+        self.triggerSavePending = NO;
+        [self.managedContext safeSave];
     }];
 }
 
 #pragma mark -
 #pragma mark Converters
 
-- (void)addScheduleDataFromSchedule:(UASchedule *)schedule {
+- (UAScheduleData *)addScheduleDataFromSchedule:(UASchedule *)schedule {
     UAScheduleData *scheduleData = [NSEntityDescription insertNewObjectForEntityForName:@"UAScheduleData"
                                                                        inManagedObjectContext:self.managedContext];
 
@@ -352,7 +683,7 @@
         scheduleData.delay = [self createDelayDataFromDelay:schedule.info.delay scheduleStart:schedule.info.start schedule:scheduleData];
     }
 
-    return;
+    return scheduleData;
 }
 
 - (UAScheduleDelayData *)createDelayDataFromDelay:(UAScheduleDelay *)delay scheduleStart:(NSDate *)scheduleStart schedule:(UAScheduleData *)schedule {
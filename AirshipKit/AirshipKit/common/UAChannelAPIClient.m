@@ -14,7 +14,7 @@
 @implementation UAChannelAPIClient
 
 + (instancetype)clientWithConfig:(UARuntimeConfig *)config {
-    return [UAChannelAPIClient clientWithConfig:config session:[UARequestSession sessionWithConfig:config]];
+    return [UAChannelAPIClient clientWithConfig:config session:[UARequestSession sessionWithConfig:config priority:UARequestPriorityRegistration]];
 }
 
 + (instancetype)clientWithConfig:(UARuntimeConfig *)config session:(UARequestSession *)session {
@@ -187,6 +187,16 @@ typedef NS_ENUM(NSUInteger, UACloudSite) {
  */
 @property (nonatomic, assign, getter=isChannelCreationDelayEnabled) BOOL channelCreationDelayEnabled;
 
+/**
+ * Flag indicating whether deferred component initialization is enabled. If set to `YES`, `takeOff`
+ * only creates the components needed to handle push notifications at launch. The remaining
+ * components, such as automation, remote data, in-app messaging and the inbox, are created
+ * on the main queue after the app first becomes active, or on the calling thread when they are first accessed.
+ *
+ * Defaults to `NO`.
+ */
+@property (nonatomic, assign, getter=isDeferredComponentInitializationEnabled) BOOL deferredComponentInitializationEnabled;
+
 /**
  * Dictionary of custom config values.
  */
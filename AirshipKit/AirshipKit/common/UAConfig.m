@@ -53,6 +53,7 @@ NSString *const UALogLevelTraceName = @"TRACE";
         self.openURLWhitelistingEnabled = NO;
         self.customConfig = @{};
         self.channelCreationDelayEnabled = NO;
+        self.deferredComponentInitializationEnabled = NO;
         self.defaultDetectProvisioningMode = YES;
     }
 
@@ -90,6 +91,7 @@ NSString *const UALogLevelTraceName = @"TRACE";
         _openURLWhitelistingEnabled = config.openURLWhitelistingEnabled;
         _customConfig = config.customConfig;
         _channelCreationDelayEnabled = config.channelCreationDelayEnabled;
+        _deferredComponentInitializationEnabled = config.deferredComponentInitializationEnabled;
         _defaultDetectProvisioningMode = config.defaultDetectProvisioningMode;
         _messageCenterStyleConfig = config.messageCenterStyleConfig;
         _itunesID = config.itunesID;
@@ -126,6 +128,7 @@ NSString *const UALogLevelTraceName = @"TRACE";
             "URL Whitelisting Enabled: %d\n"
             "Custom Config: %@\n"
             "Delay Channel Creation: %d\n"
+            "Deferred Component Initialization: %d\n"
             "Default Message Center Style Config File: %@\n"
             "Use iTunes ID: %@\n"
             "Site:  %ld\n",
@@ -156,6 +159,7 @@ NSString *const UALogLevelTraceName = @"TRACE";
             self.openURLWhitelistingEnabled,
             self.customConfig,
             self.channelCreationDelayEnabled,
+            self.deferredComponentInitializationEnabled,
             self.messageCenterStyleConfig,
             self.itunesID,
             (long) self.site];
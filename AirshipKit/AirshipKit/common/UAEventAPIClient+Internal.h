@@ -41,6 +41,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 -(void)uploadEvents:(NSArray *)events completionHandler:(void (^)(NSHTTPURLResponse * nullable))completionHandler;
 
+/**
+ * Uploads an already serialized analytic events body.
+ * @param body The JSON array of events, see UAEventBodyWriter.
+ * @param gzipped Whether the body is already gzip compressed.
+ * @param completionHandler A completion handler.
+ */
+-(void)uploadEventBody:(NSData *)body gzipped:(BOOL)gzipped completionHandler:(void (^)(NSHTTPURLResponse * nullable))completionHandler;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -16,7 +16,7 @@
 @implementation UAEventAPIClient
 
 + (instancetype)clientWithConfig:(UARuntimeConfig *)config {
-    return [[UAEventAPIClient alloc] initWithConfig:config session:[UARequestSession sessionWithConfig:config]];
+    return [[UAEventAPIClient alloc] initWithConfig:config session:[UARequestSession sessionWithConfig:config priority:UARequestPriorityAnalytics]];
 }
 
 + (instancetype)clientWithConfig:(UARuntimeConfig *)config session:(UARequestSession *)session {
@@ -33,6 +33,24 @@
         UA_LTRACE(@"Sending analytics body: %@", [NSJSONSerialization stringWithObject:events options:NSJSONWritingPrettyPrinted]);
     }
 
+    [self performRequest:request completionHandler:completionHandler];
+}
+
+-(void)uploadEventBody:(NSData *)body gzipped:(BOOL)gzipped completionHandler:(void (^)(NSHTTPURLResponse *))completionHandler {
+    UARequest *request = [self requestWithBody:body gzipped:gzipped];
+
+    if (uaLogLevel >= UALogLevelTrace) {
+        UA_LTRACE(@"Sending to server: %@", self.config.analyticsURL);
+        UA_LTRACE(@"Sending analytics headers: %@", [request.headers descriptionWithLocale:nil indent:1]);
+        if (!gzipped) {
+            UA_LTRACE(@"Sending analytics body: %@", [[NSString alloc] initWithData:body encoding:NSUTF8StringEncoding]);
+        }
+    }
+
+    [self performRequest:request completionHandler:completionHandler];
+}
+
+- (void)performRequest:(UARequest *)request completionHandler:(void (^)(NSHTTPURLResponse *))completionHandler {
     // Perform the upload
     [self.session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
         NSHTTPURLResponse *httpResponse = nil;
@@ -59,15 +77,24 @@
 }
 
 - (UARequest*)requestWithEvents:(NSArray *)events {
+    return [self requestWithBody:[UAJSONSerialization dataWithJSONObject:events options:0 error:nil] gzipped:NO];
+}
+
+- (UARequest*)requestWithBody:(NSData *)body gzipped:(BOOL)gzipped {
     UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
         builder.URL = [NSURL URLWithString:[NSString stringWithFormat:@"%@%@", self.config.analyticsURL, @"/warp9/"]];
         builder.method = @"POST";
 
         // Body
-        builder.compressBody = YES;
-        builder.body = [UAJSONSerialization dataWithJSONObject:events options:0 error:nil];
+        builder.body = body;
         [builder setValue:@"application/json" forHeader:@"Content-Type"];
 
+        if (gzipped) {
+            [builder setValue:@"gzip" forHeader:@"Content-Encoding"];
+        } else {
+            builder.compressBody = YES;
+        }
+
         // Sent timestamp
         [builder setValue:[NSString stringWithFormat:@"%f",[[NSDate date] timeIntervalSince1970]] forHeader:@"X-UA-Sent-At"];
 
@@ -0,0 +1,74 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Writes the analytics upload body directly from stored event data.
+ *
+ * Events are stored as serialized JSON, so instead of decoding every event to add
+ * the envelope and then encoding the whole batch again, the envelope fields are
+ * written around the stored bytes and the output is deflated as each event is appended.
+ */
+@interface UAEventBodyWriter : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Event Body Writer Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * Whether the body is gzip compressed.
+ */
+@property (nonatomic, readonly, getter=isCompressed) BOOL compressed;
+
+/**
+ * The number of events written.
+ */
+@property (nonatomic, readonly) NSUInteger eventCount;
+
+///---------------------------------------------------------------------------------------
+/// @name Event Body Writer Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Default factory method. The body will be gzip compressed.
+ *
+ * @return A UAEventBodyWriter instance.
+ */
++ (instancetype)bodyWriter;
+
+/**
+ * Factory method.
+ *
+ * @param compress Whether the body should be gzip compressed.
+ * @return A UAEventBodyWriter instance.
+ */
++ (instancetype)bodyWriterWithCompression:(BOOL)compress;
+
+/**
+ * Appends an event to the body.
+ *
+ * @param eventID The event's ID.
+ * @param type The event's type.
+ * @param time The event's time.
+ * @param sessionID The event's session ID. Added to the event's data.
+ * @param data The event's stored JSON data. Must be a JSON object.
+ * @return `YES` if the event was written, `NO` if the data is not a valid JSON object.
+ */
+- (BOOL)appendEventWithID:(nullable NSString *)eventID
+                     type:(nullable NSString *)type
+                     time:(nullable NSString *)time
+                sessionID:(nullable NSString *)sessionID
+                     data:(nullable NSData *)data;
+
+/**
+ * Finishes the body. No events can be appended afterwards.
+ *
+ * @return The body, or `nil` if compression failed.
+ */
+- (nullable NSData *)finish;
+
+@end
+
+NS_ASSUME_NONNULL_END
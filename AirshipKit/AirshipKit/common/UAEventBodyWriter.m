@@ -0,0 +1,360 @@
+/* Copyright Airship and Contributors */
+
+#import <zlib.h>
+
+#import "UAEventBodyWriter+Internal.h"
+#import "UAGlobal.h"
+#import "UAJSONSerialization+Internal.h"
+
+// Small writes are staged and deflated together once this many bytes are pending
+#define UAEventBodyWriterStagingSize 16384
+
+// Minimum output buffer growth while deflating
+static NSUInteger const UAEventBodyWriterChunkSize = 16384;
+
+// Session ID key added to each event's data
+static NSString * const UAEventBodyWriterSessionIDKey = @"session_id";
+
+static BOOL UAEventBodyWriterIsWhitespace(uint8_t byte) {
+    return byte == ' ' || byte == '\t' || byte == '\n' || byte == '\r';
+}
+
+@interface UAEventBodyWriter () {
+    z_stream _stream;
+    uint8_t _staging[UAEventBodyWriterStagingSize];
+    NSUInteger _stagingLength;
+}
+
+@property (nonatomic, assign) BOOL compressed;
+@property (nonatomic, assign) NSUInteger eventCount;
+@property (nonatomic, strong) NSMutableData *output;
+@property (nonatomic, assign) NSUInteger outputLength;
+@property (nonatomic, strong) NSMutableData *scratch;
+@property (nonatomic, assign) BOOL streamOpen;
+@property (nonatomic, assign) BOOL finished;
+@property (nonatomic, assign) BOOL failed;
+
+@end
+
+@implementation UAEventBodyWriter
+
+- (instancetype)initWithCompression:(BOOL)compress {
+    self = [super init];
+
+    if (self) {
+        self.compressed = compress;
+        self.output = [NSMutableData data];
+        self.scratch = [NSMutableData data];
+
+        if (compress) {
+            _stream.zalloc = Z_NULL;
+            _stream.zfree = Z_NULL;
+            _stream.opaque = Z_NULL;
+
+            if (deflateInit2(&_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, (15+16), 8, Z_DEFAULT_STRATEGY) == Z_OK) {
+                self.streamOpen = YES;
+            } else {
+                UA_LERR(@"Unable to initialize event body compression");
+                self.failed = YES;
+            }
+        }
+
+        [self writeString:@"["];
+    }
+
+    return self;
+}
+
++ (instancetype)bodyWriter {
+    return [[self alloc] initWithCompression:YES];
+}
+
++ (instancetype)bodyWriterWithCompression:(BOOL)compress {
+    return [[self alloc] initWithCompression:compress];
+}
+
+- (void)dealloc {
+    if (self.streamOpen) {
+        deflateEnd(&_stream);
+    }
+}
+
+- (BOOL)appendEventWithID:(NSString *)eventID
+                     type:(NSString *)type
+                     time:(NSString *)time
+                sessionID:(NSString *)sessionID
+                     data:(NSData *)data {
+    if (self.finished) {
+        return NO;
+    }
+
+    // The session ID replaces any stored value, so data that might already have one goes through a full parse
+    BOOL sessionIDWritten = NO;
+    if ([self data:data containsKey:UAEventBodyWriterSessionIDKey]) {
+        data = [self normalizedObjectData:data sessionID:sessionID];
+        sessionIDWritten = YES;
+    }
+
+    NSRange objectRange;
+    if (!data || ![self findObjectRange:&objectRange inData:data]) {
+        // Not a compact JSON object, normalize it through a full parse
+        data = [self normalizedObjectData:data sessionID:sessionID];
+        sessionIDWritten = YES;
+
+        if (!data || ![self findObjectRange:&objectRange inData:data]) {
+            return NO;
+        }
+    }
+
+    const uint8_t *bytes = data.bytes;
+    BOOL isEmptyObject = YES;
+    for (NSUInteger i = objectRange.location + 1; i < NSMaxRange(objectRange) - 1; i++) {
+        if (!UAEventBodyWriterIsWhitespace(bytes[i])) {
+            isEmptyObject = NO;
+            break;
+        }
+    }
+
+    [self writeString:self.eventCount ? @",{" : @"{"];
+
+    BOOL needsSeparator = NO;
+    needsSeparator |= [self writeKey:@"event_id" value:eventID separator:needsSeparator];
+    needsSeparator |= [self writeKey:@"time" value:time separator:needsSeparator];
+    needsSeparator |= [self writeKey:@"type" value:type separator:needsSeparator];
+
+    [self writeString:needsSeparator ? @",\"data\":" : @"\"data\":"];
+
+    if (sessionIDWritten) {
+        [self writeBytes:bytes + objectRange.location length:objectRange.length];
+    } else {
+        // Stored data minus its closing brace, followed by the session ID
+        [self writeBytes:bytes + objectRange.location length:objectRange.length - 1];
+        [self writeKey:UAEventBodyWriterSessionIDKey value:sessionID separator:!isEmptyObject];
+        [self writeString:@"}"];
+    }
+
+    [self writeString:@"}"];
+
+    self.eventCount++;
+    return YES;
+}
+
+- (NSData *)finish {
+    if (!self.finished) {
+        [self writeString:@"]"];
+        self.finished = YES;
+
+        if (self.compressed && !self.failed) {
+            [self deflateBytes:_staging length:_stagingLength flush:Z_FINISH];
+            _stagingLength = 0;
+
+            // Drop the spare capacity
+            self.output.length = self.outputLength;
+        }
+
+        if (self.streamOpen) {
+            deflateEnd(&_stream);
+            self.streamOpen = NO;
+        }
+    }
+
+    return self.failed ? nil : [self.output copy];
+}
+
+#pragma mark -
+#pragma mark Event data
+
+/**
+ * Finds the outer braces of a JSON object, ignoring surrounding whitespace.
+ */
+- (BOOL)findObjectRange:(NSRange *)range inData:(NSData *)data {
+    const uint8_t *bytes = data.bytes;
+    NSUInteger length = data.length;
+
+    NSUInteger start = 0;
+    while (start < length && UAEventBodyWriterIsWhitespace(bytes[start])) {
+        start++;
+    }
+
+    NSUInteger end = length;
+    while (end > start && UAEventBodyWriterIsWhitespace(bytes[end - 1])) {
+        end--;
+    }
+
+    if (end - start < 2 || bytes[start] != '{' || bytes[end - 1] != '}') {
+        return NO;
+    }
+
+    *range = NSMakeRange(start, end - start);
+    return YES;
+}
+
+/**
+ * Checks if the data contains the quoted key anywhere. Nested keys and string values also match,
+ * so a match only means the data needs a full parse.
+ */
+- (BOOL)data:(NSData *)data containsKey:(NSString *)key {
+    if (!data.length) {
+        return NO;
+    }
+
+    NSData *quotedKey = [[NSString stringWithFormat:@"\"%@\"", key] dataUsingEncoding:NSUTF8StringEncoding];
+    return [data rangeOfData:quotedKey options:0 range:NSMakeRange(0, data.length)].location != NSNotFound;
+}
+
+/**
+ * Parses the data and writes it back as a compact JSON object with the session ID set, or
+ * removed if the session ID is nil.
+ */
+- (nullable NSData *)normalizedObjectData:(NSData *)data sessionID:(nullable NSString *)sessionID {
+    if (!data) {
+        return nil;
+    }
+
+    NSError *error;
+    id object = [NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingMutableContainers error:&error];
+    if (error || ![object isKindOfClass:[NSDictionary class]]) {
+        UA_LERR(@"Invalid event data: %@", error);
+        return nil;
+    }
+
+    [object setValue:sessionID forKey:UAEventBodyWriterSessionIDKey];
+    return [UAJSONSerialization dataWithJSONObject:object options:0 error:nil];
+}
+
+#pragma mark -
+#pragma mark Output
+
+/**
+ * Writes a string field, skipped if the value is nil.
+ *
+ * @return `YES` if the field was written.
+ */
+- (BOOL)writeKey:(NSString *)key value:(nullable NSString *)value separator:(BOOL)separator {
+    if (!value) {
+        return NO;
+    }
+
+    if (separator) {
+        [self writeString:@","];
+    }
+
+    [self writeJSONString:key];
+    [self writeString:@":"];
+    [self writeJSONString:value];
+    return YES;
+}
+
+- (void)writeJSONString:(NSString *)string {
+    NSMutableData *scratch = self.scratch;
+    scratch.length = 0;
+
+    const char *utf8 = string.UTF8String;
+    size_t length = [string lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+
+    [scratch appendBytes:"\"" length:1];
+
+    size_t runStart = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t byte = (uint8_t)utf8[i];
+        if (byte != '"' && byte != '\\' && byte >= 0x20) {
+            continue;
+        }
+
+        [scratch appendBytes:utf8 + runStart length:i - runStart];
+        runStart = i + 1;
+
+        char escaped[7];
+        switch (byte) {
+            case '"':
+                [scratch appendBytes:"\\\"" length:2];
+                break;
+            case '\\':
+                [scratch appendBytes:"\\\\" length:2];
+                break;
+            case '\n':
+                [scratch appendBytes:"\\n" length:2];
+                break;
+            case '\r':
+                [scratch appendBytes:"\\r" length:2];
+                break;
+            case '\t':
+                [scratch appendBytes:"\\t" length:2];
+                break;
+            default:
+                snprintf(escaped, sizeof(escaped), "\\u%04x", byte);
+                [scratch appendBytes:escaped length:6];
+                break;
+        }
+    }
+
+    [scratch appendBytes:utf8 + runStart length:length - runStart];
+    [scratch appendBytes:"\"" length:1];
+
+    [self writeBytes:scratch.bytes length:scratch.length];
+}
+
+- (void)writeString:(NSString *)string {
+    const char *utf8 = string.UTF8String;
+    [self writeBytes:utf8 length:strlen(utf8)];
+}
+
+- (void)writeBytes:(const void *)bytes length:(NSUInteger)length {
+    if (self.failed || !length) {
+        return;
+    }
+
+    if (!self.compressed) {
+        [self.output appendBytes:bytes length:length];
+        return;
+    }
+
+    // Most writes are a few bytes, so they are staged instead of making a deflate call each
+    if (_stagingLength + length > UAEventBodyWriterStagingSize) {
+        [self deflateBytes:_staging length:_stagingLength flush:Z_NO_FLUSH];
+        _stagingLength = 0;
+    }
+
+    if (length >= UAEventBodyWriterStagingSize) {
+        [self deflateBytes:bytes length:length flush:Z_NO_FLUSH];
+    } else {
+        memcpy(_staging + _stagingLength, bytes, length);
+        _stagingLength += length;
+    }
+}
+
+/**
+ * Deflates the bytes into the output. The output only grows when deflate runs out of space,
+ * and its spare capacity is kept for the next call.
+ */
+- (void)deflateBytes:(const void *)bytes length:(NSUInteger)length flush:(int)flush {
+    if (self.failed || (!length && flush == Z_NO_FLUSH)) {
+        return;
+    }
+
+    _stream.next_in = (Bytef *)bytes;
+    _stream.avail_in = (uInt)length;
+
+    int status;
+    do {
+        if (self.outputLength == self.output.length) {
+            [self.output increaseLengthBy:MAX(UAEventBodyWriterChunkSize, self.output.length)];
+        }
+
+        NSUInteger available = self.output.length - self.outputLength;
+        _stream.next_out = (Bytef *)self.output.mutableBytes + self.outputLength;
+        _stream.avail_out = (uInt)available;
+
+        status = deflate(&_stream, flush);
+
+        self.outputLength += available - _stream.avail_out;
+
+        if (status == Z_STREAM_ERROR) {
+            UA_LERR(@"Failed to compress event body");
+            self.failed = YES;
+            return;
+        }
+    } while (flush == Z_FINISH ? status != Z_STREAM_END : _stream.avail_out == 0);
+}
+
+@end
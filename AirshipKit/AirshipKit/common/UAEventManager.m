@@ -7,6 +7,7 @@
 #import "UAEventData+Internal.h"
 #import "UAAsyncOperation+Internal.h"
 #import "UAEventAPIClient+Internal.h"
+#import "UAEventBodyWriter+Internal.h"
 #import "UAEvent+Internal.h"
 #import "UARuntimeConfig.h"
 #import "UAChannel.h"
@@ -15,7 +16,7 @@
 #import "UADispatcher+Internal.h"
 #import "UAAppStateTrackerFactory+Internal.h"
 
-@interface UAEventManager() <UAAppStateTrackerDelegate>
+@interface UAEventManager() <UAAppStateTrackerDelegate, UAEventStoreDelegate>
 
 @property (nonatomic, strong, nonnull) UARuntimeConfig *config;
 @property (nonatomic, strong, nonnull) UAEventStore *eventStore;
@@ -56,6 +57,7 @@ const NSTimeInterval BackgroundLowPriorityEventUploadInterval = 900;
     if (self) {
         self.config = config;
         self.eventStore = eventStore;
+        self.eventStore.delegate = self;
         self.dataStore = dataStore;
         self.client = client;
         self.queue = queue;
@@ -242,6 +244,13 @@ const NSTimeInterval BackgroundLowPriorityEventUploadInterval = 900;
     [self cancelUpload];
 }
 
+#pragma mark -
+#pragma mark UAEventStoreDelegate
+
+- (void)eventStore:(UAEventStore *)eventStore didTrimEvents:(NSUInteger)count bytes:(NSUInteger)bytes {
+    UA_LINFO(@"Analytic event store over its size limit, dropped %lu oldest events (%lu bytes)", (unsigned long)count, (unsigned long)bytes);
+}
+
 #pragma mark -
 #pragma mark Event upload
 
@@ -334,81 +343,116 @@ const NSTimeInterval BackgroundLowPriorityEventUploadInterval = 900;
         // Clean up store
         [self.eventStore trimEventsToStoreSize:self.maxTotalDBSize];
 
-        // Fetch events
-        [self.eventStore fetchEventsWithMaxBatchSize:self.maxBatchSize completionHandler:^(NSArray<UAEventData *> *result) {
+        [self uploadNextBatchWithOperation:operation previousEventIDs:nil];
+    }];
 
-            // Make sure we are not cancelled
-            if (operation.isCancelled) {
+    return [self.queue addBackgroundOperation:operation delay:delay];
+}
+
+/**
+ * Uploads the next batch of events. On success the next batch is uploaded, until the store
+ * is drained or the store stops making progress.
+ */
+- (void)uploadNextBatchWithOperation:(UAAsyncOperation *)operation previousEventIDs:(nullable NSSet<NSString *> *)previousEventIDs {
+    UA_WEAKIFY(self);
+
+    // Fetch events
+    [self.eventStore fetchEventsWithMaxBatchSize:self.maxBatchSize completionHandler:^(NSArray<UAEventData *> *result) {
+
+        // Make sure we are not cancelled
+        if (operation.isCancelled) {
+            [operation finish];
+            return;
+        }
+
+        if (!result.count) {
+            [operation finish];
+            return;
+        }
+
+        // Write the upload body straight from the stored event data
+        UAEventBodyWriter *bodyWriter = [UAEventBodyWriter bodyWriter];
+        NSMutableArray<NSString *> *eventIDs = [NSMutableArray arrayWithCapacity:result.count];
+
+        for (UAEventData *eventData in result) {
+            // Events from the previous batch are still in the store, avoid uploading them again
+            if ([previousEventIDs containsObject:eventData.identifier]) {
+                UA_LTRACE(@"Previous batch not removed from store, stopping upload.");
                 [operation finish];
                 return;
             }
 
-            if (!result.count) {
-                [operation finish];
-                return;
+            BOOL written = [bodyWriter appendEventWithID:eventData.identifier
+                                                    type:eventData.type
+                                                    time:eventData.time
+                                               sessionID:eventData.sessionID
+                                                    data:eventData.data];
+
+            if (!written) {
+                UA_LERR(@"Failed to deserialize event %@", eventData);
+                [[eventData managedObjectContext] deleteObject:eventData];
+                continue;
             }
 
-            NSMutableArray *preparedEvents = [NSMutableArray arrayWithCapacity:result.count];
+            if (eventData.identifier) {
+                [eventIDs addObject:eventData.identifier];
+            }
+        }
 
-            for (UAEventData *eventData in result) {
-                NSMutableDictionary *eventBody = [NSMutableDictionary dictionary];
-                [eventBody setValue:eventData.identifier forKey:@"event_id"];
-                [eventBody setValue:eventData.time forKey:@"time"];
-                [eventBody setValue:eventData.type forKey:@"type"];
+        NSData *body = [bodyWriter finish];
+        BOOL gzipped = bodyWriter.isCompressed;
 
-                NSError *error = nil;
-                NSMutableDictionary *data = [[NSJSONSerialization JSONObjectWithData:eventData.data options:0 error:&error] mutableCopy];
-                if (error) {
-                    UA_LERR(@"Failed to deserialize event %@: %@", eventData, error);
-                    [[eventData managedObjectContext] deleteObject:eventData];
-                }
+        // Make sure we are not cancelled
+        if (operation.isCancelled || !bodyWriter.eventCount) {
+            [operation finish];
+            return;
+        }
 
-                [data setValue:eventData.sessionID forKey:@"session_id"];
-                [eventBody setValue:data forKey:@"data"];
+        if (!body) {
+            UA_LERR(@"Failed to write analytics upload body");
+            UA_STRONGIFY(self);
+            [self scheduleUploadWithDelay:FailedUploadRetryDelay];
+            [operation finish];
+            return;
+        }
 
-                [preparedEvents addObject:eventBody];
-            }
+        UA_LTRACE("Uploading events.");
+
+        // Make sure the event upload request is queueed and on the main thread as it needs to access application state
+        [[UADispatcher mainDispatcher] dispatchAsync: ^{
 
-            // Make sure we are not cancelled
+            // Make sure we are still not cancelled
             if (operation.isCancelled) {
                 [operation finish];
                 return;
             }
 
-            UA_LTRACE("Uploading events.");
-
-            // Make sure the event upload request is queueed and on the main thread as it needs to access application state
-            [[UADispatcher mainDispatcher] dispatchAsync: ^{
-
-                // Make sure we are still not cancelled
-                if (operation.isCancelled) {
-                    [operation finish];
-                    return;
-                }
+            UA_STRONGIFY(self);
+            [self.client uploadEventBody:body gzipped:gzipped completionHandler:^(NSHTTPURLResponse *response) {
 
                 UA_STRONGIFY(self);
-                [self.client uploadEvents:preparedEvents completionHandler:^(NSHTTPURLResponse *response) {
-
-                    UA_STRONGIFY(self);
-                    self.lastSendTime = [NSDate date];
-
-                    if (response.statusCode == 200) {
-                        UA_LTRACE(@"Analytic upload success");
-                        UA_LTRACE(@"Response: %@", response);
-                        [self.eventStore deleteEventsWithIDs:[preparedEvents valueForKey:@"event_id"]];
-                        [self updateAnalyticsParametersWithResponse:response];
-                    } else {
-                        UA_LTRACE(@"Analytics upload request failed: %ld", (unsigned long)response.statusCode);
-                        [self scheduleUploadWithDelay:FailedUploadRetryDelay];
+                self.lastSendTime = [NSDate date];
+
+                if (response.statusCode == 200) {
+                    UA_LTRACE(@"Analytic upload success");
+                    UA_LTRACE(@"Response: %@", response);
+                    [self.eventStore deleteEventsWithIDs:eventIDs];
+                    [self updateAnalyticsParametersWithResponse:response];
+
+                    if (!operation.isCancelled && self.uploadsEnabled) {
+                        // The store is serial, so the next fetch runs after the delete
+                        [self uploadNextBatchWithOperation:operation previousEventIDs:[NSSet setWithArray:eventIDs]];
+                        return;
                     }
+                } else {
+                    UA_LTRACE(@"Analytics upload request failed: %ld", (unsigned long)response.statusCode);
+                    [self scheduleUploadWithDelay:FailedUploadRetryDelay];
+                }
 
-                    [operation finish];
-                }];
+                [operation finish];
             }];
         }];
     }];
-
-    return [self.queue addBackgroundOperation:operation delay:delay];
 }
 
 #pragma mark -
@@ -5,12 +5,39 @@
 
 @class UAEvent;
 @class UARuntimeConfig;
+@class UAEventStore;
+
+/**
+ * Event store delegate.
+ */
+@protocol UAEventStoreDelegate <NSObject>
+
+/**
+ * Called when the oldest events are removed to keep the store under its size limit.
+ * Called on the event store's private queue.
+ *
+ * @param eventStore The event store.
+ * @param count The number of events removed.
+ * @param bytes The approximate size of the removed events in bytes.
+ */
+- (void)eventStore:(UAEventStore *)eventStore didTrimEvents:(NSUInteger)count bytes:(NSUInteger)bytes;
+
+@end
 
 /**
  * Storage access for analytic events.
  */
 @interface UAEventStore : NSObject
 
+///---------------------------------------------------------------------------------------
+/// @name Event Store Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The event store delegate.
+ */
+@property (nonatomic, weak) id<UAEventStoreDelegate> delegate;
+
 ///---------------------------------------------------------------------------------------
 /// @name Event Store Internal Methods
 ///---------------------------------------------------------------------------------------
@@ -32,9 +59,10 @@
 - (void)saveEvent:(UAEvent *)event sessionID:(NSString *)sessionID;
 
 /**
- * Fetches a batch of events.
+ * Fetches the oldest events, up to the given batch size. The batch always contains
+ * at least one event if the store is not empty.
  *
- * @param maxBatchSize The max event batch size.
+ * @param maxBatchSize The max event batch size in bytes.
  * @param completionHandler A completion handler with the event data.
  */
 - (void)fetchEventsWithMaxBatchSize:(NSUInteger)maxBatchSize
@@ -48,7 +76,12 @@
 - (void)deleteEventsWithIDs:(NSArray<NSString *> *)eventIds;
 
 /**
- * Deletes event session until the underlying store is below a given size.
+ * Deletes the oldest events until the underlying store is below a given size.
+ *
+ * The store keeps a running total of the event sizes, so this is a no-op unless
+ * the total is over the given size. Events are removed in bounded chunks and the
+ * delegate is notified with the number of removed events.
+ *
  * @param bytes The desired size in bytes for the store size.
  */
 - (void)trimEventsToStoreSize:(NSUInteger)bytes;
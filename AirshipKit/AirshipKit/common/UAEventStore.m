@@ -15,10 +15,20 @@
 NSString *const UAEventStoreFileFormat = @"Events-%@.sqlite";
 NSString *const UAEventDataEntityName = @"UAEventData";
 
+// Number of rows faulted in at a time while filling a batch
+static NSUInteger const UAEventStoreFetchBatchSize = 50;
+
+// Max number of rows deleted per trim request
+static NSUInteger const UAEventStoreTrimChunkSize = 100;
+
 @interface UAEventStore ()
 @property (nonatomic, strong) NSManagedObjectContext *managedContext;
 @property (nonatomic, copy) NSString *storeName;
 
+// Running total of the stored event bytes, only accessed on the context's queue
+@property (nonatomic, assign) NSUInteger totalBytes;
+@property (nonatomic, assign) BOOL totalBytesLoaded;
+
 @end
 
 @implementation UAEventStore
@@ -68,13 +78,18 @@ NSString *const UAEventDataEntityName = @"UAEventData";
             return;
         }
 
-        [self storeEventWithID:event.eventID
-                     eventType:event.eventType
-                     eventTime:event.time
-                     eventBody:event.data
-                     sessionID:sessionID];
+        UAEventData *eventData = [self storeEventWithID:event.eventID
+                                              eventType:event.eventType
+                                              eventTime:event.time
+                                              eventBody:event.data
+                                              sessionID:sessionID];
 
-        [self.managedContext safeSave];
+        if ([self.managedContext safeSave]) {
+            [self addBytes:eventData.bytes.unsignedIntegerValue];
+        } else {
+            // Reload the total the next time it is needed
+            self.totalBytesLoaded = NO;
+        }
     }];
 }
 
@@ -89,17 +104,49 @@ NSString *const UAEventDataEntityName = @"UAEventData";
         }
 
         NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
-        request.sortDescriptors = @[ [NSSortDescriptor sortDescriptorWithKey:@"storeDate" ascending:NO] ];
+        request.sortDescriptors = @[ [NSSortDescriptor sortDescriptorWithKey:@"storeDate" ascending:YES] ];
+
+        // Only object IDs are loaded up front, rows are faulted in as the batch is filled
+        request.fetchBatchSize = UAEventStoreFetchBatchSize;
 
         NSError *error;
-        NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
+        NSArray<UAEventData *> *result = [self.managedContext executeFetchRequest:request error:&error];
 
         if (error) {
             UA_LERR(@"Error fetching events %@", error);
             completionHandler(@[]);
+            return;
+        }
+
+        NSMutableArray<UAEventData *> *batch = [NSMutableArray array];
+        NSUInteger batchBytes = 0;
+
+        for (UAEventData *eventData in result) {
+            NSUInteger bytes = eventData.bytes.unsignedIntegerValue;
+
+            // Always take at least one event so an oversized event can not block the queue
+            if (batch.count && batchBytes + bytes > maxBatchSize) {
+                break;
+            }
+
+            batchBytes += bytes;
+            [batch addObject:eventData];
+        }
+
+        completionHandler(batch);
+
+        // Account for any events the handler deleted
+        NSUInteger deletedBytes = 0;
+        for (NSManagedObject *object in self.managedContext.deletedObjects) {
+            if ([object isKindOfClass:[UAEventData class]]) {
+                deletedBytes += ((UAEventData *)object).bytes.unsignedIntegerValue;
+            }
+        }
+
+        if ([self.managedContext safeSave]) {
+            [self removeBytes:deletedBytes];
         } else {
-            completionHandler(result);
-            [self.managedContext safeSave];
+            self.totalBytesLoaded = NO;
         }
     }];
 }
@@ -113,6 +160,9 @@ NSString *const UAEventDataEntityName = @"UAEventData";
         NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
         request.predicate = [NSPredicate predicateWithFormat:@"identifier IN %@", eventIDs];
 
+        // Only sums the deleted rows, the running total is never recomputed from the whole table
+        NSNumber *deletedBytes = self.totalBytesLoaded ? [self sumBytesWithPredicate:request.predicate] : nil;
+
         NSError *error;
         NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:request];
         [self.managedContext executeRequest:deleteRequest error:&error];
@@ -122,6 +172,13 @@ NSString *const UAEventDataEntityName = @"UAEventData";
             return;
         }
 
+        if (deletedBytes) {
+            [self removeBytes:deletedBytes.unsignedIntegerValue];
+        } else {
+            // Reload the total the next time it is needed
+            self.totalBytesLoaded = NO;
+        }
+
         [self.managedContext safeSave];
     }];
 }
@@ -143,6 +200,9 @@ NSString *const UAEventDataEntityName = @"UAEventData";
             return;
         }
 
+        self.totalBytes = 0;
+        self.totalBytesLoaded = YES;
+
         [self.managedContext safeSave];
     }];
 }
@@ -153,23 +213,121 @@ NSString *const UAEventDataEntityName = @"UAEventData";
             return;
         }
 
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
-        request.sortDescriptors = @[ [NSSortDescriptor sortDescriptorWithKey:@"storeDate" ascending:NO] ];
-        request.predicate = [NSPredicate predicateWithFormat:@"@sum.bytes >= %ld", (unsigned long)maxSize];
+        if (![self loadTotalBytes] || self.totalBytes <= maxSize) {
+            return;
+        }
 
-        NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:request];
+        NSUInteger trimmedCount = 0;
+        NSUInteger trimmedBytes = 0;
 
-        NSError *error;
-        [self.managedContext executeRequest:deleteRequest error:&error];
-        if (error) {
-            UA_LERR(@"Error trimming analytic event store %@", error);
-            return;
+        while (self.totalBytes > maxSize) {
+            NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
+            request.sortDescriptors = @[ [NSSortDescriptor sortDescriptorWithKey:@"storeDate" ascending:YES] ];
+            request.propertiesToFetch = @[@"bytes"];
+            request.fetchLimit = UAEventStoreTrimChunkSize;
+
+            NSError *error;
+            NSArray<UAEventData *> *result = [self.managedContext executeFetchRequest:request error:&error];
+            if (error) {
+                UA_LERR(@"Error trimming analytic event store %@", error);
+                break;
+            }
+
+            // Nothing left, the running total drifted
+            if (!result.count) {
+                self.totalBytes = 0;
+                break;
+            }
+
+            NSMutableArray<NSManagedObjectID *> *objectIDs = [NSMutableArray arrayWithCapacity:result.count];
+            NSUInteger chunkBytes = 0;
+            for (UAEventData *eventData in result) {
+                if (chunkBytes >= self.totalBytes || self.totalBytes - chunkBytes <= maxSize) {
+                    break;
+                }
+
+                chunkBytes += eventData.bytes.unsignedIntegerValue;
+                [objectIDs addObject:eventData.objectID];
+            }
+
+            NSFetchRequest *deleteFetchRequest = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
+            deleteFetchRequest.predicate = [NSPredicate predicateWithFormat:@"self IN %@", objectIDs];
+
+            NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:deleteFetchRequest];
+            [self.managedContext executeRequest:deleteRequest error:&error];
+            if (error) {
+                UA_LERR(@"Error trimming analytic event store %@", error);
+                break;
+            }
+
+            [self removeBytes:chunkBytes];
+            trimmedCount += objectIDs.count;
+            trimmedBytes += chunkBytes;
         }
 
         [self.managedContext safeSave];
+
+        if (trimmedCount) {
+            [self.delegate eventStore:self didTrimEvents:trimmedCount bytes:trimmedBytes];
+        }
     }];
 }
 
+#pragma mark -
+#pragma mark Store size
+
+/**
+ * Loads the running total with a single aggregate query. Must be called on the context's queue.
+ */
+- (BOOL)loadTotalBytes {
+    if (self.totalBytesLoaded) {
+        return YES;
+    }
+
+    NSNumber *totalBytes = [self sumBytesWithPredicate:nil];
+    if (!totalBytes) {
+        return NO;
+    }
+
+    self.totalBytes = totalBytes.unsignedIntegerValue;
+    self.totalBytesLoaded = YES;
+    return YES;
+}
+
+- (NSNumber *)sumBytesWithPredicate:(NSPredicate *)predicate {
+    NSExpressionDescription *sumDescription = [[NSExpressionDescription alloc] init];
+    sumDescription.name = @"totalBytes";
+    sumDescription.expression = [NSExpression expressionForFunction:@"sum:"
+                                                          arguments:@[[NSExpression expressionForKeyPath:@"bytes"]]];
+    sumDescription.expressionResultType = NSInteger64AttributeType;
+
+    NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
+    request.predicate = predicate;
+    request.resultType = NSDictionaryResultType;
+    request.propertiesToFetch = @[sumDescription];
+
+    NSError *error;
+    NSArray<NSDictionary *> *result = [self.managedContext executeFetchRequest:request error:&error];
+    if (error) {
+        UA_LERR(@"Error calculating analytic event store size %@", error);
+        return nil;
+    }
+
+    return result.firstObject[@"totalBytes"] ?: @(0);
+}
+
+- (void)addBytes:(NSUInteger)bytes {
+    if (self.totalBytesLoaded) {
+        self.totalBytes += bytes;
+    }
+}
+
+- (void)removeBytes:(NSUInteger)bytes {
+    if (self.totalBytesLoaded) {
+        self.totalBytes = (bytes > self.totalBytes) ? 0 : self.totalBytes - bytes;
+    }
+}
+
 - (void)migrateOldDatabase {
     NSString *libraryPath = [NSSearchPathForDirectoriesInDomains(NSLibraryDirectory, NSUserDomainMask, YES) lastObject];
     NSString *writableDBPath = [libraryPath stringByAppendingPathComponent:@"UAAnalyticsDB"];
@@ -231,14 +389,20 @@ NSString *const UAEventDataEntityName = @"UAEventData";
     [[NSFileManager defaultManager] removeItemAtPath:writableDBPath error:nil];
 
     [self.managedContext safeSave];
+
+    // Reload the total the next time it is needed
+    self.totalBytesLoaded = NO;
 }
 
-- (void)storeEventWithID:(NSString *)eventID eventType:(NSString *)eventType eventTime:(NSString *)eventTime eventBody:(id)eventBody sessionID:(NSString *)sessionID {
+/**
+ * Inserts the event data. The running total is updated by the caller once the context is saved.
+ */
+- (UAEventData *)storeEventWithID:(NSString *)eventID eventType:(NSString *)eventType eventTime:(NSString *)eventTime eventBody:(id)eventBody sessionID:(NSString *)sessionID {
     NSError *error;
     id json = [UAJSONSerialization dataWithJSONObject:eventBody options:0 error:&error];
     if (error) {
         UA_LERR(@"Unable to save event. %@", error);
-        return;
+        return nil;
     }
 
     UAEventData *eventData = [NSEntityDescription insertNewObjectForEntityForName:UAEventDataEntityName
@@ -255,6 +419,7 @@ NSString *const UAEventDataEntityName = @"UAEventData";
     eventData.bytes = @(eventData.sessionID.length + eventData.type.length + eventData.time.length + eventData.identifier.length + eventData.data.length);
 
     UA_LTRACE(@"Event saved: %@", eventID);
+    return eventData;
 }
 
 @end
@@ -0,0 +1,55 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class UAJSONPredicate;
+
+/**
+ * A compiled form of a UAJSONPredicate.
+ *
+ * The predicate, matcher and value matcher tree is flattened into a single instruction
+ * array that is evaluated in one loop. Scope and key paths are resolved when the predicate is
+ * compiled, and matchers that path into the same object share a single lookup per evaluation.
+ *
+ * Evaluation results are identical to evaluating the source predicate.
+ */
+@interface UAJSONCompiledPredicate : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name JSON Compiled Predicate Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The source predicate.
+ */
+@property (nonatomic, readonly) UAJSONPredicate *predicate;
+
+///---------------------------------------------------------------------------------------
+/// @name JSON Compiled Predicate Factories
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method to compile a predicate.
+ *
+ * @param predicate The predicate to compile.
+ * @return A compiled predicate.
+ */
++ (instancetype)compiledPredicateWithPredicate:(UAJSONPredicate *)predicate;
+
+///---------------------------------------------------------------------------------------
+/// @name JSON Compiled Predicate Evaluation
+///---------------------------------------------------------------------------------------
+
+/**
+ * Evaluates the object with the compiled predicate.
+ *
+ * @param object The object to evaluate.
+ * @return `YES` if the predicate matches the object, otherwise `NO`.
+ */
+- (BOOL)evaluateObject:(nullable id)object;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,440 @@
+/* Copyright Airship and Contributors */
+
+#import "UAJSONCompiledPredicate+Internal.h"
+#import "UAJSONPredicate+Internal.h"
+#import "UAJSONMatcher+Internal.h"
+#import "UAJSONValueMatcher+Internal.h"
+#import "UAVersionMatcher+Internal.h"
+
+/**
+ * Instruction opcodes.
+ *
+ * Instructions operate on a boolean result register and a value register. Value matcher
+ * checks fall through when they pass, otherwise they clear the result and jump to their target.
+ */
+typedef NS_ENUM(uint8_t, UAJSONCompiledOpcode) {
+    // result = YES
+    UAJSONCompiledOpcodeTrue,
+
+    // result = NO
+    UAJSONCompiledOpcodeFalse,
+
+    // result = !result
+    UAJSONCompiledOpcodeNot,
+
+    // Jumps to the target if the result is NO
+    UAJSONCompiledOpcodeJumpIfFalse,
+
+    // Jumps to the target if the result is YES
+    UAJSONCompiledOpcodeJumpIfTrue,
+
+    // Loads the value at the path with the operand's index
+    UAJSONCompiledOpcodeLoad,
+
+    // result = (value != nil) == flag
+    UAJSONCompiledOpcodeIsPresent,
+
+    // Checks the value is equal to the constant
+    UAJSONCompiledOpcodeEquals,
+
+    // Checks the value is a string equal to the constant string, ignoring case
+    UAJSONCompiledOpcodeEqualsStringIgnoreCase,
+
+    // Checks the value is equal to the constant value matcher's value, ignoring case
+    UAJSONCompiledOpcodeEqualsIgnoreCase,
+
+    // Checks the value is a number at least the constant
+    UAJSONCompiledOpcodeAtLeast,
+
+    // Checks the value is a number at most the constant
+    UAJSONCompiledOpcodeAtMost,
+
+    // Checks the value is a string matching the constant version matcher
+    UAJSONCompiledOpcodeVersion,
+
+    // Checks the value is an array with an element matching the constant compiled predicate.
+    // If the flag is set, only the element at the operand index is checked.
+    UAJSONCompiledOpcodeArrayContains,
+};
+
+/**
+ * Value kinds, resolved once per load.
+ */
+typedef NS_ENUM(uint8_t, UAJSONCompiledValueKind) {
+    UAJSONCompiledValueKindOther,
+    UAJSONCompiledValueKindNumber,
+    UAJSONCompiledValueKindString,
+    UAJSONCompiledValueKindArray,
+};
+
+typedef struct {
+    UAJSONCompiledOpcode opcode;
+    BOOL flag;
+    NSInteger operand;
+    NSUInteger target;
+
+    // Retained by the compiled predicate's constants
+    __unsafe_unretained id constant;
+} UAJSONCompiledInstruction;
+
+typedef struct {
+    // Index of the parent path, or -1 for the root path
+    NSInteger parent;
+
+    // Retained by the compiled predicate's constants
+    __unsafe_unretained NSString *key;
+} UAJSONCompiledPath;
+
+static UAJSONCompiledValueKind UAJSONCompiledValueKindForValue(id value) {
+    if ([value isKindOfClass:[NSString class]]) {
+        return UAJSONCompiledValueKindString;
+    }
+
+    if ([value isKindOfClass:[NSNumber class]]) {
+        return UAJSONCompiledValueKindNumber;
+    }
+
+    if ([value isKindOfClass:[NSArray class]]) {
+        return UAJSONCompiledValueKindArray;
+    }
+
+    return UAJSONCompiledValueKindOther;
+}
+
+static const void *UAJSONCompiledResolvePath(const UAJSONCompiledPath *paths, const void **values, BOOL *resolved, NSInteger index) {
+    if (resolved[index]) {
+        return values[index];
+    }
+
+    id parent = (__bridge id)UAJSONCompiledResolvePath(paths, values, resolved, paths[index].parent);
+    id value = [parent isKindOfClass:[NSDictionary class]] ? [(NSDictionary *)parent objectForKey:paths[index].key] : nil;
+
+    // Values are owned by the evaluated object for the duration of the evaluation
+    values[index] = (__bridge const void *)value;
+    resolved[index] = YES;
+
+    return values[index];
+}
+
+@interface UAJSONCompiledPredicate ()
+@property (nonatomic, strong) UAJSONPredicate *predicate;
+@property (nonatomic, strong) NSMutableData *instructions;
+@property (nonatomic, strong) NSMutableData *paths;
+@property (nonatomic, strong) NSMutableArray *constants;
+@property (nonatomic, strong) NSMutableDictionary<NSArray<NSString *> *, NSNumber *> *pathIndexes;
+@end
+
+@implementation UAJSONCompiledPredicate
+
+- (instancetype)initWithPredicate:(UAJSONPredicate *)predicate {
+    self = [super init];
+
+    if (self) {
+        self.predicate = predicate;
+        self.instructions = [NSMutableData data];
+        self.paths = [NSMutableData data];
+        self.constants = [NSMutableArray array];
+        self.pathIndexes = [NSMutableDictionary dictionary];
+
+        // Root path
+        UAJSONCompiledPath root = { .parent = -1, .key = nil };
+        [self.paths appendBytes:&root length:sizeof(root)];
+        self.pathIndexes[@[]] = @(0);
+
+        [self compilePredicate:predicate];
+
+        // Path indexes are only needed while compiling
+        self.pathIndexes = nil;
+    }
+
+    return self;
+}
+
++ (instancetype)compiledPredicateWithPredicate:(UAJSONPredicate *)predicate {
+    return [[UAJSONCompiledPredicate alloc] initWithPredicate:predicate];
+}
+
+#pragma mark -
+#pragma mark Evaluation
+
+- (BOOL)evaluateObject:(id)object {
+    const UAJSONCompiledInstruction *instructions = self.instructions.bytes;
+    NSUInteger instructionCount = self.instructions.length / sizeof(UAJSONCompiledInstruction);
+
+    const UAJSONCompiledPath *paths = self.paths.bytes;
+    NSUInteger pathCount = self.paths.length / sizeof(UAJSONCompiledPath);
+
+    const void *values[pathCount];
+    BOOL resolved[pathCount];
+    memset(resolved, 0, sizeof(resolved));
+
+    values[0] = (__bridge const void *)object;
+    resolved[0] = YES;
+
+    BOOL result = NO;
+    __unsafe_unretained id value = nil;
+    UAJSONCompiledValueKind kind = UAJSONCompiledValueKindOther;
+
+    NSUInteger pc = 0;
+    while (pc < instructionCount) {
+        const UAJSONCompiledInstruction *instruction = &instructions[pc++];
+        BOOL passed = YES;
+
+        switch (instruction->opcode) {
+            case UAJSONCompiledOpcodeTrue:
+                result = YES;
+                continue;
+
+            case UAJSONCompiledOpcodeFalse:
+                result = NO;
+                continue;
+
+            case UAJSONCompiledOpcodeNot:
+                result = !result;
+                continue;
+
+            case UAJSONCompiledOpcodeJumpIfFalse:
+                if (!result) {
+                    pc = instruction->target;
+                }
+                continue;
+
+            case UAJSONCompiledOpcodeJumpIfTrue:
+                if (result) {
+                    pc = instruction->target;
+                }
+                continue;
+
+            case UAJSONCompiledOpcodeLoad:
+                value = (__bridge id)UAJSONCompiledResolvePath(paths, values, resolved, instruction->operand);
+                kind = UAJSONCompiledValueKindForValue(value);
+                continue;
+
+            case UAJSONCompiledOpcodeIsPresent:
+                result = (value != nil) == instruction->flag;
+                continue;
+
+            case UAJSONCompiledOpcodeEquals:
+                passed = instruction->constant == value || [instruction->constant isEqual:value];
+                break;
+
+            case UAJSONCompiledOpcodeEqualsStringIgnoreCase:
+                passed = instruction->constant == value ||
+                    (kind == UAJSONCompiledValueKindString && [(NSString *)instruction->constant caseInsensitiveCompare:value] == NSOrderedSame);
+                break;
+
+            case UAJSONCompiledOpcodeEqualsIgnoreCase: {
+                UAJSONValueMatcher *valueMatcher = instruction->constant;
+                passed = [valueMatcher value:valueMatcher.equals isEqualToValue:value ignoreCase:YES];
+                break;
+            }
+
+            case UAJSONCompiledOpcodeAtLeast:
+                passed = kind == UAJSONCompiledValueKindNumber && [(NSNumber *)instruction->constant compare:value] != NSOrderedDescending;
+                break;
+
+            case UAJSONCompiledOpcodeAtMost:
+                passed = kind == UAJSONCompiledValueKindNumber && [(NSNumber *)instruction->constant compare:value] != NSOrderedAscending;
+                break;
+
+            case UAJSONCompiledOpcodeVersion:
+                passed = kind == UAJSONCompiledValueKindString && [(UAVersionMatcher *)instruction->constant evaluateObject:value];
+                break;
+
+            case UAJSONCompiledOpcodeArrayContains: {
+                if (kind != UAJSONCompiledValueKindArray) {
+                    passed = NO;
+                    break;
+                }
+
+                NSArray *array = value;
+                UAJSONCompiledPredicate *elementPredicate = instruction->constant;
+
+                if (instruction->flag) {
+                    NSInteger index = instruction->operand;
+                    passed = index >= 0 && (NSUInteger)index < array.count && [elementPredicate evaluateObject:array[index]];
+                } else {
+                    passed = NO;
+                    for (id element in array) {
+                        if ([elementPredicate evaluateObject:element]) {
+                            passed = YES;
+                            break;
+                        }
+                    }
+                }
+                break;
+            }
+        }
+
+        if (!passed) {
+            result = NO;
+            pc = instruction->target;
+        }
+    }
+
+    return result;
+}
+
+#pragma mark -
+#pragma mark Compilation
+
+- (NSUInteger)emit:(UAJSONCompiledOpcode)opcode {
+    return [self emit:opcode operand:0 flag:NO constant:nil];
+}
+
+- (NSUInteger)emit:(UAJSONCompiledOpcode)opcode operand:(NSInteger)operand flag:(BOOL)flag constant:(id)constant {
+    if (constant) {
+        [self.constants addObject:constant];
+    }
+
+    UAJSONCompiledInstruction instruction = {
+        .opcode = opcode,
+        .flag = flag,
+        .operand = operand,
+        .target = 0,
+        .constant = constant
+    };
+
+    NSUInteger index = self.instructions.length / sizeof(UAJSONCompiledInstruction);
+    [self.instructions appendBytes:&instruction length:sizeof(instruction)];
+    return index;
+}
+
+- (void)patchTargets:(NSArray<NSNumber *> *)instructionIndexes {
+    UAJSONCompiledInstruction *instructions = self.instructions.mutableBytes;
+    NSUInteger target = self.instructions.length / sizeof(UAJSONCompiledInstruction);
+
+    for (NSNumber *index in instructionIndexes) {
+        instructions[[index unsignedIntegerValue]].target = target;
+    }
+}
+
+- (NSInteger)pathIndexForComponents:(NSArray<NSString *> *)components {
+    NSInteger parent = 0;
+
+    // Each prefix gets its own path so matchers with a shared scope share the lookups
+    for (NSUInteger i = 1; i <= components.count; i++) {
+        NSArray *prefix = [components subarrayWithRange:NSMakeRange(0, i)];
+        NSNumber *index = self.pathIndexes[prefix];
+
+        if (!index) {
+            NSString *key = components[i - 1];
+            [self.constants addObject:key];
+
+            UAJSONCompiledPath path = { .parent = parent, .key = key };
+            index = @(self.paths.length / sizeof(UAJSONCompiledPath));
+            [self.paths appendBytes:&path length:sizeof(path)];
+            self.pathIndexes[prefix] = index;
+        }
+
+        parent = [index integerValue];
+    }
+
+    return parent;
+}
+
+- (void)compilePredicate:(UAJSONPredicate *)predicate {
+    NSString *type = predicate.type;
+
+    if (!type) {
+        [self compileMatcher:predicate.jsonMatcher];
+        return;
+    }
+
+    NSArray<UAJSONPredicate *> *subpredicates = predicate.subpredicates;
+
+    if ([type isEqualToString:UAJSONPredicateNotType]) {
+        [self compilePredicate:subpredicates.firstObject];
+        [self emit:UAJSONCompiledOpcodeNot];
+        return;
+    }
+
+    BOOL isAnd = [type isEqualToString:UAJSONPredicateAndType];
+    BOOL isOr = [type isEqualToString:UAJSONPredicateOrType];
+
+    if ((!isAnd && !isOr) || !subpredicates.count) {
+        // Empty `and` predicates match everything, empty `or` and unknown predicates match nothing
+        [self emit:isAnd ? UAJSONCompiledOpcodeTrue : UAJSONCompiledOpcodeFalse];
+        return;
+    }
+
+    NSMutableArray<NSNumber *> *jumps = [NSMutableArray array];
+    for (NSUInteger i = 0; i < subpredicates.count; i++) {
+        [self compilePredicate:subpredicates[i]];
+
+        // Short circuit once the result is known
+        if (i < subpredicates.count - 1) {
+            [jumps addObject:@([self emit:isAnd ? UAJSONCompiledOpcodeJumpIfFalse : UAJSONCompiledOpcodeJumpIfTrue])];
+        }
+    }
+
+    [self patchTargets:jumps];
+}
+
+- (void)compileMatcher:(UAJSONMatcher *)matcher {
+    UAJSONValueMatcher *valueMatcher = matcher.valueMatcher;
+    if (!valueMatcher) {
+        [self emit:UAJSONCompiledOpcodeFalse];
+        return;
+    }
+
+    NSMutableArray<NSString *> *components = [NSMutableArray array];
+    if (matcher.scope) {
+        [components addObjectsFromArray:matcher.scope];
+    }
+
+    if (matcher.key) {
+        [components addObject:matcher.key];
+    }
+
+    [self emit:UAJSONCompiledOpcodeLoad operand:[self pathIndexForComponents:components] flag:NO constant:nil];
+
+    // Presence ignores any other value checks
+    if (valueMatcher.isPresent != nil) {
+        [self emit:UAJSONCompiledOpcodeIsPresent operand:0 flag:[valueMatcher.isPresent boolValue] constant:nil];
+        return;
+    }
+
+    NSMutableArray<NSNumber *> *checks = [NSMutableArray array];
+
+    if (valueMatcher.equals) {
+        NSUInteger index;
+        if (![matcher.ignoreCase boolValue]) {
+            index = [self emit:UAJSONCompiledOpcodeEquals operand:0 flag:NO constant:valueMatcher.equals];
+        } else if ([valueMatcher.equals isKindOfClass:[NSString class]]) {
+            index = [self emit:UAJSONCompiledOpcodeEqualsStringIgnoreCase operand:0 flag:NO constant:valueMatcher.equals];
+        } else {
+            index = [self emit:UAJSONCompiledOpcodeEqualsIgnoreCase operand:0 flag:NO constant:valueMatcher];
+        }
+
+        [checks addObject:@(index)];
+    }
+
+    if (valueMatcher.atLeast) {
+        [checks addObject:@([self emit:UAJSONCompiledOpcodeAtLeast operand:0 flag:NO constant:valueMatcher.atLeast])];
+    }
+
+    if (valueMatcher.atMost) {
+        [checks addObject:@([self emit:UAJSONCompiledOpcodeAtMost operand:0 flag:NO constant:valueMatcher.atMost])];
+    }
+
+    if (valueMatcher.versionMatcher) {
+        [checks addObject:@([self emit:UAJSONCompiledOpcodeVersion operand:0 flag:NO constant:valueMatcher.versionMatcher])];
+    }
+
+    if (valueMatcher.arrayPredicate) {
+        UAJSONCompiledPredicate *elementPredicate = [UAJSONCompiledPredicate compiledPredicateWithPredicate:valueMatcher.arrayPredicate];
+        NSUInteger index = [self emit:UAJSONCompiledOpcodeArrayContains
+                              operand:[valueMatcher.arrayIndex integerValue]
+                                 flag:valueMatcher.arrayIndex != nil
+                             constant:elementPredicate];
+        [checks addObject:@(index)];
+    }
+
+    [self emit:UAJSONCompiledOpcodeTrue];
+
+    // Failed checks skip past the true instruction
+    [self patchTargets:checks];
+}
+
+@end
@@ -9,6 +9,30 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @interface UAJSONMatcher ()
 
+///---------------------------------------------------------------------------------------
+/// @name JSON Matcher Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The key applied after the scope.
+ */
+@property (nonatomic, copy, nullable) NSString *key;
+
+/**
+ * The scope used to path into the object before evaluating the value.
+ */
+@property (nonatomic, copy, nullable) NSArray<NSString *> *scope;
+
+/**
+ * The value matcher.
+ */
+@property (nonatomic, strong) UAJSONValueMatcher *valueMatcher;
+
+/**
+ * Whether to ignore case when checking string values, or nil if unset.
+ */
+@property (nonatomic, copy, nullable) NSNumber *ignoreCase;
+
 ///---------------------------------------------------------------------------------------
 /// @name JSON Matcher Internal Methods
 ///---------------------------------------------------------------------------------------
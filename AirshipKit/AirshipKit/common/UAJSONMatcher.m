@@ -1,15 +1,8 @@
 /* Copyright Airship and Contributors */
 
-#import "UAJSONMatcher.h"
+#import "UAJSONMatcher+Internal.h"
 #import "UAJSONValueMatcher+Internal.h"
 
-@interface UAJSONMatcher()
-@property (nonatomic, copy) NSString *key;
-@property (nonatomic, copy) NSArray *scope;
-@property (nonatomic, strong) UAJSONValueMatcher *valueMatcher;
-@property (nonatomic, copy) NSNumber *ignoreCase;
-@end
-
 NSString *const UAJSONMatcherKey = @"key";
 NSString *const UAJSONMatcherScope = @"scope";
 NSString *const UAJSONMatcherValue = @"value";
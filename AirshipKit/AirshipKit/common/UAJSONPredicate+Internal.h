@@ -0,0 +1,48 @@
+/* Copyright Airship and Contributors */
+
+#import "UAJSONPredicate.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Represents the `and` predicate type.
+ */
+extern NSString *const UAJSONPredicateAndType;
+
+/**
+ * Represents the `or` predicate type.
+ */
+extern NSString *const UAJSONPredicateOrType;
+
+/**
+ * Represents the `not` predicate type.
+ */
+extern NSString *const UAJSONPredicateNotType;
+
+/*
+ * SDK-private extensions to UAJSONPredicate
+ */
+@interface UAJSONPredicate ()
+
+///---------------------------------------------------------------------------------------
+/// @name JSON Predicate Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The predicate type, or nil if the predicate wraps a JSON matcher.
+ */
+@property (nonatomic, copy, nullable) NSString *type;
+
+/**
+ * The subpredicates for `and`, `or` and `not` predicates.
+ */
+@property (nonatomic, copy, nullable) NSArray<UAJSONPredicate *> *subpredicates;
+
+/**
+ * The JSON matcher if the predicate does not have a type.
+ */
+@property (nonatomic, strong, nullable) UAJSONMatcher *jsonMatcher;
+
+@end
+
+NS_ASSUME_NONNULL_END
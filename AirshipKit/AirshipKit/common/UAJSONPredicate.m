@@ -1,14 +1,8 @@
 /* Copyright Airship and Contributors */
 
-#import "UAJSONPredicate.h"
+#import "UAJSONPredicate+Internal.h"
 #import "UAJSONMatcher.h"
 
-@interface UAJSONPredicate()
-@property (nonatomic, copy) NSString *type;
-@property (nonatomic, copy) NSArray *subpredicates;
-@property (nonatomic, strong) UAJSONMatcher *jsonMatcher;
-@end
-
 NSString *const UAJSONPredicateAndType = @"and";
 NSString *const UAJSONPredicateOrType = @"or";
 NSString *const UAJSONPredicateNotType = @"not";
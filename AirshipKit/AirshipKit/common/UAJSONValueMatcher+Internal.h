@@ -4,11 +4,53 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class UAVersionMatcher;
+@class UAJSONPredicate;
+
 /*
  * SDK-private extensions to UAJSONValueMatcher
  */
 @interface UAJSONValueMatcher ()
 
+///---------------------------------------------------------------------------------------
+/// @name JSON Value Matcher Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The minimum number value.
+ */
+@property(nonatomic, strong, nullable) NSNumber *atLeast;
+
+/**
+ * The maximum number value.
+ */
+@property(nonatomic, strong, nullable) NSNumber *atMost;
+
+/**
+ * Whether the value must be present, or nil if unset.
+ */
+@property(nonatomic, strong, nullable) NSNumber *isPresent;
+
+/**
+ * The value the object must equal.
+ */
+@property(nonatomic, copy, nullable) id equals;
+
+/**
+ * The version matcher.
+ */
+@property(nonatomic, strong, nullable) UAVersionMatcher *versionMatcher;
+
+/**
+ * The predicate applied to array elements.
+ */
+@property(nonatomic, strong, nullable) UAJSONPredicate *arrayPredicate;
+
+/**
+ * The array index the array predicate is applied to, or nil to match any element.
+ */
+@property(nonatomic, strong, nullable) NSNumber *arrayIndex;
+
 ///---------------------------------------------------------------------------------------
 /// @name JSON Value Matcher Internal Methods
 ///---------------------------------------------------------------------------------------
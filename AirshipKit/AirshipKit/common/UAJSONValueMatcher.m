@@ -6,14 +6,7 @@
 #import "UAJSONPredicate.h"
 
 @interface UAJSONValueMatcher ()
-@property(nonatomic, strong) NSNumber *atLeast;
-@property(nonatomic, strong) NSNumber *atMost;
-@property(nonatomic, assign) NSNumber *isPresent;
-@property(nonatomic, copy) id equals;
 @property(nonatomic, copy) NSString *versionConstraint;
-@property(nonatomic, strong) UAVersionMatcher *versionMatcher;
-@property(nonatomic, strong) UAJSONPredicate *arrayPredicate;
-@property(nonatomic, strong) NSNumber *arrayIndex;
 @end
 
 NSString *const UAJSONValueMatcherAtMost = @"at_most";
@@ -6,9 +6,13 @@
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- * A queue which serializes to a preference data store objects that conform to the
- * NSCoding protocol. Useful for sequentially feeding data to API clients, or other
- * queue-like operations that also require persistence.
+ * A persistent queue of objects that conform to the NSCoding protocol. Useful for
+ * sequentially feeding data to API clients, or other queue-like operations that also
+ * require persistence.
+ *
+ * Objects are stored in an append-only log file (see UAPersistentQueueLog), so adding
+ * and popping objects does not rewrite the whole queue. Queues previously stored in the
+ * preference data store are migrated to the log the first time it is opened.
  */
 @interface UAPersistentQueue : NSObject
 
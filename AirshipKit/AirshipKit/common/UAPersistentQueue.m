@@ -1,10 +1,21 @@
 /* Copyright Airship and Contributors */
 
 #import "UAPersistentQueue+Internal.h"
+#import "UAPersistentQueueLog+Internal.h"
+#import "UAUtils+Internal.h"
+#import "UAGlobal.h"
+
+static NSString * const UAPersistentQueueDirectory = @"com.urbanairship.persistent_queues";
+
+// Suffix for the data store key that marks the queue's log as in use
+static NSString * const UAPersistentQueueLogFileKeySuffix = @".log_file";
 
 @interface UAPersistentQueue ()
 @property (nonatomic, strong) UAPreferenceDataStore *dataStore;
 @property (nonatomic, copy) NSString *key;
+@property (nonatomic, copy) NSString *logFileKey;
+@property (nonatomic, copy) NSString *logFileName;
+@property (nonatomic, strong, nullable) UAPersistentQueueLog *log;
 @end
 
 @implementation UAPersistentQueue
@@ -15,34 +26,55 @@
     if (self) {
         self.dataStore = dataStore;
         self.key = key;
+        self.logFileKey = [key stringByAppendingString:UAPersistentQueueLogFileKeySuffix];
+
+        // The log file name is derived from the data store's prefixed queue key
+        NSString *hash = [UAUtils sha256HashWithString:[dataStore prefixKey:key]];
+        self.logFileName = [hash stringByAppendingPathExtension:@"log"];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(dataStoreDidRemoveAll)
+                                                     name:UAPreferenceDataStoreDidRemoveAllNotification
+                                                   object:dataStore];
     }
 
     return self;
 }
 
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
 + (instancetype)persistentQueueWithDataStore:(UAPreferenceDataStore *)dataStore key:(NSString *)key {
     return [[self alloc] initWithDataStore:dataStore key:key];
 }
 
 - (void)addObject:(id<NSCoding>)object {
-    @synchronized(self) {
-        NSMutableArray<id<NSCoding>> *objects = [[self objects] mutableCopy];
-        [objects addObject:object];
-        [self setObjects:objects];
-    }
+    [self addObjects:@[object]];
 }
 
 - (void)addObjects:(NSArray<id<NSCoding>> *)objects {
     @synchronized(self) {
-        NSArray<id<NSCoding>> *newObjects = [self objects];
+        UAPersistentQueueLog *log = [self queueLog];
+        if (log) {
+            [log appendObjects:objects];
+            return;
+        }
+
+        NSArray<id<NSCoding>> *newObjects = [self storedObjects];
         newObjects = [newObjects arrayByAddingObjectsFromArray:objects];
-        [self setObjects:newObjects];
+        [self storeObjects:newObjects];
     }
 }
 
 - (nullable id<NSCoding>)peekObject {
     @synchronized(self) {
-        NSArray<id<NSCoding>> *objects = [self objects];
+        UAPersistentQueueLog *log = [self queueLog];
+        if (log) {
+            return [log peekObject];
+        }
+
+        NSArray<id<NSCoding>> *objects = [self storedObjects];
 
         if (!objects.count) {
             return nil;
@@ -54,7 +86,12 @@
 
 - (nullable id<NSCoding>)popObject {
     @synchronized(self) {
-        NSMutableArray<id<NSCoding>> *objects = [[self objects] mutableCopy];
+        UAPersistentQueueLog *log = [self queueLog];
+        if (log) {
+            return [log popObject];
+        }
+
+        NSMutableArray<id<NSCoding>> *objects = [[self storedObjects] mutableCopy];
 
         if (!objects.count) {
             return nil;
@@ -64,9 +101,9 @@
         [objects removeObjectAtIndex:0];
 
         if (objects.count) {
-            [self setObjects:objects];
+            [self storeObjects:objects];
         } else {
-            [self clear];
+            [self.dataStore removeObjectForKey:self.key];
         }
 
         return object;
@@ -75,27 +112,139 @@
 
 - (NSArray<id<NSCoding>> *)objects {
     @synchronized(self) {
-        NSData *encodedItems = [self.dataStore objectForKey:self.key];
-
-        if (!encodedItems) {
-            return @[];
+        UAPersistentQueueLog *log = [self queueLog];
+        if (log) {
+            return [log objects];
         }
 
-        return [NSKeyedUnarchiver unarchiveObjectWithData:encodedItems];
+        return [self storedObjects];
     }
 }
 
 - (void)setObjects:(NSArray<id<NSCoding>> *)objects {
     @synchronized(self) {
-        NSData *encodedObjects = [NSKeyedArchiver archivedDataWithRootObject:objects];
-        [self.dataStore setObject:encodedObjects forKey:self.key];
+        UAPersistentQueueLog *log = [self queueLog];
+        if (log) {
+            [log setObjects:objects];
+            return;
+        }
+
+        [self storeObjects:objects];
     }
 }
 
 - (void)clear {
     @synchronized(self) {
+        UAPersistentQueueLog *log = [self queueLog];
+        if (log) {
+            [log clear];
+            return;
+        }
+
+        [self.dataStore removeObjectForKey:self.key];
+    }
+}
+
+#pragma mark -
+#pragma mark Log
+
+/**
+ * Drops the open log once the data store is reset, so the next operation reopens it and clears it.
+ */
+- (void)dataStoreDidRemoveAll {
+    @synchronized(self) {
+        self.log = nil;
+    }
+}
+
+/**
+ * Returns the queue's log, opening it on first use and migrating any objects stored in the data store.
+ *
+ * The data store keeps a marker for the log file. If the marker is missing when the log is opened, the
+ * data store was reset, so anything left in the log is stale and is cleared.
+ *
+ * @return The log, or nil if it is not available, e.g. the file is protected.
+ * The data store is used as a fallback until the log becomes available.
+ */
+- (nullable UAPersistentQueueLog *)queueLog {
+    if (self.log) {
+        return self.log;
+    }
+
+    NSString *fileKey = self.logFileKey;
+    NSString *fileName = self.logFileName;
+
+    NSString *directory = [self logDirectory];
+    if (!directory) {
+        return nil;
+    }
+
+    UAPersistentQueueLog *log = [UAPersistentQueueLog logWithPath:[directory stringByAppendingPathComponent:fileName]];
+    if (!log) {
+        return nil;
+    }
+
+    // Queues with the same key share the log, so only the first one to see the missing marker clears it
+    @synchronized([UAPersistentQueue class]) {
+        NSString *markedFileName = [self.dataStore stringForKey:fileKey];
+        if (![markedFileName isEqualToString:fileName]) {
+            // Remove a log left behind under a previous file name
+            if (markedFileName) {
+                [[NSFileManager defaultManager] removeItemAtPath:[directory stringByAppendingPathComponent:markedFileName] error:nil];
+            }
+
+            [log clear];
+            [self.dataStore setObject:fileName forKey:fileKey];
+        }
+    }
+
+    // One time migration from the data store
+    NSArray<id<NSCoding>> *storedObjects = [self storedObjects];
+    if (!storedObjects.count || [log appendObjects:storedObjects]) {
         [self.dataStore removeObjectForKey:self.key];
     }
+
+    self.log = log;
+    return log;
+}
+
+/**
+ * The log directory, created if needed.
+ */
+- (nullable NSString *)logDirectory {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSURL *libraryDirectoryURL = [[fileManager URLsForDirectory:NSLibraryDirectory inDomains:NSUserDomainMask] lastObject];
+    NSURL *directoryURL = [libraryDirectoryURL URLByAppendingPathComponent:UAPersistentQueueDirectory];
+
+    if (![fileManager fileExistsAtPath:directoryURL.path]) {
+        NSError *error;
+        if (![fileManager createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:&error]) {
+            UA_LERR(@"Unable to create persistent queue directory: %@", error);
+            return nil;
+        }
+
+        [UAUtils addSkipBackupAttributeToItemAtURL:directoryURL];
+    }
+
+    return directoryURL.path;
+}
+
+#pragma mark -
+#pragma mark Data store
+
+- (NSArray<id<NSCoding>> *)storedObjects {
+    NSData *encodedItems = [self.dataStore objectForKey:self.key];
+
+    if (!encodedItems) {
+        return @[];
+    }
+
+    return [NSKeyedUnarchiver unarchiveObjectWithData:encodedItems];
+}
+
+- (void)storeObjects:(NSArray<id<NSCoding>> *)objects {
+    NSData *encodedObjects = [NSKeyedArchiver archivedDataWithRootObject:objects];
+    [self.dataStore setObject:encodedObjects forKey:self.key];
 }
 
 @end
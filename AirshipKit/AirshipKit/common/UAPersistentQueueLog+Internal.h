@@ -0,0 +1,96 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * File backed, append-only log that stores the contents of a UAPersistentQueue.
+ *
+ * Objects are appended to the file as length prefixed archives. Popping an object only
+ * advances the head offset stored in the file header, and consumed records are dropped
+ * by compacting the file once they make up most of it. The decoded objects are mirrored
+ * in memory so peeking and reading the queue never touch the file.
+ */
+@interface UAPersistentQueueLog : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Persistent Queue Log Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The log file path.
+ */
+@property (nonatomic, readonly) NSString *path;
+
+/**
+ * The number of objects in the log.
+ */
+@property (readonly) NSUInteger count;
+
+///---------------------------------------------------------------------------------------
+/// @name Persistent Queue Log Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Returns the log for the given file. Logs are shared so every queue backed
+ * by the same file sees the same contents.
+ *
+ * @param path The log file path.
+ * @return The log, or `nil` if the file could not be opened.
+ */
++ (nullable instancetype)logWithPath:(NSString *)path;
+
+/**
+ * Opens a log. Prefer `logWithPath:`, which shares open logs.
+ *
+ * @param path The log file path.
+ * @return The log, or `nil` if the file could not be opened.
+ */
+- (nullable instancetype)initWithPath:(NSString *)path;
+
+/**
+ * Appends objects to the end of the log.
+ *
+ * @param objects The objects.
+ * @return `YES` if the objects were written, otherwise `NO`.
+ */
+- (BOOL)appendObjects:(NSArray<id<NSCoding>> *)objects;
+
+/**
+ * Returns the first object without removing it.
+ *
+ * @return The first object, or `nil` if the log is empty.
+ */
+- (nullable id<NSCoding>)peekObject;
+
+/**
+ * Removes the first object.
+ *
+ * @return The removed object, or `nil` if the log is empty.
+ */
+- (nullable id<NSCoding>)popObject;
+
+/**
+ * Returns all objects in the log.
+ *
+ * @return The objects.
+ */
+- (NSArray<id<NSCoding>> *)objects;
+
+/**
+ * Replaces the contents of the log.
+ *
+ * @param objects The objects.
+ * @return `YES` if the objects were written, otherwise `NO`.
+ */
+- (BOOL)setObjects:(NSArray<id<NSCoding>> *)objects;
+
+/**
+ * Removes all objects.
+ */
+- (void)clear;
+
+@end
+
+NS_ASSUME_NONNULL_END
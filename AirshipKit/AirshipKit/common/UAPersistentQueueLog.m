@@ -0,0 +1,376 @@
+/* Copyright Airship and Contributors */
+
+#import <fcntl.h>
+#import <unistd.h>
+#import <sys/stat.h>
+
+#import "UAPersistentQueueLog+Internal.h"
+#import "UAGlobal.h"
+
+// "UAPQ"
+static uint32_t const UAPersistentQueueLogMagic = 0x55415051;
+static uint32_t const UAPersistentQueueLogVersion = 1;
+
+// Consumed bytes needed before the log is compacted
+static off_t const UAPersistentQueueLogCompactionThreshold = 64 * 1024;
+
+/**
+ * Log file header. Records follow the header, each one a uint32 length followed by
+ * the archived object. Records before the head offset have been popped.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t head;
+} UAPersistentQueueLogHeader;
+
+static off_t const UAPersistentQueueLogHeaderSize = sizeof(UAPersistentQueueLogHeader);
+
+static BOOL UAPersistentQueueLogWrite(int fd, const void *bytes, size_t length, off_t offset) {
+    while (length > 0) {
+        ssize_t written = pwrite(fd, bytes, length, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return NO;
+        }
+
+        bytes = (const uint8_t *)bytes + written;
+        length -= (size_t)written;
+        offset += written;
+    }
+
+    return YES;
+}
+
+static BOOL UAPersistentQueueLogRead(int fd, void *bytes, size_t length, off_t offset) {
+    while (length > 0) {
+        ssize_t count = pread(fd, bytes, length, offset);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return NO;
+        }
+
+        if (count == 0) {
+            return NO;
+        }
+
+        bytes = (uint8_t *)bytes + count;
+        length -= (size_t)count;
+        offset += count;
+    }
+
+    return YES;
+}
+
+@interface UAPersistentQueueLog ()
+@property (nonatomic, copy) NSString *path;
+@property (nonatomic, assign) int fileDescriptor;
+@property (nonatomic, assign) off_t head;
+@property (nonatomic, assign) off_t length;
+@property (nonatomic, strong) NSMutableArray<id<NSCoding>> *entries;
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *recordSizes;
+@end
+
+@implementation UAPersistentQueueLog
+
++ (NSMapTable<NSString *, UAPersistentQueueLog *> *)openLogs {
+    static NSMapTable *logs;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        logs = [NSMapTable strongToWeakObjectsMapTable];
+    });
+    return logs;
+}
+
++ (instancetype)logWithPath:(NSString *)path {
+    NSMapTable<NSString *, UAPersistentQueueLog *> *logs = [self openLogs];
+
+    @synchronized (logs) {
+        UAPersistentQueueLog *log = [logs objectForKey:path];
+        if (!log) {
+            log = [[self alloc] initWithPath:path];
+            if (log) {
+                [logs setObject:log forKey:path];
+            }
+        }
+        return log;
+    }
+}
+
+- (instancetype)initWithPath:(NSString *)path {
+    self = [super init];
+
+    if (self) {
+        self.path = path;
+        self.entries = [NSMutableArray array];
+        self.recordSizes = [NSMutableArray array];
+        self.fileDescriptor = open(path.fileSystemRepresentation, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+
+        if (self.fileDescriptor < 0) {
+            UA_LERR(@"Unable to open persistent queue log %@: %s", path, strerror(errno));
+            return nil;
+        }
+
+        [self load];
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    if (_fileDescriptor >= 0) {
+        close(_fileDescriptor);
+    }
+}
+
+- (NSUInteger)count {
+    @synchronized (self) {
+        return self.entries.count;
+    }
+}
+
+- (BOOL)appendObjects:(NSArray<id<NSCoding>> *)objects {
+    @synchronized (self) {
+        NSMutableArray<NSNumber *> *recordSizes = [NSMutableArray arrayWithCapacity:objects.count];
+        NSData *records = [self recordsWithObjects:objects recordSizes:recordSizes];
+
+        if (!records.length) {
+            return YES;
+        }
+
+        if (!UAPersistentQueueLogWrite(self.fileDescriptor, records.bytes, records.length, self.length)) {
+            UA_LERR(@"Unable to write persistent queue log %@: %s", self.path, strerror(errno));
+            ftruncate(self.fileDescriptor, self.length);
+            return NO;
+        }
+
+        self.length += records.length;
+        [self.entries addObjectsFromArray:objects];
+        [self.recordSizes addObjectsFromArray:recordSizes];
+        return YES;
+    }
+}
+
+- (id<NSCoding>)peekObject {
+    @synchronized (self) {
+        return self.entries.firstObject;
+    }
+}
+
+- (id<NSCoding>)popObject {
+    @synchronized (self) {
+        if (!self.entries.count) {
+            return nil;
+        }
+
+        id<NSCoding> object = self.entries.firstObject;
+        off_t head = self.head + self.recordSizes.firstObject.longLongValue;
+
+        [self.entries removeObjectAtIndex:0];
+        [self.recordSizes removeObjectAtIndex:0];
+
+        if (!self.entries.count) {
+            [self reset];
+            return object;
+        }
+
+        self.head = head;
+        [self writeHeader];
+
+        // Drop the consumed records once they make up most of the file
+        off_t consumed = self.head - UAPersistentQueueLogHeaderSize;
+        if (consumed >= UAPersistentQueueLogCompactionThreshold && consumed >= self.length - self.head) {
+            [self compact];
+        }
+
+        return object;
+    }
+}
+
+- (NSArray<id<NSCoding>> *)objects {
+    @synchronized (self) {
+        return [self.entries copy];
+    }
+}
+
+- (BOOL)setObjects:(NSArray<id<NSCoding>> *)objects {
+    @synchronized (self) {
+        NSMutableArray<NSNumber *> *recordSizes = [NSMutableArray arrayWithCapacity:objects.count];
+        NSData *records = [self recordsWithObjects:objects recordSizes:recordSizes];
+
+        if (![self replaceFileWithRecords:records]) {
+            return NO;
+        }
+
+        self.entries = [objects mutableCopy];
+        self.recordSizes = recordSizes;
+        return YES;
+    }
+}
+
+- (void)clear {
+    @synchronized (self) {
+        [self reset];
+    }
+}
+
+#pragma mark -
+#pragma mark File
+
+- (void)load {
+    struct stat info;
+    if (fstat(self.fileDescriptor, &info) != 0 || info.st_size < UAPersistentQueueLogHeaderSize) {
+        [self reset];
+        return;
+    }
+
+    NSMutableData *contents = [NSMutableData dataWithLength:(NSUInteger)info.st_size];
+    if (!UAPersistentQueueLogRead(self.fileDescriptor, contents.mutableBytes, contents.length, 0)) {
+        UA_LERR(@"Unable to read persistent queue log %@: %s", self.path, strerror(errno));
+        [self reset];
+        return;
+    }
+
+    const uint8_t *bytes = contents.bytes;
+    off_t fileLength = (off_t)contents.length;
+
+    UAPersistentQueueLogHeader header;
+    memcpy(&header, bytes, sizeof(header));
+
+    if (header.magic != UAPersistentQueueLogMagic ||
+        header.version != UAPersistentQueueLogVersion ||
+        header.head < (uint64_t)UAPersistentQueueLogHeaderSize ||
+        header.head > (uint64_t)fileLength) {
+        UA_LERR(@"Invalid persistent queue log %@, resetting", self.path);
+        [self reset];
+        return;
+    }
+
+    BOOL needsRewrite = NO;
+    off_t offset = (off_t)header.head;
+
+    while (offset + (off_t)sizeof(uint32_t) <= fileLength) {
+        uint32_t size;
+        memcpy(&size, bytes + offset, sizeof(size));
+
+        off_t recordSize = (off_t)sizeof(uint32_t) + size;
+
+        // Incomplete record from an interrupted write
+        if (offset + recordSize > fileLength) {
+            break;
+        }
+
+        NSData *archive = [NSData dataWithBytesNoCopy:(void *)(bytes + offset + sizeof(uint32_t)) length:size freeWhenDone:NO];
+        id object = [NSKeyedUnarchiver unarchiveObjectWithData:archive];
+
+        if (object) {
+            [self.entries addObject:object];
+            [self.recordSizes addObject:@(recordSize)];
+        } else {
+            UA_LERR(@"Unable to decode persistent queue record in %@", self.path);
+            needsRewrite = YES;
+        }
+
+        offset += recordSize;
+    }
+
+    self.head = (off_t)header.head;
+    self.length = offset;
+
+    if (offset != fileLength) {
+        ftruncate(self.fileDescriptor, offset);
+    }
+
+    if (needsRewrite) {
+        [self setObjects:self.entries];
+    } else if (!self.entries.count && self.head != UAPersistentQueueLogHeaderSize) {
+        [self reset];
+    }
+}
+
+- (void)reset {
+    [self.entries removeAllObjects];
+    [self.recordSizes removeAllObjects];
+
+    self.head = UAPersistentQueueLogHeaderSize;
+    self.length = UAPersistentQueueLogHeaderSize;
+
+    ftruncate(self.fileDescriptor, 0);
+    [self writeHeader];
+}
+
+- (void)writeHeader {
+    UAPersistentQueueLogHeader header;
+    header.magic = UAPersistentQueueLogMagic;
+    header.version = UAPersistentQueueLogVersion;
+    header.head = (uint64_t)self.head;
+
+    if (!UAPersistentQueueLogWrite(self.fileDescriptor, &header, sizeof(header), 0)) {
+        UA_LERR(@"Unable to write persistent queue log header %@: %s", self.path, strerror(errno));
+    }
+}
+
+- (void)compact {
+    size_t liveLength = (size_t)(self.length - self.head);
+    NSMutableData *records = [NSMutableData dataWithLength:liveLength];
+
+    if (!UAPersistentQueueLogRead(self.fileDescriptor, records.mutableBytes, liveLength, self.head)) {
+        UA_LERR(@"Unable to compact persistent queue log %@: %s", self.path, strerror(errno));
+        return;
+    }
+
+    [self replaceFileWithRecords:records];
+}
+
+/**
+ * Atomically replaces the log file with a new header and the given records.
+ */
+- (BOOL)replaceFileWithRecords:(NSData *)records {
+    UAPersistentQueueLogHeader header;
+    header.magic = UAPersistentQueueLogMagic;
+    header.version = UAPersistentQueueLogVersion;
+    header.head = (uint64_t)UAPersistentQueueLogHeaderSize;
+
+    NSMutableData *contents = [NSMutableData dataWithCapacity:sizeof(header) + records.length];
+    [contents appendBytes:&header length:sizeof(header)];
+    [contents appendData:records];
+
+    NSError *error;
+    if (![contents writeToFile:self.path options:NSDataWritingAtomic error:&error]) {
+        UA_LERR(@"Unable to write persistent queue log %@: %@", self.path, error);
+        return NO;
+    }
+
+    int fileDescriptor = open(self.path.fileSystemRepresentation, O_RDWR, S_IRUSR | S_IWUSR);
+    if (fileDescriptor < 0) {
+        UA_LERR(@"Unable to reopen persistent queue log %@: %s", self.path, strerror(errno));
+        return NO;
+    }
+
+    close(self.fileDescriptor);
+    self.fileDescriptor = fileDescriptor;
+    self.head = UAPersistentQueueLogHeaderSize;
+    self.length = (off_t)contents.length;
+    return YES;
+}
+
+- (NSData *)recordsWithObjects:(NSArray<id<NSCoding>> *)objects recordSizes:(NSMutableArray<NSNumber *> *)recordSizes {
+    NSMutableData *records = [NSMutableData data];
+
+    for (id<NSCoding> object in objects) {
+        NSData *archive = [NSKeyedArchiver archivedDataWithRootObject:object];
+        uint32_t size = (uint32_t)archive.length;
+
+        [records appendBytes:&size length:sizeof(size)];
+        [records appendData:archive];
+        [recordSizes addObject:@(sizeof(size) + archive.length)];
+    }
+
+    return records;
+}
+
+@end
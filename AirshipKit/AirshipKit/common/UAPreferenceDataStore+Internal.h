@@ -5,6 +5,11 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * Posted after `removeAll` removes the data store's keys. The notification object is the data store.
+ */
+extern NSString * const UAPreferenceDataStoreDidRemoveAllNotification;
+
 @interface UAPreferenceDataStore ()
 
 ///---------------------------------------------------------------------------------------
@@ -23,6 +28,35 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)migrateUnprefixedKeys:(NSArray *)keys;
 
+/**
+ * Returns the archived object associated with the key. The unarchived object is
+ * cached, so repeated reads do not decode the archive again.
+ * @param objectClass The expected class of the object.
+ * @param key The preference key.
+ * @return The object, or `nil` if the key does not exist or the object is not of the expected class.
+ */
+- (nullable id)unarchivedObjectOfClass:(Class)objectClass forKey:(NSString *)key;
+
+/**
+ * Archives and stores an object.
+ * @param object The object, or `nil` to remove the value.
+ * @param key The preference key.
+ */
+- (void)setArchivedObject:(nullable id<NSCoding>)object forKey:(NSString *)key;
+
+/**
+ * Returns the key with the data store's key prefix applied.
+ * @param key The preference key.
+ * @return The prefixed key.
+ */
+- (NSString *)prefixKey:(NSString *)key;
+
+/**
+ * Writes any pending values to NSUserDefaults. Values are cached in memory and
+ * written after a short delay, or when the application enters the background.
+ */
++ (void)flushPendingWrites;
+
 NS_ASSUME_NONNULL_END
 
 @end
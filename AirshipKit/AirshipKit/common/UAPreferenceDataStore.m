@@ -1,10 +1,88 @@
 /* Copyright Airship and Contributors */
 
+#import <UIKit/UIKit.h>
+
 #import "UAPreferenceDataStore+Internal.h"
+#import "UADispatcher+Internal.h"
+
+NSString * const UAPreferenceDataStoreDidRemoveAllNotification = @"com.urbanairship.preference_data_store.did_remove_all";
+
+// Delay before pending writes are flushed to NSUserDefaults
+static NSTimeInterval const UAPreferenceDataStoreFlushDelay = 1.0;
+
+/**
+ * Values shared by every data store, keyed by prefixed key. Data stores with the same
+ * prefix see the same values, and writes are held here until they are flushed.
+ */
+@interface UAPreferenceDataStoreCache : NSObject
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *values;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *pendingWrites;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, id> *unarchivedObjects;
+@property (nonatomic, assign) BOOL flushScheduled;
+@end
+
+@implementation UAPreferenceDataStoreCache
+
++ (instancetype)sharedCache {
+    static UAPreferenceDataStoreCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[UAPreferenceDataStoreCache alloc] init];
+    });
+    return cache;
+}
+
+- (instancetype)init {
+    self = [super init];
+
+    if (self) {
+        self.values = [NSMutableDictionary dictionary];
+        self.pendingWrites = [NSMutableDictionary dictionary];
+        self.unarchivedObjects = [NSMutableDictionary dictionary];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(flush)
+                                                     name:UIApplicationDidEnterBackgroundNotification
+                                                   object:nil];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(flush)
+                                                     name:UIApplicationWillTerminateNotification
+                                                   object:nil];
+    }
+
+    return self;
+}
+
+- (void)flush {
+    @synchronized (self) {
+        self.flushScheduled = NO;
+
+        if (!self.pendingWrites.count) {
+            return;
+        }
+
+        NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+        for (NSString *key in self.pendingWrites) {
+            id value = self.pendingWrites[key];
+            if (value == [NSNull null]) {
+                [defaults removeObjectForKey:key];
+            } else {
+                [defaults setObject:value forKey:key];
+            }
+        }
+
+        [self.pendingWrites removeAllObjects];
+    }
+}
+
+@end
 
 @interface UAPreferenceDataStore()
 @property (nonatomic, strong) NSUserDefaults *defaults;
 @property (nonatomic, copy) NSString *keyPrefix;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSString *> *prefixedKeys;
+@property (nonatomic, strong) UAPreferenceDataStoreCache *cache;
 @end
 
 
@@ -14,23 +92,86 @@
     UAPreferenceDataStore *dataStore = [[UAPreferenceDataStore alloc] init];
     dataStore.defaults = [NSUserDefaults standardUserDefaults];
     dataStore.keyPrefix = keyPrefix;
+    dataStore.prefixedKeys = [NSMutableDictionary dictionary];
+    dataStore.cache = [UAPreferenceDataStoreCache sharedCache];
     return dataStore;
 }
 
++ (void)flushPendingWrites {
+    [[UAPreferenceDataStoreCache sharedCache] flush];
+}
+
 - (NSString *)prefixKey:(nonnull NSString *)key {
-    return [self.keyPrefix stringByAppendingString:key];
+    @synchronized (self.prefixedKeys) {
+        NSString *prefixedKey = self.prefixedKeys[key];
+        if (!prefixedKey) {
+            prefixedKey = [self.keyPrefix stringByAppendingString:key];
+            self.prefixedKeys[[key copy]] = prefixedKey;
+        }
+        return prefixedKey;
+    }
 }
 
-- (id)valueForKey:(NSString *)key {
-    return [self.defaults valueForKey:[self prefixKey:key]];
+#pragma mark -
+#pragma mark Cache
+
+- (id)cachedObjectForKey:(NSString *)key {
+    NSString *prefixedKey = [self prefixKey:key];
+    UAPreferenceDataStoreCache *cache = self.cache;
+
+    @synchronized (cache) {
+        id value = cache.values[prefixedKey];
+        if (!value) {
+            value = [self.defaults objectForKey:prefixedKey] ?: [NSNull null];
+            cache.values[prefixedKey] = value;
+        }
+
+        return value == [NSNull null] ? nil : value;
+    }
 }
 
-- (void)setValue:(id)value forKey:(NSString *)key {
-    [self.defaults setValue:value forKey:[self prefixKey:key]];
+- (void)cacheObject:(id)value forKey:(NSString *)key {
+    NSString *prefixedKey = [self prefixKey:key];
+    UAPreferenceDataStoreCache *cache = self.cache;
+
+    // NSUserDefaults copies values when they are set, so mutating the original afterwards has no effect
+    id storedValue = [value conformsToProtocol:@protocol(NSCopying)] ? [value copy] : value;
+    storedValue = storedValue ?: [NSNull null];
+
+    @synchronized (cache) {
+        cache.values[prefixedKey] = storedValue;
+        cache.pendingWrites[prefixedKey] = storedValue;
+        [cache.unarchivedObjects removeObjectForKey:prefixedKey];
+
+        if (!cache.flushScheduled) {
+            cache.flushScheduled = YES;
+            [[UADispatcher backgroundDispatcher] dispatchAfter:UAPreferenceDataStoreFlushDelay block:^{
+                [cache flush];
+            }];
+        }
+    }
 }
 
-- (void)removeObjectForKey:(NSString *)key {
-    [self.defaults removeObjectForKey:[self prefixKey:key]];
+/**
+ * Drops the cached value for a key that is about to be read or written directly through NSUserDefaults.
+ */
+- (void)invalidateKey:(NSString *)key {
+    NSString *prefixedKey = [self prefixKey:key];
+    UAPreferenceDataStoreCache *cache = self.cache;
+
+    [cache flush];
+
+    @synchronized (cache) {
+        [cache.values removeObjectForKey:prefixedKey];
+        [cache.unarchivedObjects removeObjectForKey:prefixedKey];
+    }
+}
+
+#pragma mark -
+#pragma mark Getters
+
+- (id)valueForKey:(NSString *)key {
+    return [self cachedObjectForKey:key];
 }
 
 - (BOOL)keyExists:(NSString *)key {
@@ -38,39 +179,70 @@
 }
 
 - (id)objectForKey:(NSString *)key {
-    return [self.defaults objectForKey:[self prefixKey:key]];
+    return [self cachedObjectForKey:key];
 }
 
 - (NSString *)stringForKey:(NSString *)key {
-    return [self.defaults stringForKey:[self prefixKey:key]];
+    id value = [self cachedObjectForKey:key];
+    if ([value isKindOfClass:[NSString class]]) {
+        return value;
+    }
+
+    if ([value isKindOfClass:[NSNumber class]]) {
+        return [value stringValue];
+    }
+
+    return nil;
 }
 
 - (NSArray *)arrayForKey:(NSString *)key {
-    return [self.defaults arrayForKey:[self prefixKey:key]];
+    id value = [self cachedObjectForKey:key];
+    return [value isKindOfClass:[NSArray class]] ? value : nil;
 }
 
 - (NSDictionary *)dictionaryForKey:(NSString *)key {
-    return [self.defaults dictionaryForKey:[self prefixKey:key]];
+    id value = [self cachedObjectForKey:key];
+    return [value isKindOfClass:[NSDictionary class]] ? value : nil;
 }
 
 - (NSData *)dataForKey:(NSString *)key {
-    return [self.defaults dataForKey:[self prefixKey:key]];
+    id value = [self cachedObjectForKey:key];
+    return [value isKindOfClass:[NSData class]] ? value : nil;
 }
 
 - (NSArray *)stringArrayForKey:(NSString *)key {
-    return [self.defaults stringArrayForKey:[self prefixKey:key]];
+    NSArray *array = [self arrayForKey:key];
+    for (id value in array) {
+        if (![value isKindOfClass:[NSString class]]) {
+            return nil;
+        }
+    }
+
+    return array;
+}
+
+/**
+ * Returns the value if NSUserDefaults would convert it to a number, otherwise nil.
+ */
+- (id)scalarForKey:(NSString *)key {
+    id value = [self cachedObjectForKey:key];
+    if ([value isKindOfClass:[NSNumber class]] || [value isKindOfClass:[NSString class]]) {
+        return value;
+    }
+
+    return nil;
 }
 
 - (NSInteger)integerForKey:(NSString *)key {
-    return [self.defaults integerForKey:[self prefixKey:key]];
+    return [[self scalarForKey:key] integerValue];
 }
 
 - (float)floatForKey:(NSString *)key {
-    return [self.defaults floatForKey:[self prefixKey:key]];
+    return [[self scalarForKey:key] floatValue];
 }
 
 - (double)doubleForKey:(NSString *)key {
-    return [self.defaults doubleForKey:[self prefixKey:key]];
+    return [[self scalarForKey:key] doubleValue];
 }
 
 - (double)doubleForKey:(NSString *)key defaultValue:(double)defaultValue {
@@ -82,7 +254,7 @@
 }
 
 - (BOOL)boolForKey:(NSString *)key {
-    return [self.defaults boolForKey:[self prefixKey:key]];
+    return [[self scalarForKey:key] boolValue];
 }
 
 - (BOOL)boolForKey:(NSString *)key defaultValue:(BOOL)defaultValue {
@@ -94,38 +266,85 @@
 }
 
 - (NSURL *)URLForKey:(NSString *)key {
+    // URLs are archived by NSUserDefaults, so they are read directly
+    [self.cache flush];
     return [self.defaults URLForKey:[self prefixKey:key]];
 }
 
+- (id)unarchivedObjectOfClass:(Class)objectClass forKey:(NSString *)key {
+    NSString *prefixedKey = [self prefixKey:key];
+    UAPreferenceDataStoreCache *cache = self.cache;
+
+    @synchronized (cache) {
+        id object = cache.unarchivedObjects[prefixedKey];
+
+        if (!object) {
+            NSData *data = [self dataForKey:key];
+            object = data ? [NSKeyedUnarchiver unarchiveObjectWithData:data] : nil;
+            cache.unarchivedObjects[prefixedKey] = object ?: [NSNull null];
+        }
+
+        return [object isKindOfClass:objectClass] ? object : nil;
+    }
+}
+
+#pragma mark -
+#pragma mark Setters
+
+- (void)setValue:(id)value forKey:(NSString *)key {
+    [self cacheObject:value forKey:key];
+}
+
+- (void)removeObjectForKey:(NSString *)key {
+    [self cacheObject:nil forKey:key];
+}
+
 - (void)setInteger:(NSInteger)value forKey:(NSString *)key {
-    [self.defaults setInteger:value forKey:[self prefixKey:key]];
+    [self cacheObject:@(value) forKey:key];
 }
 
 - (void)setFloat:(float)value forKey:(NSString *)key {
-    [self.defaults setFloat:value forKey:[self prefixKey:key]];
+    [self cacheObject:@(value) forKey:key];
 }
 
 - (void)setDouble:(double)value forKey:(NSString *)key {
-    [self.defaults setDouble:value forKey:[self prefixKey:key]];
+    [self cacheObject:@(value) forKey:key];
 }
 
 - (void)setBool:(BOOL)value forKey:(NSString *)key {
-    [self.defaults setBool:value forKey:[self prefixKey:key]];
+    [self cacheObject:@(value) forKey:key];
 }
 
 - (void)setURL:(NSURL *)value forKey:(NSString *)key {
+    [self invalidateKey:key];
     [self.defaults setURL:value forKey:[self prefixKey:key]];
 }
 
 - (void)setObject:(id)value forKey:(NSString *)key {
-    [self.defaults setObject:value forKey:[self prefixKey:key]];
+    [self cacheObject:value forKey:key];
+}
+
+- (void)setArchivedObject:(id<NSCoding>)object forKey:(NSString *)key {
+    NSData *data = object ? [NSKeyedArchiver archivedDataWithRootObject:object] : nil;
+    [self cacheObject:data forKey:key];
+
+    if (object) {
+        UAPreferenceDataStoreCache *cache = self.cache;
+        @synchronized (cache) {
+            cache.unarchivedObjects[[self prefixKey:key]] = object;
+        }
+    }
 }
 
+#pragma mark -
+#pragma mark Maintenance
+
 - (void)migrateUnprefixedKeys:(NSArray *)keys {
-    
+
     for (NSString *key in keys) {
         id value = [self.defaults objectForKey:key];
         if (value) {
+            [self invalidateKey:key];
             [self.defaults setValue:value forKey:[self prefixKey:key]];
             [self.defaults removeObjectForKey:key];
         }
@@ -133,12 +352,30 @@
 }
 
 - (void)removeAll {
-    for (NSString *key in [[self.defaults dictionaryRepresentation] allKeys]) {
-        if ([key hasPrefix:self.keyPrefix]) {
-            [self.defaults removeObjectForKey:key];
+    UAPreferenceDataStoreCache *cache = self.cache;
+
+    @synchronized (cache) {
+        for (NSMutableDictionary *entries in @[cache.values, cache.pendingWrites, cache.unarchivedObjects]) {
+            NSMutableArray *keys = [NSMutableArray array];
+            for (NSString *key in entries) {
+                if ([key hasPrefix:self.keyPrefix]) {
+                    [keys addObject:key];
+                }
+            }
+
+            [entries removeObjectsForKeys:keys];
+        }
+
+        for (NSString *key in [[self.defaults dictionaryRepresentation] allKeys]) {
+            if ([key hasPrefix:self.keyPrefix]) {
+                [self.defaults removeObjectForKey:key];
+            }
         }
     }
+
     [self.defaults synchronize];
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:UAPreferenceDataStoreDidRemoveAllNotification object:self];
 }
 
 @end
@@ -32,7 +32,7 @@ NSString * const kUALastRemoteDataModifiedTime = @"UALastRemoteDataModifiedTime"
 + (UARemoteDataAPIClient *)clientWithConfig:(UARuntimeConfig *)config dataStore:(UAPreferenceDataStore *)dataStore {
     return [[self alloc] initWithConfig:config
                               dataStore:dataStore
-                                session:[UARequestSession sessionWithConfig:config]];
+                                session:[UARequestSession sessionWithConfig:config priority:UARequestPriorityRemoteData]];
 }
 
 + (UARemoteDataAPIClient *)clientWithConfig:(UARuntimeConfig *)config
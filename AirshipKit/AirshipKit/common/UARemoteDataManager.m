@@ -260,7 +260,7 @@ completionHandler:(void(^)(BOOL success))completionHandler {
     NSArray<UARemoteDataPayload *> *payloads = [UARemoteDataPayload remoteDataPayloadsFromJSON:remoteData metadata:metadata];
 
     UA_WEAKIFY(self);
-    [self.remoteDataStore overwriteCachedRemoteDataWithResponse:payloads completionHandler:^(BOOL success) {
+    [self.remoteDataStore updateCachedRemoteDataWithResponse:payloads completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
         UA_STRONGIFY(self);
         if (!success) {
             [self.remoteDataAPIClient clearLastModifiedTime];
@@ -274,7 +274,7 @@ completionHandler:(void(^)(BOOL success))completionHandler {
         self.lastMetadata = metadata;
 
         // notify remote data subscribers
-        [self notifySubscribersWithRemoteData:payloads completionHandler:^{
+        [self notifySubscribersWithRemoteData:payloads changedTypes:changedTypes completionHandler:^{
             if (completionHandler) {
                 completionHandler(YES);
             }
@@ -346,23 +346,36 @@ completionHandler:(void(^)(BOOL success))completionHandler {
 }
 
 /**
- * Notifies all subscriptions of new remote data
+ * Notifies the subscriptions to any of the changed payload types of new remote data.
  *
  * @param remoteDataPayloads Remote data from which to notify subscribers. Data must be filtered for each subscriber.
+ * @param changedTypes The payload types that changed.
  * @param completionHandler Optional completion handler.
  */
-- (void)notifySubscribersWithRemoteData:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads completionHandler:(void (^)(void))completionHandler {
-    NSArray *subscriptions = [self.subscriptions copy];
+- (void)notifySubscribersWithRemoteData:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
+                           changedTypes:(NSSet<NSString *> *)changedTypes
+                      completionHandler:(void (^)(void))completionHandler {
+    NSArray *subscriptions;
+    @synchronized(self.subscriptions) {
+        subscriptions = [self.subscriptions copy];
+    }
 
     dispatch_group_t dispatchGroup = dispatch_group_create();
 
     // notify each subscription
     for (UARemoteDataSubscription *subscription in subscriptions) {
-        dispatch_group_enter(dispatchGroup);
+        if (![subscription.payloadTypes intersectsSet:changedTypes]) {
+            continue;
+        }
 
-        NSPredicate *predicate = [NSPredicate predicateWithFormat:@"(type IN %@)", subscription.payloadTypes];
-        NSArray *filteredPayloads = [remoteDataPayloads filteredArrayUsingPredicate:predicate];
+        NSMutableArray<UARemoteDataPayload *> *filteredPayloads = [NSMutableArray array];
+        for (UARemoteDataPayload *payload in remoteDataPayloads) {
+            if ([subscription.payloadTypes containsObject:payload.type]) {
+                [filteredPayloads addObject:payload];
+            }
+        }
 
+        dispatch_group_enter(dispatchGroup);
         [subscription notifyRemoteData:filteredPayloads dispatcher:self.dispatcher completionHandler:^{
             dispatch_group_leave(dispatchGroup);
         }];
@@ -38,14 +38,15 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)storeWithName:(NSString *)storeName;
 
 /**
- * Updates the remote data store with the array of remote data.
+ * Updates the remote data store with the array of remote data. Only payloads whose
+ * timestamp or metadata changed are written, and types missing from the response are removed.
  *
  * @param remoteDataPayloads An array of remote data as JSON
- * @param completionHandler The completion handler with the sync result.
+ * @param completionHandler The completion handler with the sync result and the payload types that changed.
  *
  */
-- (void)overwriteCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
-                 completionHandler:(void(^)(BOOL))completionHandler;
+- (void)updateCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
+                         completionHandler:(void(^)(BOOL success, NSSet<NSString *> *changedTypes))completionHandler;
 
 /**
  * Fetches remote data with a specified predicate on the background context.
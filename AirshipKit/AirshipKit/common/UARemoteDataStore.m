@@ -102,28 +102,105 @@
 
 }
 
-- (void)overwriteCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
-                 completionHandler:(void(^)(BOOL))completionHandler {
+- (void)updateCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
+                         completionHandler:(void(^)(BOOL, NSSet<NSString *> *))completionHandler {
     [self safePerformBlock:^(BOOL isSafe) {
         if (!isSafe) {
-            completionHandler(NO);
+            completionHandler(NO, [NSSet set]);
             return;
         }
-        
-        // Delete all stored remote data
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:kUARemoteDataDBEntityName];
-        NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:request];
+
         NSError *error;
-        [self.managedContext executeRequest:deleteRequest error:&error];
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:kUARemoteDataDBEntityName];
+        NSArray<UARemoteDataStorePayload *> *storedPayloads = [self.managedContext executeFetchRequest:request error:&error];
+
+        if (error) {
+            UA_LERR(@"Error executing fetch request: %@ with error: %@", request, error);
+            completionHandler(NO, [NSSet set]);
+            return;
+        }
+
+        NSMutableDictionary<NSString *, NSMutableArray<UARemoteDataStorePayload *> *> *storedPayloadsByType = [NSMutableDictionary dictionary];
+        for (UARemoteDataStorePayload *storedPayload in storedPayloads) {
+            NSString *type = storedPayload.type ?: @"";
+            if (!storedPayloadsByType[type]) {
+                storedPayloadsByType[type] = [NSMutableArray array];
+            }
+            [storedPayloadsByType[type] addObject:storedPayload];
+        }
 
+        NSMutableDictionary<NSString *, NSMutableArray<UARemoteDataPayload *> *> *payloadsByType = [NSMutableDictionary dictionary];
         for (UARemoteDataPayload *remoteDataPayload in remoteDataPayloads) {
-            [self addRemoteDataStorePayloadFromRemoteData:remoteDataPayload];
+            if (!payloadsByType[remoteDataPayload.type]) {
+                payloadsByType[remoteDataPayload.type] = [NSMutableArray array];
+            }
+            [payloadsByType[remoteDataPayload.type] addObject:remoteDataPayload];
         }
-        
-        completionHandler([self.managedContext safeSave]);
+
+        NSMutableSet<NSString *> *changedTypes = [NSMutableSet set];
+
+        for (NSString *type in payloadsByType) {
+            NSArray<UARemoteDataStorePayload *> *stored = storedPayloadsByType[type] ?: @[];
+            [storedPayloadsByType removeObjectForKey:type];
+
+            if ([self storedPayloads:stored matchPayloads:payloadsByType[type]]) {
+                continue;
+            }
+
+            // Rewrite only the changed type
+            for (UARemoteDataStorePayload *storedPayload in stored) {
+                [self.managedContext deleteObject:storedPayload];
+            }
+
+            for (UARemoteDataPayload *remoteDataPayload in payloadsByType[type]) {
+                [self addRemoteDataStorePayloadFromRemoteData:remoteDataPayload];
+            }
+
+            [changedTypes addObject:type];
+        }
+
+        // Remove any types that are no longer in the response
+        for (NSString *type in storedPayloadsByType) {
+            for (UARemoteDataStorePayload *storedPayload in storedPayloadsByType[type]) {
+                [self.managedContext deleteObject:storedPayload];
+            }
+            [changedTypes addObject:type];
+        }
+
+        if (!self.managedContext.hasChanges) {
+            completionHandler(YES, changedTypes);
+            return;
+        }
+
+        completionHandler([self.managedContext safeSave], changedTypes);
     }];
 }
 
+/**
+ * Checks if the stored payloads of a type match the new payloads of that type. The timestamp
+ * changes whenever the payload data changes, so the data itself is not compared.
+ */
+- (BOOL)storedPayloads:(NSArray<UARemoteDataStorePayload *> *)storedPayloads matchPayloads:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads {
+    if (storedPayloads.count != remoteDataPayloads.count) {
+        return NO;
+    }
+
+    NSMutableArray<UARemoteDataStorePayload *> *unmatched = [storedPayloads mutableCopy];
+    for (UARemoteDataPayload *remoteDataPayload in remoteDataPayloads) {
+        NSUInteger index = [unmatched indexOfObjectPassingTest:^BOOL(UARemoteDataStorePayload *storedPayload, NSUInteger idx, BOOL *stop) {
+            return [storedPayload.timestamp isEqualToDate:remoteDataPayload.timestamp] &&
+                   (storedPayload.metadata == remoteDataPayload.metadata || [storedPayload.metadata isEqualToDictionary:remoteDataPayload.metadata]);
+        }];
+
+        if (index == NSNotFound) {
+            return NO;
+        }
+
+        [unmatched removeObjectAtIndex:index];
+    }
+
+    return YES;
+}
 
 - (void)addRemoteDataStorePayloadFromRemoteData:(UARemoteDataPayload *)remoteDataPayload {
     // create the NSManagedObject
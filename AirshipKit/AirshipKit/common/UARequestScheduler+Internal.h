@@ -0,0 +1,90 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Request priority classes. When several requests are waiting, requests with a higher
+ * priority are started first, whatever their host.
+ */
+typedef NS_ENUM(NSInteger, UARequestPriority) {
+    /**
+     * Channel, named user, tag group and attribute registration.
+     */
+    UARequestPriorityRegistration,
+
+    /**
+     * Remote data, tag group lookups and the inbox.
+     */
+    UARequestPriorityRemoteData,
+
+    /**
+     * Analytics uploads.
+     */
+    UARequestPriorityAnalytics
+};
+
+/**
+ * The default maximum number of concurrent requests per host.
+ */
+extern NSUInteger const UARequestSchedulerDefaultMaxConcurrentRequestsPerHost;
+
+/**
+ * The default maximum number of concurrent requests across all hosts.
+ */
+extern NSUInteger const UARequestSchedulerDefaultMaxConcurrentRequests;
+
+/**
+ * Runs the request operations of every request session. Waiting requests are started in
+ * priority order across all hosts, within a total and a per host concurrency limit.
+ */
+@interface UARequestScheduler : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Request Scheduler Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * The shared request scheduler.
+ *
+ * @return The shared request scheduler.
+ */
++ (instancetype)sharedScheduler;
+
+/**
+ * Factory method.
+ *
+ * @param maxConcurrentRequestsPerHost The maximum number of concurrent requests per host.
+ * @return A request scheduler.
+ */
++ (instancetype)schedulerWithMaxConcurrentRequestsPerHost:(NSUInteger)maxConcurrentRequestsPerHost;
+
+/**
+ * Factory method.
+ *
+ * @param maxConcurrentRequests The maximum number of concurrent requests across all hosts.
+ * @param maxConcurrentRequestsPerHost The maximum number of concurrent requests per host.
+ * @return A request scheduler.
+ */
++ (instancetype)schedulerWithMaxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                      maxConcurrentRequestsPerHost:(NSUInteger)maxConcurrentRequestsPerHost;
+
+/**
+ * Schedules a request operation.
+ *
+ * @param operation The request operation.
+ * @param host The host of the request.
+ * @param priority The priority of the request.
+ */
+- (void)scheduleOperation:(NSOperation *)operation host:(nullable NSString *)host priority:(UARequestPriority)priority;
+
+/**
+ * Starts any waiting operations the limits allow. Waiting operations that were cancelled are
+ * removed without holding a slot. Call after cancelling scheduled operations.
+ */
+- (void)startPendingOperations;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,188 @@
+/* Copyright Airship and Contributors */
+
+#import "UARequestScheduler+Internal.h"
+
+// HTTP/2 multiplexes concurrent requests to a host over a single connection
+NSUInteger const UARequestSchedulerDefaultMaxConcurrentRequestsPerHost = 4;
+
+NSUInteger const UARequestSchedulerDefaultMaxConcurrentRequests = 8;
+
+/**
+ * A request operation waiting to be started.
+ */
+@interface UARequestSchedulerEntry : NSObject
+@property (nonatomic, strong) NSOperation *operation;
+@property (nonatomic, copy) NSString *host;
+@property (nonatomic, assign) UARequestPriority priority;
+@end
+
+@implementation UARequestSchedulerEntry
+@end
+
+@interface UARequestScheduler()
+@property (nonatomic, assign) NSUInteger maxConcurrentRequests;
+@property (nonatomic, assign) NSUInteger maxConcurrentRequestsPerHost;
+@property (nonatomic, strong) NSOperationQueue *queue;
+@property (nonatomic, strong) NSMutableArray<UARequestSchedulerEntry *> *pendingEntries;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *runningCounts;
+@property (nonatomic, assign) NSUInteger runningCount;
+@end
+
+@implementation UARequestScheduler
+
+- (instancetype)initWithMaxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                 maxConcurrentRequestsPerHost:(NSUInteger)maxConcurrentRequestsPerHost {
+    self = [super init];
+
+    if (self) {
+        self.maxConcurrentRequests = MAX(maxConcurrentRequests, 1);
+        self.maxConcurrentRequestsPerHost = MAX(maxConcurrentRequestsPerHost, 1);
+        self.pendingEntries = [NSMutableArray array];
+        self.runningCounts = [NSMutableDictionary dictionary];
+
+        // Concurrency is limited by the scheduler as requests are started
+        self.queue = [[NSOperationQueue alloc] init];
+        self.queue.name = @"com.urbanairship.request_scheduler";
+    }
+
+    return self;
+}
+
++ (instancetype)sharedScheduler {
+    static dispatch_once_t onceToken;
+    static UARequestScheduler *scheduler;
+    dispatch_once(&onceToken, ^{
+        scheduler = [self schedulerWithMaxConcurrentRequests:UARequestSchedulerDefaultMaxConcurrentRequests
+                                maxConcurrentRequestsPerHost:UARequestSchedulerDefaultMaxConcurrentRequestsPerHost];
+    });
+
+    return scheduler;
+}
+
++ (instancetype)schedulerWithMaxConcurrentRequestsPerHost:(NSUInteger)maxConcurrentRequestsPerHost {
+    return [[self alloc] initWithMaxConcurrentRequests:UARequestSchedulerDefaultMaxConcurrentRequests
+                          maxConcurrentRequestsPerHost:maxConcurrentRequestsPerHost];
+}
+
++ (instancetype)schedulerWithMaxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+                      maxConcurrentRequestsPerHost:(NSUInteger)maxConcurrentRequestsPerHost {
+    return [[self alloc] initWithMaxConcurrentRequests:maxConcurrentRequests
+                          maxConcurrentRequestsPerHost:maxConcurrentRequestsPerHost];
+}
+
+- (void)scheduleOperation:(NSOperation *)operation host:(NSString *)host priority:(UARequestPriority)priority {
+    switch (priority) {
+        case UARequestPriorityRegistration:
+            operation.queuePriority = NSOperationQueuePriorityVeryHigh;
+            operation.qualityOfService = NSQualityOfServiceUserInitiated;
+            break;
+        case UARequestPriorityRemoteData:
+            operation.queuePriority = NSOperationQueuePriorityNormal;
+            operation.qualityOfService = NSQualityOfServiceUtility;
+            break;
+        case UARequestPriorityAnalytics:
+            operation.queuePriority = NSOperationQueuePriorityLow;
+            operation.qualityOfService = NSQualityOfServiceUtility;
+            break;
+    }
+
+    UARequestSchedulerEntry *entry = [[UARequestSchedulerEntry alloc] init];
+    entry.operation = operation;
+    entry.host = host.lowercaseString ?: @"";
+    entry.priority = priority;
+
+    @synchronized (self) {
+        // Keep the pending entries in priority order, first in first out within a priority
+        NSUInteger index = self.pendingEntries.count;
+        while (index > 0 && self.pendingEntries[index - 1].priority > priority) {
+            index--;
+        }
+
+        [self.pendingEntries insertObject:entry atIndex:index];
+    }
+
+    [self startPendingOperations];
+}
+
+/**
+ * Starts waiting operations in priority order across all hosts, while the total and per host
+ * limits allow it. Operations that are waiting on a dependency are skipped until it finishes,
+ * so they never hold a slot. Cancelled operations are started right away without a slot, so
+ * they finish and release the operations that depend on them.
+ */
+- (void)startPendingOperations {
+    NSMutableArray<UARequestSchedulerEntry *> *startedEntries = [NSMutableArray array];
+    NSMutableArray<NSOperation *> *cancelledOperations = [NSMutableArray array];
+
+    @synchronized (self) {
+        for (UARequestSchedulerEntry *entry in [self.pendingEntries copy]) {
+            if (entry.operation.isCancelled) {
+                [self.pendingEntries removeObject:entry];
+                [cancelledOperations addObject:entry.operation];
+                continue;
+            }
+
+            if (self.runningCount >= self.maxConcurrentRequests) {
+                continue;
+            }
+
+            NSUInteger hostCount = [self.runningCounts[entry.host] unsignedIntegerValue];
+            if (hostCount >= self.maxConcurrentRequestsPerHost || [UARequestScheduler isWaitingOnDependencies:entry.operation]) {
+                continue;
+            }
+
+            self.runningCount++;
+            self.runningCounts[entry.host] = @(hostCount + 1);
+            [self.pendingEntries removeObject:entry];
+            [startedEntries addObject:entry];
+        }
+    }
+
+    for (UARequestSchedulerEntry *entry in startedEntries) {
+        NSOperation *finishOperation = [NSBlockOperation blockOperationWithBlock:^{
+            [self operationFinishedForHost:entry.host];
+        }];
+
+        [finishOperation addDependency:entry.operation];
+        [self.queue addOperations:@[entry.operation, finishOperation] waitUntilFinished:NO];
+    }
+
+    if (cancelledOperations.count) {
+        NSOperation *finishOperation = [NSBlockOperation blockOperationWithBlock:^{
+            [self startPendingOperations];
+        }];
+
+        for (NSOperation *operation in cancelledOperations) {
+            [finishOperation addDependency:operation];
+        }
+
+        [self.queue addOperations:[cancelledOperations arrayByAddingObject:finishOperation] waitUntilFinished:NO];
+    }
+}
+
++ (BOOL)isWaitingOnDependencies:(NSOperation *)operation {
+    if (operation.isCancelled) {
+        return NO;
+    }
+
+    for (NSOperation *dependency in operation.dependencies) {
+        if (!dependency.isFinished) {
+            return YES;
+        }
+    }
+
+    return NO;
+}
+
+- (void)operationFinishedForHost:(NSString *)host {
+    @synchronized (self) {
+        self.runningCount--;
+
+        NSUInteger hostCount = [self.runningCounts[host] unsignedIntegerValue] - 1;
+        self.runningCounts[host] = hostCount ? @(hostCount) : nil;
+    }
+
+    [self startPendingOperations];
+}
+
+@end
@@ -3,14 +3,24 @@
 #import <Foundation/Foundation.h>
 #import "UARequest+Internal.h"
 #import "UARuntimeConfig.h"
+#import "UARequestScheduler+Internal.h"
+
+@class UADispatcher;
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * The maximum number of times a request is retried before its completion handler is called
+ * with the last response.
+ */
+extern const NSUInteger UARequestSessionMaxRetries;
+
 typedef void (^UARequestCompletionHandler)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error);
 typedef BOOL (^UARequestRetryBlock)(NSData * _Nullable data, NSURLResponse * _Nullable response);
 
 /**
- * Request session used for running UARequests.
+ * Request session used for running UARequests. Requests from a session run one at a time and in order,
+ * on the shared request scheduler alongside the requests of other sessions.
  */
 @interface UARequestSession : NSObject
 
@@ -21,6 +31,14 @@ typedef BOOL (^UARequestRetryBlock)(NSData * _Nullable data, NSURLResponse * _Nu
  */
 + (instancetype)sessionWithConfig:(UARuntimeConfig *)config;
 
+/**
+ * UARequestSession factory method.
+ * @param config The UARuntimeConfig instance.
+ * @param priority The priority of the session's requests.
+ * @return A UARequestSession instance.
+ */
++ (instancetype)sessionWithConfig:(UARuntimeConfig *)config priority:(UARequestPriority)priority;
+
 /**
  * UARequestSession factory method.
  * @param config The UARuntimeConfig instance.
@@ -33,10 +51,16 @@ typedef BOOL (^UARequestRetryBlock)(NSData * _Nullable data, NSURLResponse * _Nu
  * UARequestSession factory method.
  * @param config The UARuntimeConfig instance.
  * @param session A NSURLSession instance.
- * @param queue A NSOperation to perform retries on.
+ * @param scheduler The scheduler that runs the requests.
+ * @param priority The priority of the session's requests.
+ * @param dispatcher The dispatcher used to wait before retrying requests.
  * @return A UARequestSession instance.
  */
-+ (instancetype)sessionWithConfig:(UARuntimeConfig *)config NSURLSession:(NSURLSession *)session queue:(NSOperationQueue *)queue;
++ (instancetype)sessionWithConfig:(UARuntimeConfig *)config
+                     NSURLSession:(NSURLSession *)session
+                        scheduler:(UARequestScheduler *)scheduler
+                         priority:(UARequestPriority)priority
+                       dispatcher:(UADispatcher *)dispatcher;
 
 /**
  * Sets a http request header for all requests.
@@ -60,7 +84,8 @@ typedef BOOL (^UARequestRetryBlock)(NSData * _Nullable data, NSURLResponse * _Nu
  *
  * @param request The UARequest to perform.
  * @param retryBlock An optional block that will be called before the completion handler to decide if the
- * request should be retried or not.
+ * request should be retried or not. Retries are delayed with jittered exponential backoff, and the completion
+ * handler is called with the last response once `UARequestSessionMaxRetries` retries have been made.
  * @param completionHandler A callback to be invoked once the request is completed.
  */
 - (void)dataTaskWithRequest:(UARequest *)request
@@ -3,28 +3,42 @@
 
 #import "UARequestSession+Internal.h"
 #import "UAURLRequestOperation+Internal.h"
-#import "UADelayOperation+Internal.h"
+#import "UADispatcher+Internal.h"
 #import "UARuntimeConfig.h"
 #import "UAirship.h"
 
 @interface UARequestSession()
 @property(nonatomic, strong) NSURLSession *session;
-@property(nonatomic, strong) NSOperationQueue *queue;
-@property(nonatomic, strong) NSMutableDictionary *headers;
+@property(nonatomic, strong) UARequestScheduler *scheduler;
+@property(nonatomic, assign) UARequestPriority priority;
+@property(nonatomic, strong) UADispatcher *dispatcher;
+@property(nonatomic, copy) NSDictionary<NSString *, NSString *> *headers;
+@property(nonatomic, strong) NSMutableSet<NSUUID *> *pendingRetries;
+@property(nonatomic, strong) NSHashTable<NSOperation *> *operations;
+@property(nonatomic, weak) NSOperation *lastOperation;
 @end
 
 const NSTimeInterval InitialDelay = 30;
 const NSTimeInterval MaxBackOff = 3000;
+const NSUInteger UARequestSessionMaxRetries = 10;
 
 @implementation UARequestSession
 
-- (instancetype)initWithConfig:(UARuntimeConfig *)config session:(NSURLSession *)session queue:(NSOperationQueue *)queue {
+- (instancetype)initWithConfig:(UARuntimeConfig *)config
+                       session:(NSURLSession *)session
+                     scheduler:(UARequestScheduler *)scheduler
+                      priority:(UARequestPriority)priority
+                    dispatcher:(UADispatcher *)dispatcher {
     self = [super init];
 
     if (self) {
-        self.headers = [NSMutableDictionary dictionary];
+        self.headers = @{};
+        self.pendingRetries = [NSMutableSet set];
+        self.operations = [NSHashTable weakObjectsHashTable];
         self.session = session;
-        self.queue = queue;
+        self.scheduler = scheduler;
+        self.priority = priority;
+        self.dispatcher = dispatcher;
 
         [self setValue:@"gzip;q=1.0, compress;q=0.5" forHeader:@"Accept-Encoding"];
         [self setValue:[UARequestSession userAgentWithAppKey:config.appKey] forHeader:@"User-Agent"];
@@ -33,8 +47,7 @@ const NSTimeInterval MaxBackOff = 3000;
     return self;
 }
 
-+ (instancetype)sessionWithConfig:(UARuntimeConfig *)config {
-
++ (NSURLSession *)sharedURLSession {
     static dispatch_once_t onceToken;
     static NSURLSession *_session;
     dispatch_once(&onceToken, ^{
@@ -48,28 +61,49 @@ const NSTimeInterval MaxBackOff = 3000;
         // Force min 1.2 even though our backend will always negotiate 1.2+
         sessionConfig.TLSMinimumSupportedProtocol = kTLSProtocol12;
 
+        // Matches the scheduler so queued requests can share a connection
+        sessionConfig.HTTPMaximumConnectionsPerHost = UARequestSchedulerDefaultMaxConcurrentRequestsPerHost;
+
         _session = [NSURLSession sessionWithConfiguration:sessionConfig delegate:nil delegateQueue:nil];
     });
 
-    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
-    queue.maxConcurrentOperationCount = 1;
+    return _session;
+}
 
-    return [[UARequestSession alloc] initWithConfig:config session:_session queue:queue];
++ (instancetype)sessionWithConfig:(UARuntimeConfig *)config {
+    return [self sessionWithConfig:config priority:UARequestPriorityRemoteData];
 }
 
-+ (instancetype)sessionWithConfig:(UARuntimeConfig *)config NSURLSession:(NSURLSession *)session {
-    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
-    queue.maxConcurrentOperationCount = 1;
++ (instancetype)sessionWithConfig:(UARuntimeConfig *)config priority:(UARequestPriority)priority {
+    return [self sessionWithConfig:config
+                      NSURLSession:[self sharedURLSession]
+                         scheduler:[UARequestScheduler sharedScheduler]
+                          priority:priority
+                        dispatcher:[UADispatcher backgroundDispatcher]];
+}
 
-    return [[UARequestSession alloc] initWithConfig:config session:session queue:queue];
++ (instancetype)sessionWithConfig:(UARuntimeConfig *)config NSURLSession:(NSURLSession *)session {
+    return [self sessionWithConfig:config
+                      NSURLSession:session
+                         scheduler:[UARequestScheduler sharedScheduler]
+                          priority:UARequestPriorityRemoteData
+                        dispatcher:[UADispatcher backgroundDispatcher]];
 }
 
-+ (instancetype)sessionWithConfig:(UARuntimeConfig *)config NSURLSession:(NSURLSession *)session queue:(NSOperationQueue *)queue {
-    return [[UARequestSession alloc] initWithConfig:config session:session queue:queue];
++ (instancetype)sessionWithConfig:(UARuntimeConfig *)config
+                     NSURLSession:(NSURLSession *)session
+                        scheduler:(UARequestScheduler *)scheduler
+                         priority:(UARequestPriority)priority
+                       dispatcher:(UADispatcher *)dispatcher {
+    return [[UARequestSession alloc] initWithConfig:config session:session scheduler:scheduler priority:priority dispatcher:dispatcher];
 }
 
 - (void)setValue:(id)value forHeader:(NSString *)field {
-    [self.headers setValue:value forKey:field];
+    @synchronized (self) {
+        NSMutableDictionary *headers = [self.headers mutableCopy];
+        [headers setValue:value forKey:field];
+        self.headers = headers;
+    }
 }
 
 - (void)dataTaskWithRequest:(UARequest *)request
@@ -89,8 +123,8 @@ const NSTimeInterval MaxBackOff = 3000;
     [urlRequest setHTTPBody:request.body];
 
     // Session Headers
-    for (NSString *key in self.headers) {
-        [urlRequest setValue:self.headers[key] forHTTPHeaderField:key];
+    @synchronized (self) {
+        urlRequest.allHTTPHeaderFields = self.headers;
     }
 
     // Request Headers
@@ -100,18 +134,51 @@ const NSTimeInterval MaxBackOff = 3000;
 
     NSOperation *operation = [self operationWithRequest:urlRequest
                                              retryDelay:InitialDelay
+                                       retriesRemaining:UARequestSessionMaxRetries
                                              retryWhere:retryBlock
                                       completionHandler:completionHandler];
 
-    [self.queue addOperation:operation];
+    [self scheduleOperation:operation host:request.URL.host];
 }
 
 - (void)cancelAllRequests {
-    [self.queue cancelAllOperations];
+    NSArray<NSOperation *> *operations;
+
+    @synchronized (self) {
+        [self.pendingRetries removeAllObjects];
+        operations = self.operations.allObjects;
+        [self.operations removeAllObjects];
+    }
+
+    for (NSOperation *operation in operations) {
+        [operation cancel];
+    }
+
+    // Free the cancelled operations that are still waiting for a slot
+    [self.scheduler startPendingOperations];
+}
+
+/**
+ * Schedules an operation after the session's previous operation, so requests from a session
+ * still run one at a time and in order.
+ */
+- (void)scheduleOperation:(NSOperation *)operation host:(NSString *)host {
+    @synchronized (self) {
+        NSOperation *lastOperation = self.lastOperation;
+        if (lastOperation && !lastOperation.isFinished) {
+            [operation addDependency:lastOperation];
+        }
+
+        self.lastOperation = operation;
+        [self.operations addObject:operation];
+    }
+
+    [self.scheduler scheduleOperation:operation host:host priority:self.priority];
 }
 
 - (NSOperation *)operationWithRequest:(NSURLRequest *)request
                            retryDelay:(NSTimeInterval)retryDelay
+                     retriesRemaining:(NSUInteger)retriesRemaining
                            retryWhere:(BOOL (^)(NSData *data, NSURLResponse *response))retryBlock
                     completionHandler:(void (^)(NSData *data, NSURLResponse *response, NSError *error))completionHandler {
 
@@ -120,18 +187,14 @@ const NSTimeInterval MaxBackOff = 3000;
                                                                            session:self.session
                                                                  completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
 
-        if (!error && retryBlock && retryBlock(data, response)) {
-            UADelayOperation *delayOperation = [UADelayOperation operationWithDelayInSeconds:retryDelay];
+        if (!error && retriesRemaining > 0 && retryBlock && retryBlock(data, response)) {
             NSOperation *retryOperation = [self operationWithRequest:request
                                                           retryDelay:MIN(retryDelay * 2, MaxBackOff)
+                                                    retriesRemaining:retriesRemaining - 1
                                                           retryWhere:retryBlock
                                                    completionHandler:completionHandler];
 
-            [retryOperation addDependency:delayOperation];
-
-            [self.queue addOperation:delayOperation];
-            [self.queue addOperation:retryOperation];
-
+            [self scheduleRetry:retryOperation host:request.URL.host delay:[UARequestSession jitteredDelay:retryDelay]];
             return;
         } else {
             completionHandler(data, response, error);
@@ -142,6 +205,42 @@ const NSTimeInterval MaxBackOff = 3000;
     return operation;
 }
 
+/**
+ * Schedules the retry operation once the delay has passed. Other requests are free to run
+ * while the retry is waiting.
+ */
+- (void)scheduleRetry:(NSOperation *)operation host:(NSString *)host delay:(NSTimeInterval)delay {
+    NSUUID *retryID = [NSUUID UUID];
+
+    @synchronized (self) {
+        [self.pendingRetries addObject:retryID];
+    }
+
+    UA_LTRACE(@"Retrying request in %.1f seconds", delay);
+
+    [self.dispatcher dispatchAfter:delay block:^{
+        @synchronized (self) {
+            // Cancelled while waiting
+            if (![self.pendingRetries containsObject:retryID]) {
+                return;
+            }
+
+            [self.pendingRetries removeObject:retryID];
+        }
+
+        [self scheduleOperation:operation host:host];
+    }];
+}
+
+/**
+ * Returns a random delay between half and all of the backoff delay, so clients that failed
+ * at the same time do not retry at the same time.
+ */
++ (NSTimeInterval)jitteredDelay:(NSTimeInterval)delay {
+    double random = (double)arc4random_uniform(UINT32_MAX) / UINT32_MAX;
+    return (delay / 2) + (delay / 2) * random;
+}
+
 
 + (NSString *)userAgentWithAppKey:(NSString *)appKey {
     /*
@@ -9,14 +9,25 @@
  * An interface for running retriables with optional operation dependency semantics,
  * and automatic exponential backoff. Retries will be scheduled using the dispatcher
  * to avoid blocking other operations from executing.
+ *
+ * Each chain only has one retriable on the queue at a time, so the queue's max concurrent
+ * operation count limits how many chains can be running at once.
  */
 @interface UARetriablePipeline : NSObject
 
 /**
- * UARetriablePipeline class factory.
+ * UARetriablePipeline class factory. Chains run one at a time.
  */
 + (instancetype)pipeline;
 
+/**
+ * UARetriablePipeline class factory. Independent chains run concurrently, up to the
+ * given number of chains at a time. Retriables within a chain always run in order.
+ *
+ * @param maxConcurrentChains The maximum number of chains that can run at the same time.
+ */
++ (instancetype)pipelineWithMaxConcurrentChains:(NSUInteger)maxConcurrentChains;
+
 /**
  * UARetriablePipeline class factory. For testing purposes.
  *
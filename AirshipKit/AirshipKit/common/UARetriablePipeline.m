@@ -34,8 +34,12 @@
 }
 
 + (instancetype)pipeline {
+    return [self pipelineWithMaxConcurrentChains:1];
+}
+
++ (instancetype)pipelineWithMaxConcurrentChains:(NSUInteger)maxConcurrentChains {
     NSOperationQueue *queue = [[NSOperationQueue alloc] init];
-    queue.maxConcurrentOperationCount = 1;
+    queue.maxConcurrentOperationCount = (NSInteger)MAX(maxConcurrentChains, 1);
     return [self pipelineWithQueue:queue dispatcher:[UADispatcher backgroundDispatcher]];
 }
 
@@ -98,6 +98,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (readonly, getter=isOpenURLWhitelistingEnabled) BOOL openURLWhitelistingEnabled;
 
+/**
+ * Flag indicating whether deferred component initialization is enabled. If set to `YES`, `takeOff`
+ * only creates the components needed to handle push notifications at launch.
+ *
+ * Defaults to `NO`.
+ */
+@property (readonly, getter=isDeferredComponentInitializationEnabled) BOOL deferredComponentInitializationEnabled;
+
 /**
  * Flag indicating whether delayed channel creation is enabled. If set to `YES` channel
  * creation will not occur until channel creation is manually enabled.
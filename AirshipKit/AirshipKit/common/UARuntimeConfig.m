@@ -19,6 +19,7 @@
 @property (nonatomic, assign, getter=isChannelCaptureEnabled) BOOL channelCaptureEnabled;
 @property (nonatomic, assign, getter=isOpenURLWhitelistingEnabled) BOOL openURLWhitelistingEnabled;
 @property (nonatomic, assign, getter=isChannelCreationDelayEnabled) BOOL channelCreationDelayEnabled;
+@property (nonatomic, assign, getter=isDeferredComponentInitializationEnabled) BOOL deferredComponentInitializationEnabled;
 @property (nonatomic, copy) NSDictionary *customConfig;
 @property (nonatomic, assign) BOOL requestAuthorizationToUseNotifications;
 
@@ -74,6 +75,7 @@ NSString *const UARuntimeConfigEURemoteDataAPIURL = @"https://remote-data.asnapi
         self.openURLWhitelistingEnabled = config.openURLWhitelistingEnabled;
         self.customConfig = config.customConfig;
         self.channelCreationDelayEnabled = config.channelCreationDelayEnabled;
+        self.deferredComponentInitializationEnabled = config.deferredComponentInitializationEnabled;
         self.messageCenterStyleConfig = config.messageCenterStyleConfig;
         self.itunesID = config.itunesID;
     }
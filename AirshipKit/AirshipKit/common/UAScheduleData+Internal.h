@@ -91,6 +91,12 @@ extern NSUInteger const UAScheduleDataVersion;
  */
 @property (nullable, nonatomic, retain) NSString *data;
 
+/**
+ * The schedule data payload's source, parsed from the payload's top level `source` field.
+ * Set whenever the data changes.
+ */
+@property (nullable, nonatomic, retain) NSString *source;
+
 /**
  * The metadata payload.
  *
@@ -154,6 +160,17 @@ extern NSUInteger const UAScheduleDataVersion;
  */
 @property(nullable, nonatomic, retain) NSNumber *interval;
 
+/**
+ * The schedule's modification stamp. Incremented whenever the schedule's definition changes,
+ * but not on execution state or trigger progress changes.
+ */
+@property(nullable, nonatomic, retain) NSNumber *modificationStamp;
+
+/**
+ * Increments the modification stamp.
+ */
+- (void)incrementModificationStamp;
+
 /**
  * Whether the scheudle has exceeded its limit.
  */
@@ -1,9 +1,13 @@
 /* Copyright Airship and Contributors */
 
 #import "UAScheduleData+Internal.h"
+#import "NSJSONSerialization+UAAdditions.h"
 
 // Data version - for migration
-NSUInteger const UAScheduleDataVersion = 2;
+NSUInteger const UAScheduleDataVersion = 3;
+
+// Key of the schedule source in the data JSON
+static NSString * const UAScheduleDataSourceKey = @"source";
 
 @interface UAScheduleData()
 @property (nullable, nonatomic, retain) NSDate *executionStateChangeDate;
@@ -18,6 +22,7 @@ NSUInteger const UAScheduleDataVersion = 2;
 @dynamic triggeredCount;
 @dynamic metadata;
 @dynamic data;
+@dynamic source;
 @dynamic priority;
 @dynamic triggers;
 @dynamic start;
@@ -28,6 +33,7 @@ NSUInteger const UAScheduleDataVersion = 2;
 @dynamic executionStateChangeDate;
 @dynamic interval;
 @dynamic editGracePeriod;
+@dynamic modificationStamp;
 
 -(void)setExecutionState:(NSNumber *)executionState {
     [self willChangeValueForKey:@"executionState"];
@@ -36,6 +42,20 @@ NSUInteger const UAScheduleDataVersion = 2;
     [self setExecutionStateChangeDate:[NSDate date]];
 }
 
+- (void)setData:(NSString *)data {
+    [self willChangeValueForKey:@"data"];
+    [self setPrimitiveValue:data forKey:@"data"];
+    [self didChangeValueForKey:@"data"];
+
+    id json = [NSJSONSerialization objectWithString:data];
+    id source = [json isKindOfClass:[NSDictionary class]] ? json[UAScheduleDataSourceKey] : nil;
+    [self setSource:[source isKindOfClass:[NSString class]] ? source : nil];
+}
+
+- (void)incrementModificationStamp {
+    self.modificationStamp = @([self.modificationStamp longLongValue] + 1);
+}
+
 - (BOOL)isOverLimit {
     NSUInteger limit = [self.limit unsignedIntegerValue];
     NSUInteger count = [self.triggeredCount unsignedIntegerValue];
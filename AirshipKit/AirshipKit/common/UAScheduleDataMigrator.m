@@ -29,12 +29,17 @@ NSString *const UAInAppMessageV2SourceRemoteDataValue = @"remote-data";
             case 1:
                 [self perform1To2MigrationForScheduleData:scheduleData];
                 break;
+            case 2:
+                [self perform2To3MigrationForScheduleData:scheduleData];
+                break;
             default:
                 UA_LERR(@"No migration available for version %lu to version %lu", (unsigned long)version, (unsigned long)(version + 1));
                 break;
         }
     }
 
+    [scheduleData incrementModificationStamp];
+
     UA_LTRACE(@"Migrated schedule data from %ld to %ld", (unsigned long)oldVersion, (unsigned long)newVersion);
 }
 
@@ -86,4 +91,24 @@ NSString *const UAInAppMessageV2SourceRemoteDataValue = @"remote-data";
     scheduleData.data = [NSJSONSerialization stringWithObject:json];
 }
 
+// the source moved into its own indexed attribute
+// this code copies the source field of existing schedules into the attribute
++ (void)perform2To3MigrationForScheduleData:(UAScheduleData *)scheduleData {
+    scheduleData.dataVersion = @(3);
+
+    // convert schedule data to a JSON dictionary
+    NSDictionary *json = [NSJSONSerialization objectWithString:scheduleData.data];
+    if (![json isKindOfClass:[NSDictionary class]]) {
+        return;
+    }
+
+    NSString *source = json[UAInAppMessageV2SourceKey];
+    if (![source isKindOfClass:[NSString class]]) {
+        // Not a UAInAppMessage. No migration needed.
+        return;
+    }
+
+    scheduleData.source = source;
+}
+
 @end
@@ -18,7 +18,7 @@
 @implementation UATagGroupsAPIClient
 
 + (instancetype)clientWithConfig:(UARuntimeConfig *)config {
-    UATagGroupsAPIClient *client = [self clientWithConfig:config session:[UARequestSession sessionWithConfig:config]];
+    UATagGroupsAPIClient *client = [self clientWithConfig:config session:[UARequestSession sessionWithConfig:config priority:UARequestPriorityRegistration]];
     return client;
 }
 
@@ -54,14 +54,13 @@ NSTimeInterval const UATagGroupsLookupResponseCacheDefaultStaleReadTimeSeconds =
 }
 
 - (UATagGroupsLookupResponse *)response {
-    NSData *encodedResponse = [self.dataStore objectForKey:kUATagGroupsLookupResponseCacheResponseKey];
-    return [NSKeyedUnarchiver unarchiveObjectWithData:encodedResponse];
+    return [self.dataStore unarchivedObjectOfClass:[UATagGroupsLookupResponse class]
+                                            forKey:kUATagGroupsLookupResponseCacheResponseKey];
 }
 
 - (void)setResponse:(UATagGroupsLookupResponse *)response {
-    NSData *encodedResonse = [NSKeyedArchiver archivedDataWithRootObject:response];
-    [self.dataStore setObject:encodedResonse forKey:kUATagGroupsLookupResponseCacheResponseKey];
-    
+    [self.dataStore setArchivedObject:response forKey:kUATagGroupsLookupResponseCacheResponseKey];
+
     self.refreshDate = [NSDate date];
 }
 
@@ -74,13 +73,12 @@ NSTimeInterval const UATagGroupsLookupResponseCacheDefaultStaleReadTimeSeconds =
 }
 
 - (UATagGroups *)requestedTagGroups {
-    NSData *encodedTagGroups = [self.dataStore objectForKey:kUATagGroupsLookupResponseCacheRequestTagGroupsKey];
-    return [NSKeyedUnarchiver unarchiveObjectWithData:encodedTagGroups];
+    return [self.dataStore unarchivedObjectOfClass:[UATagGroups class]
+                                            forKey:kUATagGroupsLookupResponseCacheRequestTagGroupsKey];
 }
 
 - (void)setRequestedTagGroups:(UATagGroups *)tagGroups {
-    NSData *encodedTagGroups = [NSKeyedArchiver archivedDataWithRootObject:tagGroups];
-    [self.dataStore setObject:encodedTagGroups forKey:kUATagGroupsLookupResponseCacheRequestTagGroupsKey];
+    [self.dataStore setArchivedObject:tagGroups forKey:kUATagGroupsLookupResponseCacheRequestTagGroupsKey];
 }
 
 - (BOOL)needsRefresh {
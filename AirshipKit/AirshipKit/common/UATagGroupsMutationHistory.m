@@ -157,9 +157,16 @@
 }
 
 - (void)cleanTransactionRecords {
-    NSArray<UATagGroupsTransactionRecord *> *recentTransactions = [self transactionRecordsWithMaxAge:self.maxSentMutationAge];
-    [self.tagGroupsTransactionRecords setObjects:recentTransactions];
-
+    NSTimeInterval maxAge = self.maxSentMutationAge;
+    NSDate *now = [NSDate date];
+
+    // Records are added as mutations are sent, so the expired ones are at the head of the
+    // queue. Popping them avoids rewriting the queue. Reads still filter by age.
+    UATagGroupsTransactionRecord *record = (UATagGroupsTransactionRecord *)[self.tagGroupsTransactionRecords peekObject];
+    while (record && [now timeIntervalSinceDate:record.date] >= maxAge) {
+        [self.tagGroupsTransactionRecords popObject];
+        record = (UATagGroupsTransactionRecord *)[self.tagGroupsTransactionRecords peekObject];
+    }
 }
 
 - (void)addSentMutation:(UATagGroupsMutation *)mutation date:(NSDate *)date {
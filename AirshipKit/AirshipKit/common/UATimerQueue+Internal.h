@@ -0,0 +1,76 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UATimerScheduler+Internal.h"
+#import "UADate+Internal.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Keeps many one-shot timers in a min-heap ordered by fire date, backed by a single
+ * scheduled timer for the earliest fire date.
+ *
+ * Timers are keyed by identifier and may be assigned a group. Cancelling by identifier
+ * is constant time and cancelling by group is linear in the size of the group.
+ *
+ * This class is not thread safe and should only be used on the main queue.
+ */
+@interface UATimerQueue : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Timer Queue Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The number of pending timers.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+///---------------------------------------------------------------------------------------
+/// @name Timer Queue Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @param timerScheduler The timer scheduler used to schedule the backing timer.
+ * @param date The date.
+ * @return A timer queue.
+ */
++ (instancetype)timerQueueWithTimerScheduler:(UATimerScheduler *)timerScheduler date:(UADate *)date;
+
+/**
+ * Adds a timer. Any pending timer with the same identifier is replaced.
+ *
+ * @param identifier The timer identifier.
+ * @param group The timer group.
+ * @param timeInterval The time interval in seconds.
+ * @param block The block to call when the timer fires.
+ */
+- (void)addTimerWithIdentifier:(NSString *)identifier
+                         group:(nullable NSString *)group
+                  timeInterval:(NSTimeInterval)timeInterval
+                         block:(void (^)(void))block;
+
+/**
+ * Cancels the timer with the given identifier.
+ *
+ * @param identifier The timer identifier.
+ */
+- (void)cancelTimerWithIdentifier:(NSString *)identifier;
+
+/**
+ * Cancels all timers in the group.
+ *
+ * @param group The timer group.
+ */
+- (void)cancelTimersWithGroup:(NSString *)group;
+
+/**
+ * Cancels all timers.
+ */
+- (void)cancelAll;
+
+@end
+
+NS_ASSUME_NONNULL_END
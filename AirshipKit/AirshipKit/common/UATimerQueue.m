@@ -0,0 +1,293 @@
+/* Copyright Airship and Contributors */
+
+#import "UATimerQueue+Internal.h"
+#import "UAGlobal.h"
+
+/**
+ * Minimum time interval for a timer.
+ */
+static NSTimeInterval const UATimerQueueMinTimeInterval = 0.1;
+
+@interface UATimerQueueEntry : NSObject
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, copy) NSString *group;
+@property (nonatomic, copy) void (^block)(void);
+@property (nonatomic, assign) NSTimeInterval fireTime;
+@property (nonatomic, assign) NSUInteger sequence;
+@property (nonatomic, assign) BOOL cancelled;
+@end
+
+@implementation UATimerQueueEntry
+
+- (BOOL)firesBefore:(UATimerQueueEntry *)entry {
+    if (self.fireTime != entry.fireTime) {
+        return self.fireTime < entry.fireTime;
+    }
+
+    return self.sequence < entry.sequence;
+}
+
+@end
+
+@interface UATimerQueue()
+@property (nonatomic, strong) UATimerScheduler *timerScheduler;
+@property (nonatomic, strong) UADate *date;
+
+// Cancelled entries stay in the heap until they reach the top or the heap is compacted
+@property (nonatomic, strong) NSMutableArray<UATimerQueueEntry *> *heap;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UATimerQueueEntry *> *entries;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableSet<NSString *> *> *groups;
+@property (nonatomic, assign) NSUInteger cancelledCount;
+@property (nonatomic, assign) NSUInteger sequence;
+
+@property (nonatomic, strong) NSTimer *timer;
+@property (nonatomic, assign) NSTimeInterval timerFireTime;
+@end
+
+@implementation UATimerQueue
+
+- (instancetype)initWithTimerScheduler:(UATimerScheduler *)timerScheduler date:(UADate *)date {
+    self = [super init];
+
+    if (self) {
+        self.timerScheduler = timerScheduler;
+        self.date = date;
+        self.heap = [NSMutableArray array];
+        self.entries = [NSMutableDictionary dictionary];
+        self.groups = [NSMutableDictionary dictionary];
+    }
+
+    return self;
+}
+
++ (instancetype)timerQueueWithTimerScheduler:(UATimerScheduler *)timerScheduler date:(UADate *)date {
+    return [[self alloc] initWithTimerScheduler:timerScheduler date:date];
+}
+
+- (NSUInteger)count {
+    return self.entries.count;
+}
+
+- (void)addTimerWithIdentifier:(NSString *)identifier
+                         group:(NSString *)group
+                  timeInterval:(NSTimeInterval)timeInterval
+                         block:(void (^)(void))block {
+
+    [self cancelTimerWithIdentifier:identifier];
+
+    UATimerQueueEntry *entry = [[UATimerQueueEntry alloc] init];
+    entry.identifier = identifier;
+    entry.group = group;
+    entry.block = block;
+    entry.fireTime = [self now] + MAX(timeInterval, UATimerQueueMinTimeInterval);
+    entry.sequence = self.sequence++;
+
+    self.entries[identifier] = entry;
+
+    if (group) {
+        NSMutableSet *identifiers = self.groups[group];
+        if (!identifiers) {
+            identifiers = [NSMutableSet set];
+            self.groups[group] = identifiers;
+        }
+        [identifiers addObject:identifier];
+    }
+
+    [self.heap addObject:entry];
+    [self siftUp:self.heap.count - 1];
+
+    [self updateTimer];
+}
+
+- (void)cancelTimerWithIdentifier:(NSString *)identifier {
+    UATimerQueueEntry *entry = self.entries[identifier];
+    if (!entry) {
+        return;
+    }
+
+    [self removeEntry:entry];
+    entry.cancelled = YES;
+    self.cancelledCount++;
+
+    // Compact once most of the heap is cancelled entries
+    if (self.cancelledCount > self.heap.count / 2) {
+        [self compact];
+    }
+
+    [self updateTimer];
+}
+
+- (void)cancelTimersWithGroup:(NSString *)group {
+    for (NSString *identifier in [self.groups[group] copy]) {
+        [self cancelTimerWithIdentifier:identifier];
+    }
+}
+
+- (void)cancelAll {
+    [self.heap removeAllObjects];
+    [self.entries removeAllObjects];
+    [self.groups removeAllObjects];
+    self.cancelledCount = 0;
+
+    [self updateTimer];
+}
+
+#pragma mark -
+#pragma mark Timer
+
+- (NSTimeInterval)now {
+    return [self.date.now timeIntervalSinceReferenceDate];
+}
+
+/**
+ * Schedules the backing timer for the earliest pending entry, or invalidates it if
+ * there are no pending entries.
+ */
+- (void)updateTimer {
+    [self dropCancelledEntries];
+
+    if (!self.heap.count) {
+        [self.timer invalidate];
+        self.timer = nil;
+        return;
+    }
+
+    NSTimeInterval fireTime = self.heap[0].fireTime;
+    if (self.timer.isValid && self.timerFireTime == fireTime) {
+        return;
+    }
+
+    [self.timer invalidate];
+
+    NSTimer *timer = [NSTimer timerWithTimeInterval:MAX(fireTime - [self now], 0)
+                                             target:self
+                                           selector:@selector(timerFired:)
+                                           userInfo:nil
+                                            repeats:NO];
+
+    // Update the state before scheduling, the scheduler may fire the timer immediately
+    self.timer = timer;
+    self.timerFireTime = fireTime;
+
+    UA_LTRACE(@"Scheduling timer queue timer for %f seconds, pending timers: %lu", timer.timeInterval, (unsigned long)self.count);
+    [self.timerScheduler scheduleTimer:timer];
+}
+
+- (void)timerFired:(NSTimer *)timer {
+    if (!timer.isValid || timer != self.timer) {
+        return;
+    }
+
+    [timer invalidate];
+    self.timer = nil;
+
+    // Anything due by the time the timer was scheduled for is fired, even if the timer fired early
+    NSTimeInterval deadline = MAX(self.timerFireTime, [self now]);
+
+    NSMutableArray<UATimerQueueEntry *> *fired = [NSMutableArray array];
+    while (self.heap.count) {
+        UATimerQueueEntry *entry = self.heap[0];
+        if (!entry.cancelled && entry.fireTime > deadline) {
+            break;
+        }
+
+        [self popEntry];
+
+        if (entry.cancelled) {
+            self.cancelledCount--;
+        } else {
+            [self removeEntry:entry];
+            [fired addObject:entry];
+        }
+    }
+
+    [self updateTimer];
+
+    for (UATimerQueueEntry *entry in fired) {
+        entry.block();
+    }
+}
+
+#pragma mark -
+#pragma mark Heap
+
+- (void)removeEntry:(UATimerQueueEntry *)entry {
+    [self.entries removeObjectForKey:entry.identifier];
+
+    if (entry.group) {
+        NSMutableSet *identifiers = self.groups[entry.group];
+        [identifiers removeObject:entry.identifier];
+        if (!identifiers.count) {
+            [self.groups removeObjectForKey:entry.group];
+        }
+    }
+}
+
+- (void)dropCancelledEntries {
+    while (self.heap.count && self.heap[0].cancelled) {
+        [self popEntry];
+        self.cancelledCount--;
+    }
+}
+
+- (void)compact {
+    NSIndexSet *cancelled = [self.heap indexesOfObjectsPassingTest:^BOOL(UATimerQueueEntry *entry, NSUInteger idx, BOOL *stop) {
+        return entry.cancelled;
+    }];
+
+    [self.heap removeObjectsAtIndexes:cancelled];
+    self.cancelledCount = 0;
+
+    for (NSInteger i = (NSInteger)(self.heap.count / 2) - 1; i >= 0; i--) {
+        [self siftDown:i];
+    }
+}
+
+- (void)popEntry {
+    NSUInteger last = self.heap.count - 1;
+    [self.heap exchangeObjectAtIndex:0 withObjectAtIndex:last];
+    [self.heap removeLastObject];
+
+    if (self.heap.count) {
+        [self siftDown:0];
+    }
+}
+
+- (void)siftUp:(NSUInteger)index {
+    while (index > 0) {
+        NSUInteger parent = (index - 1) / 2;
+        if (![self.heap[index] firesBefore:self.heap[parent]]) {
+            break;
+        }
+
+        [self.heap exchangeObjectAtIndex:index withObjectAtIndex:parent];
+        index = parent;
+    }
+}
+
+- (void)siftDown:(NSUInteger)index {
+    NSUInteger count = self.heap.count;
+
+    while (YES) {
+        NSUInteger left = (index * 2) + 1;
+        NSUInteger right = left + 1;
+        NSUInteger smallest = index;
+
+        if (left < count && [self.heap[left] firesBefore:self.heap[smallest]]) {
+            smallest = left;
+        }
+
+        if (right < count && [self.heap[right] firesBefore:self.heap[smallest]]) {
+            smallest = right;
+        }
+
+        if (smallest == index) {
+            break;
+        }
+
+        [self.heap exchangeObjectAtIndex:index withObjectAtIndex:smallest];
+        index = smallest;
+    }
+}
+
+@end
@@ -15,7 +15,7 @@
 }
 
 + (instancetype)clientWithConfig:(UARuntimeConfig *)config {
-    return [UAUserAPIClient clientWithConfig:config session:[UARequestSession sessionWithConfig:config]];
+    return [UAUserAPIClient clientWithConfig:config session:[UARequestSession sessionWithConfig:config priority:UARequestPriorityRegistration]];
 }
 
 - (void)createUserWithChannelID:(NSString *)channelID
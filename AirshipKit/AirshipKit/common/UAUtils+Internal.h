@@ -49,6 +49,35 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (nullable NSString *)nilIfEmpty:(nullable NSString *)str;
 
+///---------------------------------------------------------------------------------------
+/// @name Date Formatting
+///---------------------------------------------------------------------------------------
+
+/**
+ * Shared instance of `ISODateFormatterUTC`. The formatter is shared across threads
+ * and must not be modified.
+ *
+ * @return The shared date formatter.
+ */
++ (NSDateFormatter *)sharedISODateFormatterUTC;
+
+/**
+ * Shared instance of `ISODateFormatterUTCWithDelimiter`. The formatter is shared across threads
+ * and must not be modified.
+ *
+ * @return The shared date formatter.
+ */
++ (NSDateFormatter *)sharedISODateFormatterUTCWithDelimiter;
+
+/**
+ * Parses ISO 8601 date strings with date formatters. Used by `parseISO8601DateFromString:` for
+ * timestamps that do not match one of the fixed layouts.
+ *
+ * @param timestamp The ISO 8601 timestamp.
+ * @return A parsed NSDate object, or nil if the timestamp is not a valid format.
+ */
++ (nullable NSDate *)parseISO8601DateWithFormatters:(NSString *)timestamp;
+
 ///---------------------------------------------------------------------------------------
 /// @name Device ID
 ///---------------------------------------------------------------------------------------
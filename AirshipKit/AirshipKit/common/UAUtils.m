@@ -206,25 +206,195 @@
     return dateFormatter;
 }
 
++ (NSDateFormatter *)sharedISODateFormatterUTC {
+    static dispatch_once_t onceToken;
+    static NSDateFormatter *dateFormatter;
+    dispatch_once(&onceToken, ^{
+        dateFormatter = [self ISODateFormatterUTC];
+    });
+
+    return dateFormatter;
+}
+
++ (NSDateFormatter *)sharedISODateFormatterUTCWithDelimiter {
+    static dispatch_once_t onceToken;
+    static NSDateFormatter *dateFormatter;
+    dispatch_once(&onceToken, ^{
+        dateFormatter = [self ISODateFormatterUTCWithDelimiter];
+    });
+
+    return dateFormatter;
+}
+
+/**
+ * Parses exactly `count` digits.
+ */
+static BOOL UAParseISO8601Digits(const char **cursor, const char *end, int count, int *value) {
+    if (end - *cursor < count) {
+        return NO;
+    }
+
+    int result = 0;
+    for (int i = 0; i < count; i++) {
+        char c = (*cursor)[i];
+        if (c < '0' || c > '9') {
+            return NO;
+        }
+        result = (result * 10) + (c - '0');
+    }
+
+    *cursor += count;
+    *value = result;
+    return YES;
+}
+
+static BOOL UAParseISO8601Character(const char **cursor, const char *end, char expected) {
+    if (*cursor < end && **cursor == expected) {
+        (*cursor)++;
+        return YES;
+    }
+
+    return NO;
+}
+
+/**
+ * Days since 1970-01-01 in the proleptic Gregorian calendar.
+ */
+static int64_t UAISO8601DaysFromCivil(int64_t year, int64_t month, int64_t day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+static int UAISO8601DaysInMonth(int year, int month) {
+    static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    BOOL isLeapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return (month == 2 && isLeapYear) ? 29 : days[month - 1];
+}
+
+/**
+ * Parses `yyyy[-MM[-dd[('T'| )HH[:mm[:ss[.S+]]]]]]` as UTC without a date formatter.
+ *
+ * @return `YES` if the whole string matched, otherwise `NO`.
+ */
+static BOOL UAParseISO8601Timestamp(const char *string, size_t length, NSTimeInterval *interval) {
+    const char *cursor = string;
+    const char *end = string + length;
+
+    int year = 0, month = 1, day = 1, hour = 0, minute = 0, second = 0;
+    double fraction = 0;
+
+    if (!UAParseISO8601Digits(&cursor, end, 4, &year)) {
+        return NO;
+    }
+
+    if (UAParseISO8601Character(&cursor, end, '-')) {
+        if (!UAParseISO8601Digits(&cursor, end, 2, &month)) {
+            return NO;
+        }
+
+        if (UAParseISO8601Character(&cursor, end, '-')) {
+            if (!UAParseISO8601Digits(&cursor, end, 2, &day)) {
+                return NO;
+            }
+
+            if (UAParseISO8601Character(&cursor, end, 'T') || UAParseISO8601Character(&cursor, end, ' ')) {
+                if (!UAParseISO8601Digits(&cursor, end, 2, &hour)) {
+                    return NO;
+                }
+
+                if (UAParseISO8601Character(&cursor, end, ':')) {
+                    if (!UAParseISO8601Digits(&cursor, end, 2, &minute)) {
+                        return NO;
+                    }
+
+                    if (UAParseISO8601Character(&cursor, end, ':')) {
+                        if (!UAParseISO8601Digits(&cursor, end, 2, &second)) {
+                            return NO;
+                        }
+
+                        if (UAParseISO8601Character(&cursor, end, '.')) {
+                            // Digits past nanoseconds are ignored
+                            int64_t numerator = 0, denominator = 1;
+                            const char *fractionStart = cursor;
+                            while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+                                if (cursor - fractionStart < 9) {
+                                    numerator = (numerator * 10) + (*cursor - '0');
+                                    denominator *= 10;
+                                }
+                                cursor++;
+                            }
+
+                            if (cursor == fractionStart) {
+                                return NO;
+                            }
+
+                            fraction = (double)numerator / denominator;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (cursor != end) {
+        return NO;
+    }
+
+    if (month < 1 || month > 12 || day < 1 || day > UAISO8601DaysInMonth(year, month) ||
+        hour > 23 || minute > 59 || second > 59) {
+        return NO;
+    }
+
+    int64_t days = UAISO8601DaysFromCivil(year, month, day);
+    *interval = (double)(days * 86400 + hour * 3600 + minute * 60 + second) + fraction;
+    return YES;
+}
+
 + (NSDate *)parseISO8601DateFromString:(NSString *)timestamp {
-    NSDateFormatter* dateFormatter = [[NSDateFormatter alloc] init];
-    dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
-    dateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
-
-    // All the various formats
-    NSArray *formats = @[@"yyyy-MM-dd'T'HH:mm:ss.SSS",
-                         @"yyyy-MM-dd'T'HH:mm:ss",
-                         @"yyyy-MM-dd HH:mm:ss",
-                         @"yyyy-MM-dd'T'HH:mm",
-                         @"yyyy-MM-dd HH:mm",
-                         @"yyyy-MM-dd'T'HH",
-                         @"yyyy-MM-dd HH",
-                         @"yyyy-MM-dd",
-                         @"yyyy-MM",
-                         @"yyyy"];
-
-    for (NSString *format in formats) {
-        dateFormatter.dateFormat = format;
+    // Fixed layouts are parsed directly, anything else goes through the date formatters
+    char buffer[64];
+    NSTimeInterval interval;
+    if ([timestamp getCString:buffer maxLength:sizeof(buffer) encoding:NSASCIIStringEncoding] &&
+        UAParseISO8601Timestamp(buffer, strlen(buffer), &interval)) {
+        return [NSDate dateWithTimeIntervalSince1970:interval];
+    }
+
+    return [self parseISO8601DateWithFormatters:timestamp];
+}
+
++ (NSDate *)parseISO8601DateWithFormatters:(NSString *)timestamp {
+    static dispatch_once_t onceToken;
+    static NSArray<NSDateFormatter *> *dateFormatters;
+    dispatch_once(&onceToken, ^{
+        // All the various formats
+        NSArray *formats = @[@"yyyy-MM-dd'T'HH:mm:ss.SSS",
+                             @"yyyy-MM-dd'T'HH:mm:ss",
+                             @"yyyy-MM-dd HH:mm:ss",
+                             @"yyyy-MM-dd'T'HH:mm",
+                             @"yyyy-MM-dd HH:mm",
+                             @"yyyy-MM-dd'T'HH",
+                             @"yyyy-MM-dd HH",
+                             @"yyyy-MM-dd",
+                             @"yyyy-MM",
+                             @"yyyy"];
+
+        NSMutableArray *formatters = [NSMutableArray arrayWithCapacity:formats.count];
+        for (NSString *format in formats) {
+            NSDateFormatter* dateFormatter = [[NSDateFormatter alloc] init];
+            dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+            dateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+            dateFormatter.dateFormat = format;
+            [formatters addObject:dateFormatter];
+        }
+
+        dateFormatters = [formatters copy];
+    });
+
+    for (NSDateFormatter *dateFormatter in dateFormatters) {
         NSDate *date = [dateFormatter dateFromString:timestamp];
         if (date) {
             return date;
@@ -5,6 +5,20 @@
 #import "UAGlobal.h"
 #import "UAUtils+Internal.h"
 
+// Max number of version components compared, any extra components are ignored
+#define UAVersionMatcherMaxComponents 8
+
+/**
+ * Version components stored as a flat array of integers, e.g. "1.2.3" -> {1, 2, 3}.
+ * The values are copied into the struct so it never points at memory owned by the cache.
+ */
+typedef struct {
+    NSInteger values[UAVersionMatcherMaxComponents];
+    NSUInteger count;
+} UAVersionMatcherComponents;
+
+static NSComparisonResult UAVersionMatcherCompareComponents(UAVersionMatcherComponents version1, UAVersionMatcherComponents version2);
+
 typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
     UAVersionMatcherConstraintTypeUnknown,
     UAVersionMatcherConstraintTypeExactVersion,
@@ -18,6 +32,14 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
 @property(nonatomic, assign) UAVersionMatcherConstraintType constraintType;
 @property(nonatomic, strong) NSDictionary *parsedConstraint;
 
+// Precomputed at creation so evaluation never needs to reparse the constraint
+@property(nonatomic, copy) NSString *exactVersion;
+@property(nonatomic, copy) NSString *subVersion;
+@property(nonatomic, assign) NSInteger startBoundary;
+@property(nonatomic, assign) NSInteger endBoundary;
+@property(nonatomic, assign) UAVersionMatcherComponents startComponents;
+@property(nonatomic, assign) UAVersionMatcherComponents endComponents;
+
 @end
 
 
@@ -43,6 +65,7 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
     if (parsedConstraint) {
         matcher.constraintType = UAVersionMatcherConstraintTypeExactVersion;
         matcher.parsedConstraint = parsedConstraint;
+        matcher.exactVersion = parsedConstraint[@"exactVersion"];
         return matcher;
     }
     
@@ -50,6 +73,7 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
     if (parsedConstraint) {
         matcher.constraintType = UAVersionMatcherConstraintTypeSubVersion;
         matcher.parsedConstraint = parsedConstraint;
+        matcher.subVersion = parsedConstraint[@"subVersion"];
         return matcher;
     }
     
@@ -57,6 +81,18 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
     if (parsedConstraint) {
         matcher.constraintType = UAVersionMatcherConstraintTypeVersionRange;
         matcher.parsedConstraint = parsedConstraint;
+        matcher.startBoundary = [parsedConstraint[@"startBoundary"] integerValue];
+        matcher.endBoundary = [parsedConstraint[@"endBoundary"] integerValue];
+
+        id startOfRange = parsedConstraint[@"startOfRange"];
+        if ([startOfRange isKindOfClass:[NSString class]]) {
+            matcher.startComponents = [self componentsForVersion:startOfRange];
+        }
+
+        id endOfRange = parsedConstraint[@"endOfRange"];
+        if ([endOfRange isKindOfClass:[NSString class]]) {
+            matcher.endComponents = [self componentsForVersion:endOfRange];
+        }
         return matcher;
     }
     
@@ -67,6 +103,10 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
 #pragma mark Evaluate version against constraint
 
 - (BOOL)evaluateObject:(id)value {
+    if (![value isKindOfClass:[NSString class]]) {
+        return NO;
+    }
+
     NSString *checkVersion = [[self class] removeWhitespace:value];
 
     switch (self.constraintType) {
@@ -108,7 +148,7 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
         return NO;
     }
     
-    return ([checkVersion isEqualToString:self.parsedConstraint[@"exactVersion"]]);
+    return ([checkVersion isEqualToString:self.exactVersion]);
 }
 
 #pragma mark -
@@ -152,11 +192,11 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
         return NO;
     }
     
-    NSString *subVersion = self.parsedConstraint[@"subVersion"];
+    NSString *subVersion = self.subVersion;
     
     // if the version being matched is longer than the constraint, only compare its prefix
     if ([checkVersion length] > [subVersion length]) {
-        return ([subVersion isEqualToString:[checkVersion substringToIndex:[subVersion length]]]);
+        return [checkVersion hasPrefix:subVersion];
     } else {
         return ([subVersion isEqualToString:checkVersion]);
     }
@@ -295,11 +335,13 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
     if (self.constraintType != UAVersionMatcherConstraintTypeVersionRange) {
         return NO;
     }
-    
-    UAVersionMatcherRangeBoundary startBoundary = [self.parsedConstraint[@"startBoundary"] integerValue];
-    NSString *startOfRange = self.parsedConstraint[@"startOfRange"];
+
+    // Split the checked version once, the bounds were split when the matcher was created
+    UAVersionMatcherComponents check = [[self class] componentsForVersion:checkVersion];
+
+    UAVersionMatcherRangeBoundary startBoundary = self.startBoundary;
     if (startBoundary != UAVersionMatcherRangeBoundaryInfinite) {
-        NSComparisonResult result = [UAUtils compareVersion:startOfRange toVersion:checkVersion];
+        NSComparisonResult result = UAVersionMatcherCompareComponents(self.startComponents, check);
         switch (startBoundary) {
             case UAVersionMatcherRangeBoundaryInclusive:
                 if (result != NSOrderedAscending && result != NSOrderedSame) {
@@ -316,10 +358,9 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
         }
     }
     
-    UAVersionMatcherRangeBoundary endBoundary = [self.parsedConstraint[@"endBoundary"] integerValue];
-    NSString *endOfRange = self.parsedConstraint[@"endOfRange"];
+    UAVersionMatcherRangeBoundary endBoundary = self.endBoundary;
     if (endBoundary != UAVersionMatcherRangeBoundaryInfinite) {
-        NSComparisonResult result = [UAUtils compareVersion:checkVersion toVersion:endOfRange];
+        NSComparisonResult result = UAVersionMatcherCompareComponents(check, self.endComponents);
         switch (endBoundary) {
             case UAVersionMatcherRangeBoundaryInclusive:
                 if (result != NSOrderedAscending && result != NSOrderedSame) {
@@ -339,17 +380,101 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
     return YES;
 }
 
+#pragma mark -
+#pragma mark Version Components
+
+/**
+ * Compares two split versions the same way as [UAUtils compareVersion:toVersion:],
+ * missing trailing components are treated as 0.
+ */
+static NSComparisonResult UAVersionMatcherCompareComponents(UAVersionMatcherComponents version1, UAVersionMatcherComponents version2) {
+    NSUInteger count = MAX(version1.count, version2.count);
+    for (NSUInteger i = 0; i < count; i++) {
+        NSInteger value1 = (i < version1.count) ? version1.values[i] : 0;
+        NSInteger value2 = (i < version2.count) ? version2.values[i] : 0;
+
+        if (value1 < value2) {
+            return NSOrderedAscending;
+        }
+
+        if (value1 > value2) {
+            return NSOrderedDescending;
+        }
+    }
+
+    return NSOrderedSame;
+}
+
++ (NSCache<NSString *, NSData *> *)componentsCache {
+    static NSCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[NSCache alloc] init];
+        cache.countLimit = 100;
+    });
+    return cache;
+}
+
+/**
+ * Splits a version into its integer components. The same handful of app versions are
+ * checked over and over again, so the results are cached. The cached values are copied
+ * into the returned struct, the cache may evict its entry at any time.
+ */
++ (UAVersionMatcherComponents)componentsForVersion:(NSString *)version {
+    UAVersionMatcherComponents components = { .count = 0 };
+
+    NSCache *cache = [self componentsCache];
+    NSData *data = [cache objectForKey:version];
+    if (data) {
+        components.count = data.length / sizeof(NSInteger);
+        [data getBytes:components.values length:data.length];
+        return components;
+    }
+
+    NSArray<NSString *> *parts = [version componentsSeparatedByString:@"."];
+    components.count = MIN(parts.count, UAVersionMatcherMaxComponents);
+    for (NSUInteger i = 0; i < components.count; i++) {
+        components.values[i] = [parts[i] integerValue];
+    }
+
+    [cache setObject:[NSData dataWithBytes:components.values length:components.count * sizeof(NSInteger)] forKey:version];
+    return components;
+}
+
 #pragma mark -
 #pragma mark Utility methods
 
++ (NSRegularExpression *)regularExpressionForPattern:(NSString *)pattern {
+    static NSMutableDictionary<NSString *, NSRegularExpression *> *regexes;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        regexes = [NSMutableDictionary dictionary];
+    });
+
+    @synchronized (regexes) {
+        NSRegularExpression *regex = regexes[pattern];
+        if (regex) {
+            return regex;
+        }
+
+        NSError *error = nil;
+        regex = [NSRegularExpression regularExpressionWithPattern:pattern
+                                                          options:NSRegularExpressionCaseInsensitive
+                                                            error:&error];
+
+        if (error) {
+            UA_LERR(@"Error creating regular expression - %@",error);
+            return nil;
+        }
+
+        regexes[pattern] = regex;
+        return regex;
+    }
+}
+
 + (NSArray<NSTextCheckingResult *> *)getMatchesForPattern:(NSString *)pattern onString:(NSString *)string {
-    NSError *error = NULL;
-    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:pattern
-                                                                           options:NSRegularExpressionCaseInsensitive
-                                                                             error:NULL];
-    
-    if (error) {
-        UA_LERR(@"Error creating regular expression - %@",error);
+    NSRegularExpression *regex = [self regularExpressionForPattern:pattern];
+    if (!regex) {
         return nil;
     }
     
@@ -358,6 +483,11 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
 }
 
 + (NSString *)removeWhitespace:(NSString *)sourceString {
+    // Most versions have no whitespace, skip the regex replacement for those
+    if ([sourceString rangeOfCharacterFromSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]].location == NSNotFound) {
+        return sourceString;
+    }
+
     NSString *destString = [sourceString stringByReplacingOccurrencesOfString:@"\\s"
                                                                    withString:@""
                                                                       options:NSRegularExpressionSearch
@@ -118,6 +118,20 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (void)setSharedAirship:(UAirship * __nullable)airship;
 
+/**
+ * Default init method.
+ * @param config The runtime config.
+ * @param dataStore The preference data store.
+ */
+- (instancetype)initWithRuntimeConfig:(UARuntimeConfig *)config dataStore:(UAPreferenceDataStore *)dataStore;
+
+/**
+ * Creates any deferred components that have not been created yet. The components are created on
+ * the main queue the next run loop after the app first becomes active, so they are not created
+ * before the app's first frame. Must be called on the main thread.
+ */
+- (void)scheduleDeferredComponents;
+
 NS_ASSUME_NONNULL_END
 
 @end
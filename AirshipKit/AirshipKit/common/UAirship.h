@@ -74,6 +74,39 @@ NS_ASSUME_NONNULL_BEGIN
  */
 extern NSString * const UAirshipTakeOffBackgroundThreadException;
 
+/**
+ * Startup stage that creates the components needed to handle push notifications at launch.
+ */
+extern NSString * const UAirshipStartupStageLaunch;
+
+/**
+ * Startup stage that creates the automation component.
+ */
+extern NSString * const UAirshipStartupStageAutomation;
+
+/**
+ * Startup stage that creates the remote data, remote config and module components.
+ */
+extern NSString * const UAirshipStartupStageRemoteData;
+
+/**
+ * Startup stage that creates the in-app messaging components.
+ */
+extern NSString * const UAirshipStartupStageInAppMessaging;
+
+/**
+ * Startup stage that creates the inbox and message center.
+ */
+extern NSString * const UAirshipStartupStageMessageCenter;
+
+/**
+ * Handler called on the main thread as each startup stage finishes.
+ *
+ * @param stage The startup stage.
+ * @param duration The time it took to run the stage in seconds.
+ */
+typedef void (^UAirshipStartupMetricsHandler)(NSString *stage, NSTimeInterval duration);
+
 /**
  * UAirship manages the shared state for all Airship services. [UAirship takeOff:] should be
  * called from within your application delegate's `application:didFinishLaunchingWithOptions:` method
@@ -170,6 +203,14 @@ extern NSString * const UAirshipTakeOffBackgroundThreadException;
 /// @name Lifecycle
 ///---------------------------------------------------------------------------------------
 
+/**
+ * Sets the handler that receives the time taken by each startup stage. The handler must be
+ * set before `takeOff` to receive the launch stage.
+ *
+ * @param handler The startup metrics handler.
+ */
++ (void)setStartupMetricsHandler:(nullable UAirshipStartupMetricsHandler)handler;
+
 /**
  * Initializes UAirship and performs all necessary setup. This creates the shared instance, loads
  * configuration values, initializes the analytics/reporting
@@ -46,6 +46,13 @@ NSString * const UALibraryVersion = @"com.urbanairship.library_version";
 
 NSString * const UAAirshipReadyNotification = @"com.urbanairship.airship_ready";
 
+// Startup stages
+NSString * const UAirshipStartupStageLaunch = @"launch";
+NSString * const UAirshipStartupStageAutomation = @"automation";
+NSString * const UAirshipStartupStageRemoteData = @"remote_data";
+NSString * const UAirshipStartupStageInAppMessaging = @"in_app_messaging";
+NSString * const UAirshipStartupStageMessageCenter = @"message_center";
+
 static UAirship *sharedAirship_;
 
 static NSBundle *resourcesBundle_;
@@ -61,12 +68,22 @@ static NSDictionary *launchNotification_;
 
 static BOOL handledLaunch_;
 
+static UAirshipStartupMetricsHandler startupMetricsHandler_;
+
 // Logging info
 // Default to ON and ERROR - options/plist will override
 BOOL uaLoggingEnabled = YES;
 UALogLevel uaLogLevel = UALogLevelError;
 BOOL uaLoudImpErrorLoggingEnabled = YES;
 
+@interface UAirship()
+@property (nonatomic, strong) UATagGroupsMutationHistory *tagGroupsMutationHistory;
+@property (atomic, assign) BOOL deferredComponentsInitialized;
+@property (nonatomic, assign) BOOL deferredComponentsScheduled;
+@property (nonatomic, strong) NSMutableSet<NSString *> *startedStages;
+@property (nonatomic, assign) BOOL libraryVersionChanged;
+@end
+
 @implementation UAirship
 
 #pragma mark -
@@ -97,78 +114,239 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
         self.remoteNotificationBackgroundModeEnabled = [[[NSBundle mainBundle] objectForInfoDictionaryKey:@"UIBackgroundModes"] containsObject:@"remote-notification"];
         self.dataStore = dataStore;
         self.config = config;
-        self.applicationMetrics = [UAApplicationMetrics applicationMetricsWithDataStore:dataStore];
-        self.actionRegistry = [UAActionRegistry defaultRegistry];
+        self.startedStages = [NSMutableSet set];
 
-        UATagGroupsMutationHistory *tagGroupsMutationHistory = [UATagGroupsMutationHistory historyWithDataStore:dataStore];
+        [self performStartupStage:UAirshipStartupStageLaunch block:^{
+            [self initializeLaunchComponents];
+        }];
 
-        UAChannelRegistrar *channelRegistrar = [UAChannelRegistrar channelRegistrarWithConfig:config dataStore:dataStore];
+        if (!config.isDeferredComponentInitializationEnabled) {
+            [self initializeDeferredComponents];
+        }
+    }
 
-        UATagGroupsRegistrar *tagGroupsRegistrar = [UATagGroupsRegistrar tagGroupsRegistrarWithConfig:config
-                                                                                            dataStore:dataStore
-                                                                                      mutationHistory:tagGroupsMutationHistory];
+    return self;
+}
+
+/**
+ * Creates the components needed to handle push notifications at launch.
+ */
+- (void)initializeLaunchComponents {
+    UARuntimeConfig *config = self.config;
+    UAPreferenceDataStore *dataStore = self.dataStore;
 
-        self.sharedChannel = [UAChannel channelWithDataStore:dataStore
+    self.applicationMetrics = [UAApplicationMetrics applicationMetricsWithDataStore:dataStore];
+    self.actionRegistry = [UAActionRegistry defaultRegistry];
+
+    self.tagGroupsMutationHistory = [UATagGroupsMutationHistory historyWithDataStore:dataStore];
+
+    UAChannelRegistrar *channelRegistrar = [UAChannelRegistrar channelRegistrarWithConfig:config dataStore:dataStore];
+
+    UATagGroupsRegistrar *tagGroupsRegistrar = [UATagGroupsRegistrar tagGroupsRegistrarWithConfig:config
+                                                                                        dataStore:dataStore
+                                                                                  mutationHistory:self.tagGroupsMutationHistory];
+
+    self.sharedChannel = [UAChannel channelWithDataStore:dataStore
+                                                  config:config
+                                      notificationCenter:[NSNotificationCenter defaultCenter]
+                                        channelRegistrar:channelRegistrar
+                                      tagGroupsRegistrar:tagGroupsRegistrar];
+
+    self.sharedPush = [UAPush pushWithConfig:config dataStore:dataStore channel:self.sharedChannel];
+    self.sharedChannel.pushProviderDelegate = self.sharedPush;
+
+    self.sharedNamedUser = [UANamedUser namedUserWithChannel:self.sharedChannel
                                                       config:config
-                                          notificationCenter:[NSNotificationCenter defaultCenter]
-                                            channelRegistrar:channelRegistrar
+                                                   dataStore:dataStore
                                           tagGroupsRegistrar:tagGroupsRegistrar];
 
-        self.sharedPush = [UAPush pushWithConfig:config dataStore:dataStore channel:self.sharedChannel];
-        self.sharedChannel.pushProviderDelegate = self.sharedPush;
+    self.sharedAnalytics = [UAAnalytics analyticsWithConfig:config dataStore:dataStore];
+    self.whitelist = [UAWhitelist whitelistWithConfig:config];
+
+#if !TARGET_OS_TV
+    // Message center not supported on tvOS. The user is part of the channel registration payload.
+    self.sharedInboxUser = [UAUser userWithChannel:self.sharedChannel config:config dataStore:dataStore];
+    self.sharedChannel.userProviderDelegate = self.sharedInboxUser;
+
+    // Not supporting Javascript in tvOS
+    self.actionJSDelegate = [[UAActionJSDelegate alloc] init];
+    // UIPasteboard is not available in tvOS
+    self.channelCapture = [UAChannelCapture channelCaptureWithConfig:config
+                                                             channel:self.sharedChannel
+                                                pushProviderDelegate:self.sharedPush
+                                                           dataStore:dataStore];
+#endif
+}
+
+/**
+ * Creates the components that are not needed at launch.
+ */
+- (void)initializeDeferredComponents {
+    if (self.deferredComponentsInitialized) {
+        return;
+    }
 
-        self.sharedNamedUser = [UANamedUser namedUserWithChannel:self.sharedChannel
-                                                          config:config
-                                                       dataStore:dataStore
-                                              tagGroupsRegistrar:tagGroupsRegistrar];
+    [self ensureAutomation];
+    [self ensureRemoteData];
+#if !TARGET_OS_TV   // IAM and message center not supported on tvOS
+    [self ensureInAppMessaging];
+    [self ensureMessageCenter];
+#endif
 
-        self.sharedAnalytics = [UAAnalytics analyticsWithConfig:config dataStore:dataStore];
-        self.whitelist = [UAWhitelist whitelistWithConfig:config];
+    self.deferredComponentsInitialized = YES;
+}
 
-        self.sharedAutomation = [UAAutomation automationWithConfig:config dataStore:dataStore];
+/**
+ * Creates the components of a deferred startup stage if they have not been created yet.
+ *
+ * Stages are created on the main queue after the first frame, or on whichever thread first
+ * uses one of the stage's accessors. Waiting on the main queue instead would deadlock accessors
+ * used from threads the main queue is waiting on. The lock is recursive, so a stage can use the
+ * accessors of the stages it depends on while it is being created.
+ *
+ * The lock is held while a stage is created and any thread, including the main thread, may be
+ * waiting on it. Component initializers must not block on another thread or queue, e.g. with a
+ * synchronous dispatch to the main queue.
+ */
+- (void)ensureStartupStage:(NSString *)stage block:(void (^)(void))block {
+    if (self.deferredComponentsInitialized) {
+        return;
+    }
 
+    @synchronized (self) {
+        if ([self.startedStages containsObject:stage]) {
+            return;
+        }
 
-        self.sharedRemoteDataManager = [UARemoteDataManager remoteDataManagerWithConfig:config
-                                                                              dataStore:dataStore];
-        self.sharedModules = [[UAModules alloc] initWithDataStore:dataStore];
+        [self.startedStages addObject:stage];
+        [self performStartupStage:stage block:block];
+    }
+}
+
+- (void)ensureAutomation {
+    [self ensureStartupStage:UAirshipStartupStageAutomation block:^{
+        self.sharedAutomation = [UAAutomation automationWithConfig:self.config dataStore:self.dataStore];
+    }];
+}
+
+- (void)ensureRemoteData {
+    [self ensureStartupStage:UAirshipStartupStageRemoteData block:^{
+        self.sharedRemoteDataManager = [UARemoteDataManager remoteDataManagerWithConfig:self.config
+                                                                              dataStore:self.dataStore];
+        self.sharedModules = [[UAModules alloc] initWithDataStore:self.dataStore];
 
         UAComponentDisabler *componentDisabler = [UAComponentDisabler componentDisablerWithModules:self.sharedModules];
 
         self.sharedRemoteConfigManager = [UARemoteConfigManager remoteConfigManagerWithRemoteDataManager:self.sharedRemoteDataManager
                                                                                        componentDisabler:componentDisabler
                                                                                                  modules:self.sharedModules];
+    }];
+}
+
 #if !TARGET_OS_TV   // IAM not supported on tvOS
-        self.sharedInAppMessageManager = [UAInAppMessageManager managerWithConfig:config
-                                                         tagGroupsMutationHistory:tagGroupsMutationHistory
+- (void)ensureInAppMessaging {
+    // IAM uses remote data
+    [self ensureRemoteData];
+
+    [self ensureStartupStage:UAirshipStartupStageInAppMessaging block:^{
+        self.sharedInAppMessageManager = [UAInAppMessageManager managerWithConfig:self.config
+                                                         tagGroupsMutationHistory:self.tagGroupsMutationHistory
                                                                 remoteDataManager:self.sharedRemoteDataManager
-                                                                        dataStore:dataStore
+                                                                        dataStore:self.dataStore
                                                                           channel:self.sharedChannel
                                                                         analytics:self.sharedAnalytics];
 
-        self.sharedLegacyInAppMessaging = [UALegacyInAppMessaging inAppMessagingWithAnalytics:self.sharedAnalytics dataStore:dataStore inAppMessageManager:self.sharedInAppMessageManager];
-
-        // Message center not supported on tvOS
-        self.sharedInboxUser = [UAUser userWithChannel:self.sharedChannel config:config dataStore:dataStore];
-        self.sharedChannel.userProviderDelegate = self.sharedInboxUser;
+        self.sharedLegacyInAppMessaging = [UALegacyInAppMessaging inAppMessagingWithAnalytics:self.sharedAnalytics dataStore:self.dataStore inAppMessageManager:self.sharedInAppMessageManager];
+    }];
+}
 
-        self.sharedInbox = [UAInbox inboxWithUser:self.sharedInboxUser config:config dataStore:dataStore];
-        // Not supporting Javascript in tvOS
-        self.actionJSDelegate = [[UAActionJSDelegate alloc] init];
-        // UIPasteboard is not available in tvOS
-        self.channelCapture = [UAChannelCapture channelCaptureWithConfig:config
-                                                                 channel:self.sharedChannel
-                                                    pushProviderDelegate:self.sharedPush
-                                                               dataStore:self.dataStore];
+// Message center not supported on tvOS
+- (void)ensureMessageCenter {
+    [self ensureStartupStage:UAirshipStartupStageMessageCenter block:^{
+        self.sharedInbox = [UAInbox inboxWithUser:self.sharedInboxUser config:self.config dataStore:self.dataStore];
 
         if ([UAirship resources]) {
             self.sharedMessageCenter = [UAMessageCenter messageCenterWithConfig:self.config];
         } else {
             UA_LWARN(@"Unable to initialize default message center: AirshipResources is missing");
         }
+    }];
+}
 #endif
+
+- (void)scheduleDeferredComponents {
+    if (self.deferredComponentsInitialized) {
+        [self deferredComponentsReady];
+        return;
     }
 
-    return self;
+    self.deferredComponentsScheduled = YES;
+
+    if (appStateTracker_.state == UAApplicationStateActive) {
+        [self initializeScheduledDeferredComponents];
+    }
+}
+
+/**
+ * Creates the scheduled deferred components on the next run loop, after the app's first frame
+ * has been committed. Must be called on the main thread.
+ */
+- (void)initializeScheduledDeferredComponents {
+    if (!self.deferredComponentsScheduled) {
+        return;
+    }
+
+    self.deferredComponentsScheduled = NO;
+
+    UA_WEAKIFY(self)
+    [[UADispatcher mainDispatcher] dispatchAsync:^{
+        UA_STRONGIFY(self)
+        [self initializeDeferredComponents];
+        [self deferredComponentsReady];
+    }];
+}
+
+/**
+ * Finishes setting up the deferred components once takeOff has finished. Must be called on the main thread.
+ */
+- (void)deferredComponentsReady {
+#if !TARGET_OS_TV   // Inbox not supported on tvOS
+    if (self.libraryVersionChanged) {
+        // Temp workaround for MB-1047 where model changes to the inbox
+        // will drop the inbox and the last-modified-time will prevent
+        // repopulating the messages.
+        [self.sharedInbox.client clearLastModifiedTime];
+    }
+#endif
+
+    // Notify all modules that the shared airship is ready
+    UAModules *modules = self.sharedModules;
+    for (NSString *moduleName in modules.allModuleNames) {
+        UAComponent *component = [modules componentForModuleName:moduleName];
+        [component airshipReady:self];
+    }
+}
+
+/**
+ * Runs a startup stage and reports how long it took.
+ */
+- (void)performStartupStage:(NSString *)stage block:(void (^)(void))block {
+    NSDate *start = [NSDate date];
+    block();
+    NSTimeInterval duration = [[NSDate date] timeIntervalSinceDate:start];
+
+    UA_LDEBUG(@"Startup stage %@ took %.3f seconds", stage, duration);
+
+    UAirshipStartupMetricsHandler handler = startupMetricsHandler_;
+    if (handler) {
+        [[UADispatcher mainDispatcher] dispatchAsyncIfNecessary:^{
+            handler(stage, duration);
+        }];
+    }
+}
+
++ (void)setStartupMetricsHandler:(UAirshipStartupMetricsHandler)handler {
+    startupMetricsHandler_ = handler;
 }
 
 + (void)takeOff {
@@ -276,13 +454,7 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
         NSString *previousVersion = [sharedAirship_.dataStore stringForKey:UALibraryVersion];
         if (![[UAirshipVersion get] isEqualToString:previousVersion]) {
             [dataStore setObject:[UAirshipVersion get] forKey:UALibraryVersion];
-
-#if !TARGET_OS_TV   // Inbox not supported on tvOS
-            // Temp workaround for MB-1047 where model changes to the inbox
-            // will drop the inbox and the last-modified-time will prevent
-            // repopulating the messages.
-            [sharedAirship_.sharedInbox.client clearLastModifiedTime];
-#endif
+            sharedAirship_.libraryVersionChanged = YES;
 
             if (previousVersion) {
                 UA_LINFO(@"Airship library version changed from %@ to %@.", previousVersion, [UAirshipVersion get]);
@@ -309,12 +481,12 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
         }];
     }
 
-    // Notify all modules that the shared airship is ready
-    UAModules *modules = sharedAirship_.sharedModules;
-    for (NSString *moduleName in modules.allModuleNames) {
-        UAComponent *component = [modules componentForModuleName:moduleName];
-        [component airshipReady:sharedAirship_];
-    }
+    // Create the remaining components once the app is active
+    [sharedAirship_ scheduleDeferredComponents];
+}
+
++ (void)applicationDidBecomeActive {
+    [sharedAirship_ initializeScheduledDeferredComponents];
 }
 
 + (void)applicationDidFinishLaunching:(nullable NSDictionary *)remoteNotification {
@@ -392,6 +564,7 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
 
 #if !TARGET_OS_TV   // Inbox not supported on tvOS
 + (UAInbox *)inbox {
+    [sharedAirship_ ensureMessageCenter];
     return sharedAirship_.sharedInbox;
 }
 
@@ -400,14 +573,17 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
 }
 
 + (UALegacyInAppMessaging *)legacyInAppMessaging {
+    [sharedAirship_ ensureInAppMessaging];
     return sharedAirship_.sharedLegacyInAppMessaging;
 }
 
 + (UAInAppMessageManager *)inAppMessageManager {
+    [sharedAirship_ ensureInAppMessaging];
     return sharedAirship_.sharedInAppMessageManager;
 }
 
 + (UAMessageCenter *)messageCenter {
+    [sharedAirship_ ensureMessageCenter];
     return sharedAirship_.sharedMessageCenter;
 }
 
@@ -418,6 +594,7 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
 }
 
 + (UAAutomation *)automation {
+    [sharedAirship_ ensureAutomation];
     return sharedAirship_.sharedAutomation;
 }
 
@@ -430,10 +607,12 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
 }
 
 + (UARemoteDataManager *)remoteDataManager {
+    [sharedAirship_ ensureRemoteData];
     return sharedAirship_.sharedRemoteDataManager;
 }
 
 + (UAModules *)modules {
+    [sharedAirship_ ensureRemoteData];
     return sharedAirship_.sharedModules;
 }
 
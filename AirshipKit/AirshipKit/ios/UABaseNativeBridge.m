@@ -98,7 +98,7 @@ NSString *const UANativeBridgeDismissCommand = @"dismiss";
             NSNumber *milliseconds = [NSNumber numberWithDouble:messageSentDateMS];
             appendNumberGetter(@"getMessageSentDateMS", milliseconds);
 
-            NSString *messageSentDate = [[UAUtils ISODateFormatterUTC] stringFromDate:message.messageSent];
+            NSString *messageSentDate = [[UAUtils sharedISODateFormatterUTC] stringFromDate:message.messageSent];
             appendStringGetter(@"getMessageSentDate", messageSentDate);
 
         } else {
@@ -71,6 +71,7 @@ extern NSString *const UAInAppMessageExtraKey;
 extern NSString *const UAInAppMessageAudienceKey;
 extern NSString *const UAInAppMessageActionsKey;
 extern NSString *const UAInAppMessageCampaignsKey;
+extern NSString *const UAInAppMessageSourceKey;
 
 extern NSString *const UAInAppMessageDisplayTypeBannerValue;
 extern NSString *const UAInAppMessageDisplayTypeFullScreenValue;
@@ -78,6 +79,8 @@ extern NSString *const UAInAppMessageDisplayTypeModalValue;
 extern NSString *const UAInAppMessageDisplayTypeHTMLValue;
 extern NSString *const UAInAppMessageDisplayTypeCustomValue;
 
+extern NSString *const UAInAppMessageSourceRemoteDataValue;
+
 
 /**
  * In-app message source.
@@ -6,8 +6,15 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class UAInAppMessageSharedAssetStore;
+
 @interface UAInAppMessageAssetCache : NSObject
 
+/**
+ * The store for assets shared between schedules.
+ */
+@property (nonatomic, readonly, nullable) UAInAppMessageSharedAssetStore *sharedStore;
+
 /**
  * Factory method
  *
@@ -29,7 +36,8 @@ NS_ASSUME_NONNULL_BEGIN
  * Releases assets instance for this schedule id
  *
  * @param scheduleId The id of the schedule for which to release assets instance
- * @param wipeFromDisk Also remove all of the assets from disk
+ * @param wipeFromDisk Also remove all of the assets from disk. Shared assets are released and
+ * left for the shared store to evict.
  */
 - (void)releaseAssets:(NSString *)scheduleId wipeFromDisk:(BOOL)wipeFromDisk;
 
@@ -2,11 +2,16 @@
 
 #import "UAInAppMessageAssetCache+Internal.h"
 #import "UAInAppMessageAssets+Internal.h"
+#import "UAInAppMessageSharedAssetStore+Internal.h"
 #import "UAGlobal.h"
 
+// Shared assets directory, inside the root directory next to the schedule directories
+static NSString * const UAInAppMessageAssetCacheSharedDirectory = @".shared";
+
 @interface UAInAppMessageAssetCache()
 
 @property (nonatomic, strong) NSURL *rootURL;
+@property (nonatomic, strong) UAInAppMessageSharedAssetStore *sharedStore;
 @property (nonatomic, strong) NSMutableDictionary<NSString *, UAInAppMessageAssets *> *activeAssets;
 
 @end
@@ -22,6 +27,11 @@
     if (self) {
         self.rootURL = [self assetCacheRootURL];
         self.activeAssets = [NSMutableDictionary dictionary];
+
+        if (self.rootURL) {
+            self.sharedStore = [UAInAppMessageSharedAssetStore storeWithRootURL:[self.rootURL URLByAppendingPathComponent:UAInAppMessageAssetCacheSharedDirectory]
+                                                                     byteBudget:UAInAppMessageSharedAssetStoreDefaultByteBudget];
+        }
     }
     
     if (self.rootURL) {
@@ -35,6 +45,8 @@
     @synchronized (self.activeAssets) {
         if (!self.activeAssets[scheduleId]) {
             UAInAppMessageAssets *assets = [UAInAppMessageAssets assets:[self.rootURL URLByAppendingPathComponent:scheduleId]];
+            assets.sharedStore = self.sharedStore;
+            assets.scheduleID = scheduleId;
             self.activeAssets[scheduleId] = assets;
         }
         return self.activeAssets[scheduleId];
@@ -58,6 +70,8 @@
         for (NSString *filename in fileArray)  {
             [fileManager removeItemAtPath:[rootPath stringByAppendingPathComponent:filename] error:NULL];
         }
+
+        [self.sharedStore removeAll];
     }
 }
 
@@ -66,6 +80,7 @@
         if (wipeFromDisk) {
             UAInAppMessageAssets *assets = [self assetsForScheduleId:scheduleId];
             [assets clearAssets];
+            [self.sharedStore releaseAssetsForScheduleID:scheduleId];
         }
         [self.activeAssets removeObjectForKey:scheduleId];
     }
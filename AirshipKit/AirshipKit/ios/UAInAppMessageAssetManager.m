@@ -11,14 +11,18 @@
 
 @property(nonatomic, strong) UAInAppMessageAssetCache *assetCache;
 @property(nonatomic, strong) NSOperationQueue *queue;
+@property(nonatomic, strong) NSMapTable<NSString *, NSOperation *> *lastOperations;
 
 @end
 
+// Number of schedules whose assets can be prepared at the same time
+static NSInteger const UAInAppMessageAssetManagerMaxConcurrentOperations = 4;
+
 @implementation UAInAppMessageAssetManager
 
 + (instancetype)assetManager {
     NSOperationQueue *queue = [[NSOperationQueue alloc] init];
-    queue.maxConcurrentOperationCount = 1;
+    queue.maxConcurrentOperationCount = UAInAppMessageAssetManagerMaxConcurrentOperations;
     return [self assetManagerWithAssetCache:[UAInAppMessageAssetCache assetCache] operationQueue:queue];
 }
 
@@ -31,11 +35,29 @@
     if (self) {
         self.assetCache = assetCache;
         self.queue = queue;
+        self.lastOperations = [NSMapTable strongToWeakObjectsMapTable];
         self.prepareAssetsDelegate = [[UAInAppMessageDefaultPrepareAssetsDelegate alloc] init];
     }
     return self;
 }
 
+/**
+ * Adds an operation to the queue. Operations for different schedules run concurrently,
+ * but operations for the same schedule run in the order they were added.
+ */
+- (void)addOperation:(NSOperation *)operation scheduleID:(NSString *)scheduleID {
+    @synchronized (self.lastOperations) {
+        NSOperation *previous = [self.lastOperations objectForKey:scheduleID];
+        if (previous) {
+            [operation addDependency:previous];
+        }
+
+        [self.lastOperations setObject:operation forKey:scheduleID];
+    }
+
+    [self.queue addOperation:operation];
+}
+
 - (void)onSchedule:(UASchedule *)schedule {
     UAAsyncOperation *operation = [UAAsyncOperation operationWithBlock:^(UAAsyncOperation *operation) {
         // Get the message for this schedule
@@ -69,7 +91,7 @@
             [operation finish];
         }];
     }];
-    [self.queue addOperation:operation];
+    [self addOperation:operation scheduleID:schedule.identifier];
 }
 
 - (void)onPrepare:(UASchedule *)schedule completionHandler:(void (^)(UAInAppMessagePrepareResult))completionHandler {
@@ -93,7 +115,7 @@
             [operation finish];
         }];
     }];
-    [self.queue addOperation:operation];
+    [self addOperation:operation scheduleID:schedule.identifier];
 }
 
 - (void)onDisplayFinished:(UASchedule *)schedule {
@@ -112,7 +134,7 @@
         [self.assetCache releaseAssets:schedule.identifier wipeFromDisk:!shouldPersistCacheAfterDisplay];
         [operation finish];
     }];
-    [self.queue addOperation:operation];
+    [self addOperation:operation scheduleID:schedule.identifier];
 }
 
 - (void)onScheduleFinished:(UASchedule *)schedule {
@@ -121,7 +143,7 @@
         [self.assetCache releaseAssets:schedule.identifier wipeFromDisk:YES];
         [operation finish];
     }];
-    [self.queue addOperation:operation];
+    [self addOperation:operation scheduleID:schedule.identifier];
 }
 
 - (void)assetsForSchedule:(UASchedule *)schedule completionHandler:(void (^)(UAInAppMessageAssets *))completionHandler {
@@ -130,7 +152,7 @@
         completionHandler([self.assetCache assetsForScheduleId:schedule.identifier]);
         [operation finish];
     }];
-    [self.queue addOperation:operation];
+    [self addOperation:operation scheduleID:schedule.identifier];
 }
 
 @end
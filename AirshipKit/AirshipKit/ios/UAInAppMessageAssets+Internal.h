@@ -4,10 +4,22 @@
 
 #import "UAInAppMessageAssets.h"
 
+@class UAInAppMessageSharedAssetStore;
+
 NS_ASSUME_NONNULL_BEGIN
 
 @interface UAInAppMessageAssets()
 
+/**
+ * The store shared by every schedule's assets, or `nil` if assets are not shared.
+ */
+@property (nonatomic, strong, nullable) UAInAppMessageSharedAssetStore *sharedStore;
+
+/**
+ * The ID of the schedule that owns the assets.
+ */
+@property (nonatomic, copy, nullable) NSString *scheduleID;
+
 /**
  * Factory method.
  *
@@ -5,6 +5,8 @@
 #import "UAInAppMessageBannerDisplayContent.h"
 #import "UAInAppMessageFullScreenDisplayContent.h"
 #import "UAInAppMessageModalDisplayContent.h"
+#import "UAInAppMessageAssets+Internal.h"
+#import "UAInAppMessageSharedAssetStore+Internal.h"
 #import "UAGlobal.h"
 
 @implementation UAInAppMessageDefaultPrepareAssetsDelegate
@@ -32,7 +34,12 @@
         completionHandler(UAInAppMessagePrepareResultCancel);
         return;
     }
-    [self cacheImage:mediaURL cacheURL:cacheURL completionHandler:completionHandler];
+
+    if (assets.sharedStore && assets.scheduleID) {
+        [self cacheSharedImage:mediaURL cacheURL:cacheURL assets:assets completionHandler:completionHandler];
+    } else {
+        [self cacheImage:mediaURL cacheURL:cacheURL completionHandler:completionHandler];
+    }
 }
 
 - (UAInAppMessageMediaInfo *)getMediaInfo:(nonnull UAInAppMessage *)message {
@@ -58,6 +65,43 @@
     return nil;
 }
 
+/**
+ * Fetches the image through the shared asset store and links it into the schedule's assets,
+ * so each image is only downloaded and stored once no matter how many schedules use it.
+ */
+- (void)cacheSharedImage:(NSURL *)assetURL
+                cacheURL:(NSURL *)cacheURL
+                  assets:(UAInAppMessageAssets *)assets
+       completionHandler:(nonnull void (^)(UAInAppMessagePrepareResult))completionHandler {
+    [assets.sharedStore fetchAssetWithURL:assetURL scheduleID:assets.scheduleID completionHandler:^(NSURL *fileURL, NSURLResponse *response, NSError *error) {
+        if (!fileURL) {
+            if (error) {
+                UA_LERR(@"Error prefetching media at URL: %@, %@", assetURL, error.localizedDescription);
+                completionHandler(UAInAppMessagePrepareResultCancel);
+                return;
+            }
+
+            NSInteger status = [response isKindOfClass:[NSHTTPURLResponse class]] ? ((NSHTTPURLResponse *)response).statusCode : 0;
+            completionHandler((status >= 500 && status <= 599) ? UAInAppMessagePrepareResultRetry : UAInAppMessagePrepareResultCancel);
+            return;
+        }
+
+        NSFileManager *fm = [NSFileManager defaultManager];
+        [fm removeItemAtURL:cacheURL error:nil];
+
+        // Hard link so the schedule's copy takes no extra space and outlives an eviction from the shared store
+        NSError *linkError;
+        if (![fm linkItemAtURL:fileURL toURL:cacheURL error:&linkError] &&
+            ![fm copyItemAtURL:fileURL toURL:cacheURL error:&linkError]) {
+            UA_LERR(@"Error linking shared asset %@ to %@: %@", fileURL.path, cacheURL.path, linkError.localizedDescription);
+            completionHandler(UAInAppMessagePrepareResultCancel);
+            return;
+        }
+
+        completionHandler(UAInAppMessagePrepareResultSuccess);
+    }];
+}
+
 - (void)cacheImage:(NSURL *)assetURL cacheURL:(NSURL *)cacheURL completionHandler:(nonnull void (^)(UAInAppMessagePrepareResult))completionHandler {
     [[[NSURLSession sharedSession] downloadTaskWithURL:assetURL completionHandler:^(NSURL * _Nullable temporaryFileLocation, NSURLResponse * _Nullable response, NSError * _Nullable error) {
         if (error) {
@@ -86,6 +86,34 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (UAScheduleInfo *)createScheduleInfoWithBuilder:(UAScheduleInfoBuilder *)builder;
 
+/**
+ * Gets the schedule IDs of remote-data messages, keyed by message ID. The IDs are read
+ * without loading the schedules.
+ *
+ * @param completionHandler The completion handler with the schedule IDs keyed by message ID.
+ */
+- (void)getRemoteDataScheduleIDs:(void (^)(NSDictionary<NSString *, NSString *> *))completionHandler;
+
+/**
+ * The schedule data predicate used to match remote-data messages.
+ *
+ * @returns The predicate.
+ */
++ (NSPredicate *)remoteDataSchedulePredicate;
+
+/**
+ * Edits schedules and schedules new messages in a single store transaction.
+ *
+ * @param edits The edits to apply, keyed by schedule ID.
+ * @param scheduleInfos The schedule info for the new messages.
+ * @param metadata The new schedules' optional metadata.
+ * @param completionHandler The completion handler with the new schedules.
+ */
+- (void)editSchedules:(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *)edits
+     newScheduleInfos:(NSArray<UAInAppMessageScheduleInfo *> *)scheduleInfos
+             metadata:(nullable NSDictionary *)metadata
+    completionHandler:(void (^)(NSArray<UASchedule *> *))completionHandler;
+
 
 @end
 
@@ -37,6 +37,9 @@ NS_ASSUME_NONNULL_BEGIN
 NSTimeInterval const MaxSchedules = 200;
 NSTimeInterval const MessagePrepareRetryDelay = 30;
 
+// Number of schedules that can be prepared at the same time
+NSUInteger const MaxConcurrentPrepares = 4;
+
 NSString *const UAInAppAutomationStoreFileFormat = @"In-app-automation-%@.sqlite";
 NSString *const UAInAppMessageManagerEnabledKey = @"UAInAppMessageManagerEnabled";
 NSString *const UAInAppMessageManagerDisplayIntervalKey = @"UAInAppMessageManagerDisplayInterval";
@@ -181,7 +184,7 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
         self.remoteDataManager = remoteDataManager;
         self.remoteDataClient = [UAInAppRemoteDataClient clientWithScheduler:self remoteDataManager:remoteDataManager dataStore:dataStore channel:channel];
         self.dispatcher = dispatcher;
-        self.prepareSchedulePipeline = [UARetriablePipeline pipeline];
+        self.prepareSchedulePipeline = [UARetriablePipeline pipelineWithMaxConcurrentChains:MaxConcurrentPrepares];
         self.defaultDisplayCoordinator = displayCoordinator;
         self.defaultDisplayCoordinator.displayInterval = self.displayInterval;
         self.immediateDisplayCoordinator = [UAInAppMessageImmediateDisplayCoordinator coordinator];
@@ -275,6 +278,31 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
                           }];
 }
 
+- (void)getRemoteDataScheduleIDs:(void (^)(NSDictionary<NSString *, NSString *> *))completionHandler {
+    // The group is the message ID
+    [self.automationEngine getScheduleIDsByGroupWithPredicate:[UAInAppMessageManager remoteDataSchedulePredicate]
+                                            completionHandler:completionHandler];
+}
+
++ (NSPredicate *)remoteDataSchedulePredicate {
+    // Schedule data is the message JSON, its source is stored in an indexed attribute
+    return [NSPredicate predicateWithFormat:@"source == %@", UAInAppMessageSourceRemoteDataValue];
+}
+
+- (void)editSchedules:(NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *)edits
+     newScheduleInfos:(NSArray<UAInAppMessageScheduleInfo *> *)scheduleInfos
+             metadata:(nullable NSDictionary *)metadata
+    completionHandler:(void (^)(NSArray<UASchedule *> *))completionHandler {
+    [self.automationEngine editSchedules:edits
+                        newScheduleInfos:scheduleInfos
+                                metadata:metadata
+                       completionHandler:^(NSArray<UASchedule *> *schedules) {
+                           // Schedule the assets
+                           [self scheduleAssets:schedules];
+                           completionHandler(schedules);
+                       }];
+}
+
 - (void)scheduleAssets:(NSArray<UASchedule *> *)schedules {
     for (UASchedule *schedule in schedules) {
         [self.assetManager onSchedule:schedule];
@@ -319,11 +347,27 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
     }
 
     id<UAInAppMessageAdapterProtocol> adapter = factory(message);
-    [self.adapters setObject:adapter forKey:scheduleID];
+
+    // Schedules are prepared concurrently
+    @synchronized (self.adapters) {
+        [self.adapters setObject:adapter forKey:scheduleID];
+    }
 
     return adapter;
 }
 
+- (nullable id<UAInAppMessageAdapterProtocol>)adapterForScheduleID:(NSString *)scheduleID {
+    @synchronized (self.adapters) {
+        return self.adapters[scheduleID];
+    }
+}
+
+- (void)removeAdapterForScheduleID:(NSString *)scheduleID {
+    @synchronized (self.adapters) {
+        [self.adapters removeObjectForKey:scheduleID];
+    }
+}
+
 - (UARetriable *)adapterRetriableWithMessage:(UAInAppMessage *)message scheduleID:(NSString *)scheduleID resultHandler:(UARetriableCompletionHandler)resultHandler {
     UA_WEAKIFY(self)
     return [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler handler) {
@@ -420,7 +464,7 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
     return [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler handler) {
         UA_STRONGIFY(self)
 
-        id<UAInAppMessageAdapterProtocol> adapter = self.adapters[schedule.identifier];
+        id<UAInAppMessageAdapterProtocol> adapter = [self adapterForScheduleID:schedule.identifier];
 
         if (!adapter) {
             handler(UARetriableResultCancel);
@@ -621,7 +665,7 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
 
     if ([self isScheduleInvalid:schedule]) {
         UA_LTRACE(@"Metadata is out of date, invalidating schedule with id: %@ until refresh can occur.", schedule.identifier);
-        [self.adapters removeObjectForKey:schedule.identifier];
+        [self removeAdapterForScheduleID:schedule.identifier];
         return UAAutomationScheduleReadyResultInvalidate;
     }
 
@@ -685,7 +729,7 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
         UA_STRONGIFY(self);
         UA_LDEBUG(@"Schedule %@ finished displaying", schedule.identifier);
 
-        [self.adapters removeObjectForKey:schedule.identifier];
+        [self removeAdapterForScheduleID:schedule.identifier];
 
         // Resolution event
         [timer stop];
@@ -48,6 +48,15 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (instancetype)mediaViewWithMediaInfo:(UAInAppMessageMediaInfo *)mediaInfo imageData:(NSData *)imageData;
 
+/**
+ * Factory method for creating an in-app message media view with an image that has already
+ * been decoded, so displaying the view does not decode the image on the main thread.
+ *
+ * @param mediaInfo The media info.
+ * @param image The decoded image.
+ */
++ (instancetype)mediaViewWithMediaInfo:(UAInAppMessageMediaInfo *)mediaInfo image:(UIImage *)image;
+
 
 
 @end
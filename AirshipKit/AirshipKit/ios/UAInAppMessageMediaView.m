@@ -36,17 +36,35 @@ CGFloat const DefaultVideoAspectRatio = 16.0/9.0;
     return [[self alloc] initWithMediaInfo:mediaInfo imageData:imageData];
 }
 
++ (instancetype)mediaViewWithMediaInfo:(UAInAppMessageMediaInfo *)mediaInfo image:(UIImage *)image {
+    return [[self alloc] initWithMediaInfo:mediaInfo image:image];
+}
+
 - (instancetype)initWithMediaInfo:(UAInAppMessageMediaInfo *)mediaInfo imageData:(nullable NSData *)imageData {
-    self = [super init];
+    if ([UAInAppMessageUtils isGifData:imageData]) {
+        self = [super init];
 
-    if (self) {
-        if ([UAInAppMessageUtils isGifData:imageData]) {
+        if (self) {
             [self setUpWebBasedMediaView:mediaInfo];
             self.webView.contentMode = UIViewContentModeScaleAspectFit;
             [self.webView setBackgroundColor:[UIColor clearColor]];
             [self.webView.scrollView setBackgroundColor:[UIColor clearColor]];
             [self.webView loadData:imageData MIMEType:@"image/gif" characterEncodingName:@"UTF-8" baseURL:[NSURL URLWithString:self.mediaInfo.url]];
-        } else if (imageData) {
+        }
+
+        return self;
+    }
+
+    UIImage *image = imageData ? [UIImage imageWithData:imageData] : nil;
+    return [self initWithMediaInfo:mediaInfo image:image];
+}
+
+- (instancetype)initWithMediaInfo:(UAInAppMessageMediaInfo *)mediaInfo image:(nullable UIImage *)image {
+    self = [super init];
+
+    if (self) {
+        if (image) {
+            self.mediaInfo = mediaInfo;
             self.translatesAutoresizingMaskIntoConstraints = NO;
             self.webView = nil;
             self.mediaContainer = [[UIView alloc] init];
@@ -57,7 +75,6 @@ CGFloat const DefaultVideoAspectRatio = 16.0/9.0;
 
             self.imageView = [[UIImageView alloc] initWithFrame:self.frame];
             [self.mediaContainer addSubview:self.imageView];
-            UIImage *image = [UIImage imageWithData:imageData];
             [self.imageView setImage:image];
             [UAViewUtils applyContainerConstraintsToContainer:self.mediaContainer containedView:self.imageView];
 
@@ -82,7 +82,7 @@ NSString *const UAInAppMessageResolutionEventExpired = @"expired";
     NSMutableDictionary *resolutionData = [NSMutableDictionary dictionary];
     [resolutionData setValue:UAInAppMessageResolutionEventExpired forKey:UAInAppMessageResolutionEventTypeKey];
 
-    NSDateFormatter *formatter = [UAUtils ISODateFormatterUTCWithDelimiter];
+    NSDateFormatter *formatter = [UAUtils sharedISODateFormatterUTCWithDelimiter];
     [resolutionData setValue:[formatter stringFromDate:expiredDate] forKey:UAInAppMessageResolutionEventExpiryKey];
 
     NSMutableDictionary *data = [UAInAppMessageEventUtils createDataForMessage:message];
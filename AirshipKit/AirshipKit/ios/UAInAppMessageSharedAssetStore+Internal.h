@@ -0,0 +1,97 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Default byte budget for the shared asset store.
+ */
+extern NSUInteger const UAInAppMessageSharedAssetStoreDefaultByteBudget;
+
+/**
+ * Content addressed store for in-app message assets that is shared by every schedule.
+ *
+ * Assets are stored once per URL, keyed by the SHA-256 hash of the URL, and reference counted
+ * by the schedules that use them. Assets no longer used by any schedule are evicted least recently
+ * used first once the store grows past its byte budget. Concurrent fetches of the same URL share
+ * a single download.
+ */
+@interface UAInAppMessageSharedAssetStore : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Shared Asset Store Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The maximum number of bytes kept for assets that are not used by any schedule.
+ * Assets in use by a schedule are never evicted.
+ */
+@property (atomic, assign) NSUInteger byteBudget;
+
+/**
+ * The total size of the stored assets in bytes.
+ */
+@property (readonly) NSUInteger totalBytes;
+
+///---------------------------------------------------------------------------------------
+/// @name Shared Asset Store Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @param rootURL The directory in which to store the assets.
+ * @param byteBudget The byte budget.
+ * @return The store, or `nil` if the directory could not be created.
+ */
++ (nullable instancetype)storeWithRootURL:(NSURL *)rootURL byteBudget:(NSUInteger)byteBudget;
+
+/**
+ * Factory method. Use for testing.
+ *
+ * @param rootURL The directory in which to store the assets.
+ * @param byteBudget The byte budget.
+ * @param session The URL session used to download assets.
+ * @return The store, or `nil` if the directory could not be created.
+ */
++ (nullable instancetype)storeWithRootURL:(NSURL *)rootURL byteBudget:(NSUInteger)byteBudget session:(NSURLSession *)session;
+
+/**
+ * Returns the stored asset for a URL and adds a reference to it for the schedule.
+ *
+ * @param assetURL The asset URL.
+ * @param scheduleID The schedule ID.
+ * @return The file URL of the stored asset, or `nil` if the asset is not stored.
+ */
+- (nullable NSURL *)retainAssetWithURL:(NSURL *)assetURL scheduleID:(NSString *)scheduleID;
+
+/**
+ * Fetches the asset for a URL, downloading it if it is not already stored, and adds a reference
+ * to it for the schedule. Fetches of a URL that is already being downloaded wait for that download.
+ *
+ * @param assetURL The asset URL.
+ * @param scheduleID The schedule ID.
+ * @param completionHandler The completion handler called with the file URL of the stored asset, or `nil`
+ * along with the response or error if the asset could not be downloaded.
+ */
+- (void)fetchAssetWithURL:(NSURL *)assetURL
+               scheduleID:(NSString *)scheduleID
+        completionHandler:(void (^)(NSURL * _Nullable fileURL, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler;
+
+/**
+ * Removes the schedule's references to its assets. Assets no longer used by any
+ * schedule are kept until they are evicted.
+ *
+ * @param scheduleID The schedule ID.
+ */
+- (void)releaseAssetsForScheduleID:(NSString *)scheduleID;
+
+/**
+ * Removes all assets.
+ */
+- (void)removeAll;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,363 @@
+/* Copyright Airship and Contributors */
+
+#import "UAInAppMessageSharedAssetStore+Internal.h"
+#import "UAUtils+Internal.h"
+#import "UAGlobal.h"
+
+NSUInteger const UAInAppMessageSharedAssetStoreDefaultByteBudget = 50 * 1024 * 1024;
+
+static NSString * const UAInAppMessageSharedAssetStoreIndexFilename = @"index.plist";
+static NSString * const UAInAppMessageSharedAssetSizeKey = @"size";
+static NSString * const UAInAppMessageSharedAssetLastAccessKey = @"last_access";
+static NSString * const UAInAppMessageSharedAssetScheduleIDsKey = @"schedule_ids";
+
+/**
+ * A stored asset.
+ */
+@interface UAInAppMessageSharedAsset : NSObject
+@property (nonatomic, assign) NSUInteger size;
+@property (nonatomic, assign) NSTimeInterval lastAccess;
+@property (nonatomic, strong) NSMutableSet<NSString *> *scheduleIDs;
+@end
+
+@implementation UAInAppMessageSharedAsset
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        self.scheduleIDs = [NSMutableSet set];
+        self.lastAccess = [NSDate date].timeIntervalSince1970;
+    }
+    return self;
+}
+
+@end
+
+/**
+ * A fetch waiting on a download.
+ */
+@interface UAInAppMessageSharedAssetRequest : NSObject
+@property (nonatomic, copy) NSString *scheduleID;
+@property (nonatomic, copy) void (^completionHandler)(NSURL *, NSURLResponse *, NSError *);
+@end
+
+@implementation UAInAppMessageSharedAssetRequest
+@end
+
+@interface UAInAppMessageSharedAssetStore() {
+    NSUInteger _totalBytes;
+}
+
+@property (nonatomic, strong) NSURL *rootURL;
+@property (nonatomic, strong) NSURLSession *session;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAInAppMessageSharedAsset *> *assets;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<UAInAppMessageSharedAssetRequest *> *> *pendingRequests;
+@end
+
+@implementation UAInAppMessageSharedAssetStore
+
+- (instancetype)initWithRootURL:(NSURL *)rootURL byteBudget:(NSUInteger)byteBudget session:(NSURLSession *)session {
+    self = [super init];
+
+    if (self) {
+        self.rootURL = rootURL;
+        self.byteBudget = byteBudget;
+        self.session = session;
+        self.assets = [NSMutableDictionary dictionary];
+        self.pendingRequests = [NSMutableDictionary dictionary];
+
+        if (![self createRootDirectory]) {
+            return nil;
+        }
+
+        [self loadIndex];
+    }
+
+    return self;
+}
+
++ (instancetype)storeWithRootURL:(NSURL *)rootURL byteBudget:(NSUInteger)byteBudget {
+    return [[self alloc] initWithRootURL:rootURL byteBudget:byteBudget session:[NSURLSession sharedSession]];
+}
+
++ (instancetype)storeWithRootURL:(NSURL *)rootURL byteBudget:(NSUInteger)byteBudget session:(NSURLSession *)session {
+    return [[self alloc] initWithRootURL:rootURL byteBudget:byteBudget session:session];
+}
+
+- (NSUInteger)totalBytes {
+    @synchronized (self) {
+        return _totalBytes;
+    }
+}
+
+- (NSURL *)retainAssetWithURL:(NSURL *)assetURL scheduleID:(NSString *)scheduleID {
+    NSString *key = [UAUtils sha256HashWithString:assetURL.absoluteString];
+
+    @synchronized (self) {
+        UAInAppMessageSharedAsset *asset = self.assets[key];
+        if (!asset) {
+            return nil;
+        }
+
+        NSURL *fileURL = [self fileURLForKey:key];
+        if (![[NSFileManager defaultManager] fileExistsAtPath:fileURL.path]) {
+            // Removed out from under the store
+            [self removeAssetForKey:key];
+            [self saveIndex];
+            return nil;
+        }
+
+        asset.lastAccess = [NSDate date].timeIntervalSince1970;
+        if (![asset.scheduleIDs containsObject:scheduleID]) {
+            [asset.scheduleIDs addObject:scheduleID];
+            [self saveIndex];
+        }
+
+        return fileURL;
+    }
+}
+
+- (void)fetchAssetWithURL:(NSURL *)assetURL
+               scheduleID:(NSString *)scheduleID
+        completionHandler:(void (^)(NSURL *, NSURLResponse *, NSError *))completionHandler {
+    NSString *key = [UAUtils sha256HashWithString:assetURL.absoluteString];
+
+    UAInAppMessageSharedAssetRequest *request = [[UAInAppMessageSharedAssetRequest alloc] init];
+    request.scheduleID = scheduleID;
+    request.completionHandler = completionHandler;
+
+    NSURL *fileURL;
+    @synchronized (self) {
+        fileURL = [self retainAssetWithURL:assetURL scheduleID:scheduleID];
+
+        if (!fileURL) {
+            NSMutableArray<UAInAppMessageSharedAssetRequest *> *requests = self.pendingRequests[key];
+            if (requests) {
+                // Already downloading
+                [requests addObject:request];
+                return;
+            }
+
+            self.pendingRequests[key] = [NSMutableArray arrayWithObject:request];
+        }
+    }
+
+    if (fileURL) {
+        completionHandler(fileURL, nil, nil);
+        return;
+    }
+
+    UA_WEAKIFY(self);
+    [[self.session downloadTaskWithURL:assetURL completionHandler:^(NSURL *temporaryFileLocation, NSURLResponse *response, NSError *error) {
+        UA_STRONGIFY(self);
+        [self finishDownloadForKey:key temporaryFileLocation:temporaryFileLocation response:response error:error];
+    }] resume];
+}
+
+- (void)finishDownloadForKey:(NSString *)key
+       temporaryFileLocation:(NSURL *)temporaryFileLocation
+                    response:(NSURLResponse *)response
+                       error:(NSError *)error {
+    BOOL success = !error && temporaryFileLocation;
+    if (success && [response isKindOfClass:[NSHTTPURLResponse class]]) {
+        success = ((NSHTTPURLResponse *)response).statusCode == 200;
+    }
+
+    NSURL *fileURL;
+    NSArray<UAInAppMessageSharedAssetRequest *> *requests;
+
+    @synchronized (self) {
+        if (success) {
+            fileURL = [self storeFileAtURL:temporaryFileLocation forKey:key];
+        }
+
+        requests = self.pendingRequests[key] ?: @[];
+        [self.pendingRequests removeObjectForKey:key];
+
+        UAInAppMessageSharedAsset *asset = fileURL ? self.assets[key] : nil;
+        for (UAInAppMessageSharedAssetRequest *request in requests) {
+            [asset.scheduleIDs addObject:request.scheduleID];
+        }
+
+        if (asset) {
+            [self evictIfNeeded];
+            [self saveIndex];
+        }
+    }
+
+    for (UAInAppMessageSharedAssetRequest *request in requests) {
+        request.completionHandler(fileURL, response, error);
+    }
+}
+
+- (void)releaseAssetsForScheduleID:(NSString *)scheduleID {
+    @synchronized (self) {
+        BOOL changed = NO;
+        for (UAInAppMessageSharedAsset *asset in self.assets.allValues) {
+            if ([asset.scheduleIDs containsObject:scheduleID]) {
+                [asset.scheduleIDs removeObject:scheduleID];
+                changed = YES;
+            }
+        }
+
+        if (changed) {
+            [self evictIfNeeded];
+            [self saveIndex];
+        }
+    }
+}
+
+- (void)removeAll {
+    @synchronized (self) {
+        [[NSFileManager defaultManager] removeItemAtURL:self.rootURL error:nil];
+        [self.assets removeAllObjects];
+        _totalBytes = 0;
+        [self createRootDirectory];
+    }
+}
+
+#pragma mark -
+#pragma mark Storage
+
+- (NSURL *)fileURLForKey:(NSString *)key {
+    return [self.rootURL URLByAppendingPathComponent:key];
+}
+
+- (NSURL *)storeFileAtURL:(NSURL *)temporaryFileLocation forKey:(NSString *)key {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSURL *fileURL = [self fileURLForKey:key];
+
+    // The root directory may have been removed by clearing the asset cache
+    [self createRootDirectory];
+
+    if (self.assets[key]) {
+        [self removeAssetForKey:key];
+    } else {
+        [fileManager removeItemAtURL:fileURL error:nil];
+    }
+
+    NSError *error;
+    if (![fileManager moveItemAtURL:temporaryFileLocation toURL:fileURL error:&error]) {
+        UA_LERR(@"Error moving temp file %@ to %@: %@", temporaryFileLocation.path, fileURL.path, error.localizedDescription);
+        return nil;
+    }
+
+    NSDictionary *attributes = [fileManager attributesOfItemAtPath:fileURL.path error:nil];
+
+    UAInAppMessageSharedAsset *asset = [[UAInAppMessageSharedAsset alloc] init];
+    asset.size = (NSUInteger)[attributes fileSize];
+    self.assets[key] = asset;
+    _totalBytes += asset.size;
+
+    return fileURL;
+}
+
+- (void)removeAssetForKey:(NSString *)key {
+    UAInAppMessageSharedAsset *asset = self.assets[key];
+    if (!asset) {
+        return;
+    }
+
+    [[NSFileManager defaultManager] removeItemAtURL:[self fileURLForKey:key] error:nil];
+    [self.assets removeObjectForKey:key];
+    _totalBytes -= MIN(_totalBytes, asset.size);
+}
+
+/**
+ * Removes assets not used by any schedule, least recently used first, until the store is within its budget.
+ */
+- (void)evictIfNeeded {
+    NSUInteger byteBudget = self.byteBudget;
+    if (_totalBytes <= byteBudget) {
+        return;
+    }
+
+    NSMutableArray<NSString *> *unusedKeys = [NSMutableArray array];
+    for (NSString *key in self.assets) {
+        if (!self.assets[key].scheduleIDs.count) {
+            [unusedKeys addObject:key];
+        }
+    }
+
+    [unusedKeys sortUsingComparator:^NSComparisonResult(NSString *key1, NSString *key2) {
+        return [@(self.assets[key1].lastAccess) compare:@(self.assets[key2].lastAccess)];
+    }];
+
+    for (NSString *key in unusedKeys) {
+        if (_totalBytes <= byteBudget) {
+            break;
+        }
+
+        UA_LTRACE(@"Evicting in-app message asset %@", key);
+        [self removeAssetForKey:key];
+    }
+}
+
+- (BOOL)createRootDirectory {
+    NSError *error;
+    [[NSFileManager defaultManager] createDirectoryAtURL:self.rootURL withIntermediateDirectories:YES attributes:nil error:&error];
+    if (error) {
+        UA_LERR(@"Unable to create shared assets directory at %@", self.rootURL);
+        return NO;
+    }
+    return YES;
+}
+
+#pragma mark -
+#pragma mark Index
+
+- (NSURL *)indexURL {
+    return [self.rootURL URLByAppendingPathComponent:UAInAppMessageSharedAssetStoreIndexFilename];
+}
+
+- (void)loadIndex {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSDictionary *index;
+
+    NSData *data = [NSData dataWithContentsOfURL:[self indexURL]];
+    if (data) {
+        index = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:nil];
+    }
+
+    if ([index isKindOfClass:[NSDictionary class]]) {
+        for (NSString *key in index) {
+            NSDictionary *entry = index[key];
+            if (![entry isKindOfClass:[NSDictionary class]] || ![fileManager fileExistsAtPath:[self fileURLForKey:key].path]) {
+                continue;
+            }
+
+            UAInAppMessageSharedAsset *asset = [[UAInAppMessageSharedAsset alloc] init];
+            asset.size = [entry[UAInAppMessageSharedAssetSizeKey] unsignedIntegerValue];
+            asset.lastAccess = [entry[UAInAppMessageSharedAssetLastAccessKey] doubleValue];
+            [asset.scheduleIDs addObjectsFromArray:entry[UAInAppMessageSharedAssetScheduleIDsKey] ?: @[]];
+
+            self.assets[key] = asset;
+            _totalBytes += asset.size;
+        }
+    }
+
+    // Remove any files the index does not know about
+    for (NSString *filename in [fileManager contentsOfDirectoryAtPath:self.rootURL.path error:nil]) {
+        if (!self.assets[filename] && ![filename isEqualToString:UAInAppMessageSharedAssetStoreIndexFilename]) {
+            [fileManager removeItemAtURL:[self fileURLForKey:filename] error:nil];
+        }
+    }
+}
+
+- (void)saveIndex {
+    NSMutableDictionary *index = [NSMutableDictionary dictionaryWithCapacity:self.assets.count];
+    for (NSString *key in self.assets) {
+        UAInAppMessageSharedAsset *asset = self.assets[key];
+        index[key] = @{ UAInAppMessageSharedAssetSizeKey : @(asset.size),
+                        UAInAppMessageSharedAssetLastAccessKey : @(asset.lastAccess),
+                        UAInAppMessageSharedAssetScheduleIDsKey : asset.scheduleIDs.allObjects };
+    }
+
+    NSError *error;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:index format:NSPropertyListBinaryFormat_v1_0 options:0 error:&error];
+    if (!data || ![data writeToURL:[self indexURL] options:NSDataWritingAtomic error:&error]) {
+        UA_LERR(@"Unable to save shared asset index: %@", error);
+    }
+}
+
+@end
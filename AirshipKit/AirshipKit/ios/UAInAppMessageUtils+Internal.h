@@ -107,5 +107,24 @@
  */
 + (BOOL)isGifData:(NSData *)data;
 
+/**
+ * Decodes image data into a bitmap, downsampling it so its longest side is at most `maxPixelSize` pixels.
+ * The returned image keeps the point size of the original image and can be drawn without further decoding.
+ * Safe to call from any thread.
+ *
+ * @param data The image data.
+ * @param maxPixelSize The maximum size in pixels of the longest side of the decoded image.
+ * @return The decoded image, or `nil` if the data could not be decoded.
+ */
++ (UIImage *)decodedImageWithData:(NSData *)data maxPixelSize:(CGFloat)maxPixelSize;
+
+/**
+ * The maximum size in pixels at which in-app message images are displayed on the main screen.
+ * Must be called on the main thread.
+ *
+ * @return The longest side of the main screen in pixels.
+ */
++ (CGFloat)maxImagePixelSize;
+
 
 @end
@@ -9,6 +9,8 @@
 #import "UADispatcher+Internal.h"
 #import "UAInAppMessageAssets.h"
 
+#import <ImageIO/ImageIO.h>
+
 NSString *const UADefaultSerifFont = @"Times New Roman";
 NSString *const UAInAppMessageAdapterCacheName = @"UAInAppMessageAdapterCache";
 
@@ -234,6 +236,46 @@ CGFloat const CloseButtonHeight = 30;
     return isGifData;
 }
 
++ (UIImage *)decodedImageWithData:(NSData *)data maxPixelSize:(CGFloat)maxPixelSize {
+    NSDictionary *sourceOptions = @{ (__bridge NSString *)kCGImageSourceShouldCache : @NO };
+    CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef)data, (__bridge CFDictionaryRef)sourceOptions);
+    if (!source) {
+        return nil;
+    }
+
+    NSDictionary *properties = (__bridge_transfer NSDictionary *)CGImageSourceCopyPropertiesAtIndex(source, 0, NULL);
+    CGFloat pixelWidth = [properties[(__bridge NSString *)kCGImagePropertyPixelWidth] doubleValue];
+    CGFloat pixelHeight = [properties[(__bridge NSString *)kCGImagePropertyPixelHeight] doubleValue];
+
+    // Decodes the downsampled bitmap immediately instead of when it is first drawn
+    NSDictionary *thumbnailOptions = @{ (__bridge NSString *)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+                                        (__bridge NSString *)kCGImageSourceCreateThumbnailWithTransform : @YES,
+                                        (__bridge NSString *)kCGImageSourceShouldCacheImmediately : @YES,
+                                        (__bridge NSString *)kCGImageSourceThumbnailMaxPixelSize : @(MAX(maxPixelSize, 1)) };
+
+    CGImageRef imageRef = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)thumbnailOptions);
+    CFRelease(source);
+
+    if (!imageRef) {
+        return nil;
+    }
+
+    // Scale the bitmap so the image keeps the point size of the original
+    CGFloat decodedSize = MAX(CGImageGetWidth(imageRef), CGImageGetHeight(imageRef));
+    CGFloat originalSize = MAX(pixelWidth, pixelHeight);
+    CGFloat scale = (decodedSize > 0 && originalSize > decodedSize) ? decodedSize / originalSize : 1;
+
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+
+    return image;
+}
+
++ (CGFloat)maxImagePixelSize {
+    UIScreen *screen = [UIScreen mainScreen];
+    return MAX(screen.bounds.size.width, screen.bounds.size.height) * screen.scale;
+}
+
 + (NSDictionary *)attributesWithTextInfo:(UAInAppMessageTextInfo *)textInfo textStyle:(UAInAppMessageTextStyle *)style {
     NSMutableDictionary *attributes = [NSMutableDictionary dictionary];
 
@@ -365,13 +407,30 @@ CGFloat const CloseButtonHeight = 30;
     }
 
     NSURL *cacheURL = [assets getCacheURL:mediaURL];
-    NSData *data =  [[NSFileManager defaultManager] contentsAtPath:[cacheURL path]];
-    if (data) {
-        UAInAppMessageMediaView *mediaView = [UAInAppMessageMediaView mediaViewWithMediaInfo:media imageData:data];
-        completionHandler(UAInAppMessagePrepareResultSuccess, mediaView);
-    } else {
-        completionHandler(UAInAppMessagePrepareResultInvalidate, nil);
-    }
+    CGFloat maxPixelSize = [self maxImagePixelSize];
+
+    // Read and decode the image in the background so displaying the message only attaches the bitmap
+    [[UADispatcher backgroundDispatcher] dispatchAsync:^{
+        NSData *data = cacheURL ? [[NSFileManager defaultManager] contentsAtPath:[cacheURL path]] : nil;
+        BOOL isGif = [self isGifData:data];
+        UIImage *image = (data && !isGif) ? [self decodedImageWithData:data maxPixelSize:maxPixelSize] : nil;
+
+        [[UADispatcher mainDispatcher] dispatchAsync:^{
+            if (!data) {
+                completionHandler(UAInAppMessagePrepareResultInvalidate, nil);
+                return;
+            }
+
+            UAInAppMessageMediaView *mediaView;
+            if (image) {
+                mediaView = [UAInAppMessageMediaView mediaViewWithMediaInfo:media image:image];
+            } else {
+                mediaView = [UAInAppMessageMediaView mediaViewWithMediaInfo:media imageData:data];
+            }
+
+            completionHandler(UAInAppMessagePrepareResultSuccess, mediaView);
+        }];
+    }];
 }
 
 + (BOOL)isReadyToDisplayWithMedia:(UAInAppMessageMediaInfo *)media {
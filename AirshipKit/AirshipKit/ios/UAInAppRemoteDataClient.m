@@ -9,7 +9,7 @@
 #import "UAUtils+Internal.h"
 #import "UAGlobal.h"
 #import "UAInAppMessageScheduleInfo+Internal.h"
-#import "UAInAppMessageManager.h"
+#import "UAInAppMessageManager+Internal.h"
 #import "UAInAppMessageAudienceChecks+Internal.h"
 #import "UAChannel.h"
 #import "UAInAppMessage+Internal.h"
@@ -107,22 +107,10 @@ NSString * const UAInAppMessagesScheduledNewUserCutoffTimeKey = @"UAInAppRemoteD
     BOOL isMetadataCurrent = [thisPayloadMetadata isEqualToDictionary:lastMetadata];
     
     // generate messageId to scheduleId map for existing schedules
-    NSMutableDictionary<NSString *, NSString *> *scheduleIDMap = [NSMutableDictionary dictionary];
+    __block NSDictionary<NSString *, NSString *> *scheduleIDMap = @{};
     dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
-    [self.inAppMessageManager getAllSchedules:^(NSArray<UASchedule *> *schedules) {
-        for (UASchedule *schedule in schedules) {
-            UAInAppMessage *message = (UAInAppMessage *)((UAInAppMessageScheduleInfo *)schedule.info).message;
-            if (message.source != UAInAppMessageSourceRemoteData) {
-                continue;
-            }
-            
-            NSString *messageID = message.identifier;
-            if (!messageID.length) {
-                continue;
-            }
-            
-            scheduleIDMap[messageID] = schedule.identifier;
-        }
+    [self.inAppMessageManager getRemoteDataScheduleIDs:^(NSDictionary<NSString *, NSString *> *scheduleIDs) {
+        scheduleIDMap = scheduleIDs;
         dispatch_semaphore_signal(semaphore);
     }];
     dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
@@ -148,9 +136,7 @@ NSString * const UAInAppMessagesScheduledNewUserCutoffTimeKey = @"UAInAppRemoteD
     
     NSMutableArray<NSString *> *messageIDs = [NSMutableArray array];
     NSMutableArray<UAInAppMessageScheduleInfo *> *newSchedules = [NSMutableArray array];
-
-    // Dispatch group
-    dispatch_group_t dispatchGroup = dispatch_group_create();
+    NSMutableDictionary<NSString *, UAInAppMessageScheduleEdits *> *scheduleEdits = [NSMutableDictionary dictionary];
 
     // Validate messages and create new schedules
     for (NSDictionary *message in messages) {
@@ -209,15 +195,7 @@ NSString * const UAInAppMessagesScheduledNewUserCutoffTimeKey = @"UAInAppRemoteD
                 continue;
             }
 
-            dispatch_group_enter(dispatchGroup);
-            [self.inAppMessageManager editScheduleWithID:scheduleIDMap[messageID]
-                                                   edits:edits
-                                       completionHandler:^(UASchedule *schedule) {
-                                           dispatch_group_leave(dispatchGroup);
-                                           if (schedule) {
-                                               UA_LTRACE("Updated in-app message: %@", messageID);
-                                           }
-                                       }];
+            scheduleEdits[scheduleIDMap[messageID]] = edits;
         }
     }
 
@@ -236,30 +214,23 @@ NSString * const UAInAppMessagesScheduledNewUserCutoffTimeKey = @"UAInAppRemoteD
         }];
 
         for (NSString *messageID in deletedMessageIDs) {
-            dispatch_group_enter(dispatchGroup);
-            [self.inAppMessageManager editScheduleWithID:scheduleIDMap[messageID]
-                                                     edits:edits
-                                         completionHandler:^(UASchedule *schedule) {
-                                             dispatch_group_leave(dispatchGroup);
-                                             if (schedule) {
-                                                 UA_LTRACE("Ended in-app message: %@", messageID);
-                                             }
-                                         }];
+            scheduleEdits[scheduleIDMap[messageID]] = edits;
         }
     }
 
-    // New messages
-    if (newSchedules.count) {
-        dispatch_group_enter(dispatchGroup);
-
-        [self.inAppMessageManager scheduleMessagesWithScheduleInfo:newSchedules metadata:thisPayloadMetadata completionHandler:^(NSArray<UASchedule *> *schedules) {
-            dispatch_group_leave(dispatchGroup);
-        }];
+    // Apply the edits and new messages in a single batch
+    if (scheduleEdits.count || newSchedules.count) {
+        [self.inAppMessageManager editSchedules:scheduleEdits
+                               newScheduleInfos:newSchedules
+                                       metadata:thisPayloadMetadata
+                              completionHandler:^(NSArray<UASchedule *> *schedules) {
+                                  UA_LTRACE(@"Updated %lu and scheduled %lu in-app messages", (unsigned long)scheduleEdits.count, (unsigned long)schedules.count);
+                                  dispatch_semaphore_signal(semaphore);
+                              }];
+
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
     }
 
-    // Wait for everything to finish
-    dispatch_group_wait(dispatchGroup,  DISPATCH_TIME_FOREVER);
-
     // Save state
     self.lastPayloadMetadata = thisPayloadMetadata;
     [self.dataStore setObject:thisPayloadTimeStamp forKey:UAInAppMessagesLastPayloadTimeStampKey];
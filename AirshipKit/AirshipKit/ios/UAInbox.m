@@ -20,7 +20,7 @@
     self = [super initWithDataStore:dataStore];
     if (self) {
         self.user = user;
-        self.client = [UAInboxAPIClient clientWithConfig:config session:[UARequestSession sessionWithConfig:config] user:user dataStore:dataStore];
+        self.client = [UAInboxAPIClient clientWithConfig:config session:[UARequestSession sessionWithConfig:config priority:UARequestPriorityRemoteData] user:user dataStore:dataStore];
         self.client.enabled = self.componentEnabled;
         self.messageList = [UAInboxMessageList messageListWithUser:self.user client:self.client config:config];
         self.appStateTracker = [UAAppStateTrackerFactory tracker];
@@ -121,6 +121,8 @@
         // no longer in the response.
         NSMutableSet *newMessageIDs = [NSMutableSet set];
 
+        NSDictionary<NSString *, UAInboxMessageData *> *existingMessages = [self fetchMessagesByID];
+
         for (NSDictionary *messagePayload in messages) {
             NSString *messageID = messagePayload[@"message_id"];
 
@@ -129,10 +131,7 @@
                 continue;
             }
 
-            if (![self updateMessageWithDictionary:messagePayload]) {
-                [self addMessageFromDictionary:messagePayload];
-            }
-
+            [self upsertMessage:existingMessages[messageID] withDictionary:messagePayload];
             [newMessageIDs addObject:messageID];
         }
 
@@ -152,16 +151,58 @@
             [self.managedContext executeRequest:deleteRequest error:&error];
         }
 
-        completionHandler([self.managedContext safeSave]);
+        completionHandler(self.managedContext.hasChanges ? [self.managedContext safeSave] : YES);
     }];
 }
 
-- (void)updateMessageData:(UAInboxMessageData *)data withDictionary:(NSDictionary *)dict {
+/**
+ * Fetches every stored message in a single request, keyed by message ID.
+ */
+- (NSDictionary<NSString *, UAInboxMessageData *> *)fetchMessagesByID {
+    NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:kUAInboxDBEntityName];
+    request.returnsObjectsAsFaults = NO;
+
+    NSError *error = nil;
+    NSArray<UAInboxMessageData *> *resultData = [self.managedContext executeFetchRequest:request error:&error];
+
+    if (error) {
+        UA_LERR(@"Fetch request %@ failed with with error: %@", request, error);
+    }
+
+    NSMutableDictionary *messagesByID = [NSMutableDictionary dictionaryWithCapacity:resultData.count];
+    for (UAInboxMessageData *data in resultData) {
+        if (data.messageID) {
+            messagesByID[data.messageID] = data;
+        }
+    }
+
+    return messagesByID;
+}
+
+/**
+ * Inserts the message if `data` is nil, otherwise updates it if its raw message object changed.
+ */
+- (void)upsertMessage:(UAInboxMessageData *)data withDictionary:(NSDictionary *)dict {
+    dict = [self messageDictionaryWithoutNulls:dict];
+
+    if (!data) {
+        data = (UAInboxMessageData *)[NSEntityDescription insertNewObjectForEntityForName:kUAInboxDBEntityName
+                                                                   inManagedObjectContext:self.managedContext];
+    } else if ([data.rawMessageObject isEqual:dict]) {
+        // Unchanged, avoid dirtying the context
+        return;
+    }
+
+    [self updateMessageData:data withDictionary:dict];
+}
 
-    dict = [dict dictionaryWithValuesForKeys:[[dict keysOfEntriesPassingTest:^BOOL(id key, id obj, BOOL *stop) {
+- (NSDictionary *)messageDictionaryWithoutNulls:(NSDictionary *)dict {
+    return [dict dictionaryWithValuesForKeys:[[dict keysOfEntriesPassingTest:^BOOL(id key, id obj, BOOL *stop) {
         return ![obj isEqual:[NSNull null]];
     }] allObjects]];
+}
 
+- (void)updateMessageData:(UAInboxMessageData *)data withDictionary:(NSDictionary *)dict {
     if (!data.isGone) {
         data.messageID = dict[@"message_id"];
         data.contentType = dict[@"content_type"];
@@ -183,44 +224,6 @@
 }
 
 
-- (void)addMessageFromDictionary:(NSDictionary *)dictionary {
-    UAInboxMessageData *data = (UAInboxMessageData *)[NSEntityDescription insertNewObjectForEntityForName:kUAInboxDBEntityName
-                                                                                   inManagedObjectContext:self.managedContext];
-
-    [self updateMessageData:data withDictionary:dictionary];
-}
-
-- (BOOL)updateMessageWithDictionary:(NSDictionary *)dictionary {
-    NSString *messageID = dictionary[@"message_id"];
-    NSError *error = nil;
-
-    if (!messageID) {
-        UA_LDEBUG(@"Missing message ID: %@", dictionary);
-        return NO;
-    }
-
-    NSFetchRequest *request = [[NSFetchRequest alloc] init];
-    request.entity = [NSEntityDescription entityForName:kUAInboxDBEntityName
-                                 inManagedObjectContext:self.managedContext];
-    request.predicate = [NSPredicate predicateWithFormat:@"messageID == %@", messageID];
-    request.fetchLimit = 1;
-
-    NSArray *resultData = [self.managedContext executeFetchRequest:request error:&error];
-
-    if (error) {
-        UA_LERR(@"Fetch request %@ failed with with error: %@", request, error);
-    }
-
-    UAInboxMessageData *data;
-    if (resultData.count) {
-        data = [resultData lastObject];
-        [self updateMessageData:data withDictionary:dictionary];
-        return YES;
-    }
-    
-    return NO;
-}
-
 - (void)moveDatabase {
     NSFileManager *fm = [NSFileManager defaultManager];
 
@@ -101,7 +101,7 @@
 
 - (NSDictionary *)payload {
 
-    NSDateFormatter *formatter = [UAUtils ISODateFormatterUTCWithDelimiter];
+    NSDateFormatter *formatter = [UAUtils sharedISODateFormatterUTCWithDelimiter];
     NSString *expiry = [formatter stringFromDate:self.expiry];
 
     NSDictionary *extra = self.extra;
@@ -10,12 +10,67 @@
 #import "UARuntimeConfig.h"
 #import "UAScheduleDelay.h"
 #import "UAScheduleData+Internal.h"
+#import "UAScheduleTriggerData+Internal.h"
+#import "UASchedule+Internal.h"
 #import "UAScheduleInfo+Internal.h"
 #import "UAActionScheduleInfo.h"
 #import "UAAutomation+Internal.h"
 #import "UAApplicationMetrics+Internal.h"
 #import "UATestDispatcher.h"
 #import "UATestDate.h"
+#import "NSManagedObjectContext+UAAdditions+Internal.h"
+#import "NSJSONSerialization+UAAdditions.h"
+
+/**
+ * Test dispatcher that can hold async blocks, so main queue dispatches can be observed before they run.
+ */
+@interface UAAutomationEngineTestDispatcher : UATestDispatcher
+@property (atomic, assign) BOOL holdAsyncBlocks;
+@property (nonatomic, strong) NSMutableArray *heldBlocks;
+- (NSUInteger)heldBlockCount;
+- (void)runHeldBlocks;
+@end
+
+@implementation UAAutomationEngineTestDispatcher
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        self.heldBlocks = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)dispatchAsync:(void (^)(void))block {
+    if (!self.holdAsyncBlocks) {
+        block();
+        return;
+    }
+
+    @synchronized (self.heldBlocks) {
+        [self.heldBlocks addObject:block];
+    }
+}
+
+- (NSUInteger)heldBlockCount {
+    @synchronized (self.heldBlocks) {
+        return self.heldBlocks.count;
+    }
+}
+
+- (void)runHeldBlocks {
+    NSArray *blocks;
+    @synchronized (self.heldBlocks) {
+        blocks = [self.heldBlocks copy];
+        [self.heldBlocks removeAllObjects];
+    }
+
+    for (void (^block)(void) in blocks) {
+        block();
+    }
+}
+
+@end
 
 @interface UAAutomationEngineIntegrationTest : UABaseTest
 @property (nonatomic, strong) UAAutomationEngine *automationEngine;
@@ -27,9 +82,11 @@
 @property (nonatomic, strong) id mockAirship;
 @property (nonatomic, strong) UATimerScheduler *timerScheduler;
 @property (nonatomic, strong) NSNotificationCenter *notificationCenter;
-@property (nonatomic, strong) UATestDispatcher *dispatcher;
+@property (nonatomic, strong) UAAutomationEngineTestDispatcher *dispatcher;
 @property (nonatomic, copy) void (^timerSchedulerBlock)(NSTimer *);
 @property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, assign) NSUInteger createScheduleInfoCount;
+@property (nonatomic, assign) NSUInteger readyChecks;
 @end
 
 #define UAAUTOMATIONENGINETESTS_SCHEDULE_LIMIT 100
@@ -41,7 +98,7 @@
 
     self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
 
-    self.dispatcher = [UATestDispatcher testDispatcher];
+    self.dispatcher = [UAAutomationEngineTestDispatcher testDispatcher];
 
     self.mockedApplication = [self mockForClass:[UIApplication class]];
     self.mockAppStateTracker = [self mockForProtocol:@protocol(UAAppStateTracker)];
@@ -357,6 +414,102 @@
     [self waitForTestExpectations];
 }
 
+/**
+ * Test schedules are only decoded again after they are edited.
+ */
+- (void)testScheduleDecodedOncePerEdit {
+    UAActionScheduleInfo *scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"oh": @"hi"};
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+    }];
+
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    __block NSString *identifier;
+    [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:^(UASchedule *schedule) {
+        identifier = schedule.identifier;
+        [scheduled fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    __block UASchedule *first;
+    XCTestExpectation *firstFetch = [self expectationWithDescription:@"fetched"];
+    [self.automationEngine getScheduleWithID:identifier completionHandler:^(UASchedule *schedule) {
+        first = schedule;
+        [firstFetch fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    NSUInteger decodeCount = self.createScheduleInfoCount;
+
+    XCTestExpectation *secondFetch = [self expectationWithDescription:@"fetched"];
+    [self.automationEngine getScheduleWithID:identifier completionHandler:^(UASchedule *schedule) {
+        XCTAssertEqual(first, schedule);
+        [secondFetch fulfill];
+    }];
+    [self waitForTestExpectations];
+    XCTAssertEqual(decodeCount, self.createScheduleInfoCount);
+
+    UAActionScheduleEdits *edits = [UAActionScheduleEdits editsWithBuilderBlock:^(UAActionScheduleEditsBuilder *builder) {
+        builder.priority = @(10);
+    }];
+
+    XCTestExpectation *edited = [self expectationWithDescription:@"edited"];
+    [self.automationEngine editScheduleWithID:identifier edits:edits completionHandler:^(UASchedule *schedule) {
+        [edited fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    XCTestExpectation *thirdFetch = [self expectationWithDescription:@"fetched"];
+    [self.automationEngine getScheduleWithID:identifier completionHandler:^(UASchedule *schedule) {
+        XCTAssertEqual(10, schedule.info.priority);
+        [thirdFetch fulfill];
+    }];
+    [self waitForTestExpectations];
+    XCTAssertEqual(decodeCount + 1, self.createScheduleInfoCount);
+}
+
+- (void)testCancelledScheduleNotCached {
+    UAActionScheduleInfo *scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"oh": @"hi"};
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+        builder.priority = 1;
+    }];
+
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    __block NSString *identifier;
+    [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:^(UASchedule *schedule) {
+        identifier = schedule.identifier;
+        [scheduled fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    // Cancel while a lookup that decodes the schedule is queued ahead of the delete
+    [self.automationEngine getScheduleWithID:identifier completionHandler:^(UASchedule *schedule) {}];
+    [self.automationEngine cancelScheduleWithID:identifier];
+    [self.testStore waitForIdle];
+
+    // Reuse the identifier for a new schedule
+    UAActionScheduleInfo *newScheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"oh": @"hi"};
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+        builder.priority = 5;
+    }];
+
+    XCTestExpectation *saved = [self expectationWithDescription:@"saved"];
+    [self.testStore saveSchedule:[UASchedule scheduleWithIdentifier:identifier info:newScheduleInfo metadata:@{}] completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [saved fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.automationEngine getScheduleWithID:identifier completionHandler:^(UASchedule *schedule) {
+        XCTAssertEqual(5, schedule.info.priority);
+        [fetched fulfill];
+    }];
+    [self waitForTestExpectations];
+}
+
 - (void)testGetAllUnended {
     NSMutableArray *expectedSchedules = [NSMutableArray arrayWithCapacity:15];
 
@@ -621,7 +774,12 @@
     [self waitForTestExpectations];
 }
 
-- (void)testScheduleDeletesExpiredSchedules {
+- (void)testExpiryTimerDeletesExpiredSchedules {
+    NSMutableArray<NSTimer *> *timers = [NSMutableArray array];
+    self.timerSchedulerBlock = ^(NSTimer *timer) {
+        [timers addObject:timer];
+    };
+
     NSDate *futureDate = [NSDate dateWithTimeInterval:100 sinceDate:self.testDate.now];
 
     UAActionScheduleInfo *scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
@@ -633,44 +791,282 @@
 
     XCTestExpectation *scheduleExpectation = [self expectationWithDescription:@"scheduled action"];
 
+    __block NSString *scheduleIdentifier;
     [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:^(UASchedule *schedule) {
-        XCTAssertEqual(scheduleInfo, schedule.info);
-        XCTAssertNotNil(schedule.identifier);
+        scheduleIdentifier = schedule.identifier;
         [scheduleExpectation fulfill];
     }];
 
-    // Make sure we verified the schedule being availble before mocking the date
     [self waitForTestExpectations];
 
-    // Shift time to one second after the futureDate
+    // Verify a single expiry timer is scheduled for the end date
+    XCTAssertEqual(1, timers.count);
+    XCTAssertEqualWithAccuracy(100, timers.firstObject.timeInterval, 0.1);
+
+    [[self.mockDelegate expect] onScheduleExpired:[OCMArg checkWithBlock:^BOOL(id obj) {
+        UASchedule *schedule = obj;
+        return [schedule.identifier isEqualToString:scheduleIdentifier];
+    }]];
+
+    // Shift time to one second after the futureDate and fire the timer
     self.testDate.timeOffset = [futureDate timeIntervalSinceDate:self.testDate.now] + 1;
+    [timers.firstObject fire];
+    [self.testStore waitForIdle];
 
-    // Schedule more actions
-    scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
-        UAScheduleTrigger *foregroundTrigger = [UAScheduleTrigger foregroundTriggerWithCount:2];
+    // Check that the schedule was deleted from the data store
+    XCTestExpectation *fetchScheduleDataExpectation = [self expectationWithDescription:@"fetched schedule data"];
+    [self.testStore getAllSchedules:^(NSArray<UAScheduleData *> *schedulesData) {
+        XCTAssertEqual(0, schedulesData.count);
+        [fetchScheduleDataExpectation fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [self.mockDelegate verify];
+}
+
+- (void)testExpiryTimerDeletesFinishedScheduleAfterGracePeriod {
+    NSMutableArray<NSTimer *> *timers = [NSMutableArray array];
+    self.timerSchedulerBlock = ^(NSTimer *timer) {
+        [timers addObject:timer];
+    };
+
+    NSDate *end = [NSDate dateWithTimeInterval:100 sinceDate:self.testDate.now];
+    NSString *identifier = [self scheduleWithEnd:end editGracePeriod:50];
+    XCTAssertEqualWithAccuracy(100, timers.lastObject.timeInterval, 0.1);
+
+    // Expire the schedule, it is kept until the end of its grace period
+    self.testDate.timeOffset = [end timeIntervalSinceDate:self.testDate.now] + 1;
+    [timers.lastObject fire];
+    [self.testStore waitForIdle];
+
+    XCTestExpectation *finished = [self expectationWithDescription:@"finished"];
+    [self.testStore getSchedule:identifier includingExpired:YES completionHandler:^(UAScheduleData *scheduleData) {
+        XCTAssertEqual(UAScheduleStateFinished, [scheduleData.executionState intValue]);
+        [finished fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    // Verify the timer is scheduled for the grace deadline
+    XCTAssertEqual(2, timers.count);
+    XCTAssertEqualWithAccuracy(49, timers.lastObject.timeInterval, 0.1);
+
+    // Fire the grace deadline
+    self.testDate.timeOffset += 50;
+    [timers.lastObject fire];
+    [self.testStore waitForIdle];
+
+    XCTestExpectation *deleted = [self expectationWithDescription:@"deleted"];
+    [self.testStore getAllSchedules:^(NSArray<UAScheduleData *> *schedulesData) {
+        XCTAssertEqual(0, schedulesData.count);
+        [deleted fulfill];
+    }];
+    [self waitForTestExpectations];
+}
+
+- (void)testEditEndDateReschedulesExpiryTimer {
+    NSMutableArray<NSTimer *> *timers = [NSMutableArray array];
+    self.timerSchedulerBlock = ^(NSTimer *timer) {
+        [timers addObject:timer];
+    };
+
+    NSString *identifier = [self scheduleWithEnd:[NSDate dateWithTimeInterval:100 sinceDate:self.testDate.now] editGracePeriod:0];
+    XCTAssertEqual(1, timers.count);
+    XCTAssertEqualWithAccuracy(100, timers.lastObject.timeInterval, 0.1);
+
+    // Move the end date earlier
+    UAActionScheduleEdits *edits = [UAActionScheduleEdits editsWithBuilderBlock:^(UAActionScheduleEditsBuilder *builder) {
+        builder.end = [NSDate dateWithTimeInterval:10 sinceDate:self.testDate.now];
+    }];
+
+    XCTestExpectation *edited = [self expectationWithDescription:@"edited"];
+    [self.automationEngine editScheduleWithID:identifier edits:edits completionHandler:^(UASchedule *schedule) {
+        [edited fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    // Verify the timer is rescheduled for the new end date
+    XCTAssertEqual(2, timers.count);
+    XCTAssertFalse(timers.firstObject.isValid);
+    XCTAssertEqualWithAccuracy(10, timers.lastObject.timeInterval, 0.1);
+}
+
+- (void)testExpiryTimerFiredEarlyReschedules {
+    NSMutableArray<NSTimer *> *timers = [NSMutableArray array];
+    self.timerSchedulerBlock = ^(NSTimer *timer) {
+        [timers addObject:timer];
+    };
+
+    NSString *identifier = [self scheduleWithEnd:[NSDate dateWithTimeInterval:100 sinceDate:self.testDate.now] editGracePeriod:0];
+    XCTAssertEqual(1, timers.count);
+
+    // Fire the timer before the end date
+    self.testDate.timeOffset = 60;
+    [timers.firstObject fire];
+    [self.testStore waitForIdle];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.testStore getSchedule:identifier completionHandler:^(UAScheduleData *scheduleData) {
+        XCTAssertNotNil(scheduleData);
+        [fetched fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    // Verify the timer is scheduled again for the end date
+    XCTAssertEqual(2, timers.count);
+    XCTAssertEqualWithAccuracy(40, timers.lastObject.timeInterval, 0.1);
+}
+
+- (void)testNextActiveEndDateIgnoresFinishedSchedules {
+    NSDate *finishedEnd = [NSDate dateWithTimeInterval:10 sinceDate:self.testDate.now];
+    NSDate *activeEnd = [NSDate dateWithTimeInterval:100 sinceDate:self.testDate.now];
+
+    NSString *finishedID = [self scheduleWithEnd:finishedEnd editGracePeriod:1000];
+    [self scheduleWithEnd:activeEnd editGracePeriod:0];
+
+    XCTestExpectation *edited = [self expectationWithDescription:@"edited"];
+    [self.testStore editSchedulesWithIDs:@[finishedID] editBlock:^(NSArray<UAScheduleData *> *schedulesData) {
+        schedulesData.firstObject.executionState = @(UAScheduleStateFinished);
+    } newSchedules:@[] completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [edited fulfill];
+    }];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.testStore getNextActiveEndDate:^(NSDate *endDate) {
+        XCTAssertEqualObjects(activeEnd, endDate);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+- (void)testForegroundRemovesExpiredSchedules {
+    NSDate *end = [NSDate dateWithTimeInterval:100 sinceDate:self.testDate.now];
+    NSString *identifier = [self scheduleWithEnd:end editGracePeriod:0];
+
+    [[self.mockDelegate expect] onScheduleExpired:[OCMArg checkWithBlock:^BOOL(id obj) {
+        UASchedule *schedule = obj;
+        return [schedule.identifier isEqualToString:identifier];
+    }]];
+
+    // The expiry timer does not fire while the app is suspended
+    self.testDate.timeOffset = [end timeIntervalSinceDate:self.testDate.now] + 1;
+    [self simulateForegroundTransition];
+    [self.testStore waitForIdle];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.testStore getAllSchedules:^(NSArray<UAScheduleData *> *schedulesData) {
+        XCTAssertEqual(0, schedulesData.count);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [self.mockDelegate verify];
+}
+
+- (void)testScheduleRemovesExpiredSchedulesAtLimit {
+    // Fill the store with schedules that expire
+    NSDate *end = [NSDate dateWithTimeInterval:100 sinceDate:self.testDate.now];
+    NSMutableArray<UAActionScheduleInfo *> *scheduleInfos = [NSMutableArray array];
+    for (NSUInteger i = 0; i < UAAUTOMATIONENGINETESTS_SCHEDULE_LIMIT; i++) {
+        [scheduleInfos addObject:[UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+            builder.actions = @{@"oh": @"hi"};
+            builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+            builder.end = end;
+        }]];
+    }
+
+    XCTestExpectation *filled = [self expectationWithDescription:@"filled"];
+    [self.automationEngine scheduleMultiple:scheduleInfos metadata:@{} completionHandler:^(NSArray<UASchedule *> *schedules) {
+        XCTAssertEqual(UAAUTOMATIONENGINETESTS_SCHEDULE_LIMIT, schedules.count);
+        [filled fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    // Expire them without running the expiry timer
+    self.testDate.timeOffset = [end timeIntervalSinceDate:self.testDate.now] + 1;
+
+    UAActionScheduleInfo *scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
         builder.actions = @{@"oh": @"hi"};
-        builder.triggers = @[foregroundTrigger];
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
     }];
 
-    [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:nil];
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:^(UASchedule *schedule) {
+        XCTAssertNotNil(schedule);
+        [scheduled fulfill];
+    }];
+    [self waitForTestExpectations];
 
-    // Verify we have the new schedule
-    XCTestExpectation *allExpectation = [self expectationWithDescription:@"fetched schedule"];
-    [self.automationEngine getSchedules:^(NSArray<UASchedule *> *result) {
-        XCTAssertEqual(1, result.count);
-        [allExpectation fulfill];
+    XCTestExpectation *counted = [self expectationWithDescription:@"counted"];
+    [self.testStore getScheduleCount:^(NSNumber *count) {
+        XCTAssertEqual(1, [count unsignedIntegerValue]);
+        [counted fulfill];
     }];
+    [self waitForTestExpectations];
+}
 
-    // Check that the schedule was deleted from the data store
-    XCTestExpectation *fetchScheduleDataExpectation = [self expectationWithDescription:@"fetched schedule data"];
+- (void)testTriggerProgressSavedOnBackground {
+    UAActionScheduleInfo *scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"oh": @"hi"};
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+    }];
 
-    [self.automationEngine getSchedules:^(NSArray<UASchedule *> *result) {
-        XCTAssertEqual(1, result.count);
-        [fetchScheduleDataExpectation fulfill];
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:^(UASchedule *schedule) {
+        [scheduled fulfill];
     }];
+    [self waitForTestExpectations];
+
+    __block NSNumber *savedProgress;
+    id observer = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification
+                                                                    object:nil
+                                                                     queue:nil
+                                                                usingBlock:^(NSNotification *notification) {
+        for (NSManagedObject *object in notification.userInfo[NSUpdatedObjectsKey]) {
+            if ([object isKindOfClass:[UAScheduleTriggerData class]]) {
+                savedProgress = ((UAScheduleTriggerData *)object).goalProgress;
+            }
+        }
+    }];
+
+    // Progress is written by the time the app is in the background, without waiting for the coalesced save
+    [self simulateForegroundTransition];
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidEnterBackgroundNotification object:nil];
+    [self.testStore waitForIdle];
+    XCTAssertEqualObjects(@(1), savedProgress);
+
+    [[NSNotificationCenter defaultCenter] removeObserver:observer];
+}
 
+- (void)testCancelledScheduleTriggersRemoved {
+    UAActionScheduleInfo *scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"oh": @"hi"};
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:1]];
+    }];
+
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    __block NSString *identifier;
+    [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:^(UASchedule *schedule) {
+        identifier = schedule.identifier;
+        [scheduled fulfill];
+    }];
     [self waitForTestExpectations];
 
+    [self.automationEngine cancelScheduleWithID:identifier];
+
+    [[self.mockDelegate reject] prepareSchedule:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [self simulateForegroundTransition];
+    [self.testStore waitForIdle];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.testStore getActiveTriggers:nil type:UAScheduleTriggerAppForeground completionHandler:^(NSArray<UAScheduleTriggerData *> *triggers) {
+        XCTAssertEqual(0, triggers.count);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [self.mockDelegate verify];
 }
 
 - (void)testForeground {
@@ -840,6 +1236,7 @@
 
     [self verifyDelay:delay fulfillmentBlock:^{
         [[[self.mockAppStateTracker expect] andReturnValue:@(UAApplicationStateBackground)] state];
+        [[[self.mockAppStateTracker stub] andReturnValue:@(UAApplicationStateBackground)] state];
         [self.automationEngine applicationDidTransitionToBackground];
     }];
 }
@@ -1073,6 +1470,64 @@
     [self waitForTestExpectations];
 }
 
+- (void)testEditSchedulesBatch {
+    NSMutableDictionary<NSString *, NSString *> *scheduleIDs = [NSMutableDictionary dictionary];
+
+    for (NSString *group in @[@"foo", @"bar"]) {
+        XCTestExpectation *scheduled = [self expectationWithDescription:[NSString stringWithFormat:@"scheduled %@", group]];
+
+        UAActionScheduleInfo *scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+            builder.actions = @{@"oh": @"hi"};
+            builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+            builder.group = group;
+        }];
+
+        [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:^(UASchedule *schedule) {
+            scheduleIDs[group] = schedule.identifier;
+            [scheduled fulfill];
+        }];
+    }
+
+    [self waitForTestExpectations];
+
+    UAActionScheduleEdits *edits = [UAActionScheduleEdits editsWithBuilderBlock:^(UAActionScheduleEditsBuilder *builder) {
+        builder.limit = @(5);
+    }];
+
+    UAActionScheduleInfo *newScheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"oh": @"hi"};
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+        builder.group = @"baz";
+    }];
+
+    XCTestExpectation *edited = [self expectationWithDescription:@"schedules edited"];
+    [self.automationEngine editSchedules:@{scheduleIDs[@"foo"]: edits}
+                        newScheduleInfos:@[newScheduleInfo]
+                                metadata:@{}
+                       completionHandler:^(NSArray<UASchedule *> *schedules) {
+                           XCTAssertEqual(1, schedules.count);
+                           XCTAssertEqualObjects(newScheduleInfo, schedules.firstObject.info);
+                           scheduleIDs[@"baz"] = schedules.firstObject.identifier;
+                           [edited fulfill];
+                       }];
+
+    [self waitForTestExpectations];
+
+    XCTestExpectation *checkEdits = [self expectationWithDescription:@"edits applied"];
+    [self.automationEngine.automationStore getSchedule:scheduleIDs[@"foo"] completionHandler:^(UAScheduleData *scheduleData) {
+        XCTAssertEqualObjects(@(5), scheduleData.limit);
+        [checkEdits fulfill];
+    }];
+
+    XCTestExpectation *checkIDs = [self expectationWithDescription:@"schedule IDs fetched"];
+    [self.automationEngine getScheduleIDsByGroupWithPredicate:nil completionHandler:^(NSDictionary<NSString *, NSString *> *result) {
+        XCTAssertEqualObjects(scheduleIDs, result);
+        [checkIDs fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
 - (void)testPrepareResultCancel {
     [self verifyPrepareResult:UAAutomationSchedulePrepareResultCancel verifyWithCompletionHandler:^(UAScheduleData *data) {
         XCTAssertNil(data);
@@ -1244,6 +1699,303 @@
 }
 
 
+- (void)testExecutionAttemptChecksConditionsOffMainQueue {
+    // The app state may only be read on the main queue
+    [[[self.mockAppStateTracker stub] andDo:^(NSInvocation *invocation) {
+        XCTAssertTrue([NSThread isMainThread]);
+        UAApplicationState state = UAApplicationStateActive;
+        [invocation setReturnValue:&state];
+    }] state];
+
+    NSArray<NSString *> *scheduleIDs = [self waitingSchedulesWithDelay:[self screenDelay:@"test screen"] count:1];
+
+    [self stubReadyResult:UAAutomationScheduleReadyResultNotReady];
+
+    self.dispatcher.holdAsyncBlocks = YES;
+
+    // Conditions not satisfied, nothing is dispatched to the main queue
+    [self emitScreenTracked:@"another screen"];
+    [self.testStore waitForIdle];
+    XCTAssertEqual(0, self.dispatcher.heldBlockCount);
+
+    // Conditions satisfied, the delegate is not called until the main queue dispatch runs
+    [self emitScreenTracked:@"test screen"];
+    [self.testStore waitForIdle];
+    XCTAssertEqual(1, self.dispatcher.heldBlockCount);
+    XCTAssertEqual(0, self.readyChecks);
+
+    [self.dispatcher runHeldBlocks];
+    XCTAssertEqual(1, self.readyChecks);
+    [self verifySchedules:scheduleIDs state:UAScheduleStateWaitingScheduleConditions];
+}
+
+- (void)testExecutionAttemptsBatchedOnMainQueue {
+    NSArray<NSString *> *scheduleIDs = [self waitingSchedulesWithDelay:[self screenDelay:@"test screen"] count:3];
+
+    [self stubReadyResult:UAAutomationScheduleReadyResultNotReady];
+
+    self.dispatcher.holdAsyncBlocks = YES;
+    [self emitScreenTracked:@"test screen"];
+    [self.testStore waitForIdle];
+
+    // All schedules are checked in a single dispatch
+    XCTAssertEqual(1, self.dispatcher.heldBlockCount);
+    [self.dispatcher runHeldBlocks];
+    XCTAssertEqual(3, self.readyChecks);
+
+    [self verifySchedules:scheduleIDs state:UAScheduleStateWaitingScheduleConditions];
+}
+
+- (void)testExecutionAttemptsDeduplicated {
+    [self waitingSchedulesWithDelay:[self screenDelay:@"test screen"] count:1];
+
+    [self stubReadyResult:UAAutomationScheduleReadyResultNotReady];
+
+    self.dispatcher.holdAsyncBlocks = YES;
+    [self emitScreenTracked:@"test screen"];
+    [self.testStore waitForIdle];
+    XCTAssertEqual(1, self.dispatcher.heldBlockCount);
+
+    // The schedule is already waiting on the main queue
+    [self emitScreenTracked:@"test screen"];
+    [self.testStore waitForIdle];
+    XCTAssertEqual(1, self.dispatcher.heldBlockCount);
+
+    [self.dispatcher runHeldBlocks];
+    XCTAssertEqual(1, self.readyChecks);
+
+    // Once the attempt finishes the schedule can be attempted again
+    [self emitScreenTracked:@"test screen"];
+    [self.testStore waitForIdle];
+    XCTAssertEqual(1, self.dispatcher.heldBlockCount);
+
+    [self.dispatcher runHeldBlocks];
+    XCTAssertEqual(2, self.readyChecks);
+}
+
+- (void)testExecutionRechecksAppStateOnMainQueue {
+    __block UAApplicationState appState = UAApplicationStateBackground;
+    [[[self.mockAppStateTracker stub] andDo:^(NSInvocation *invocation) {
+        [invocation setReturnValue:&appState];
+    }] state];
+    [self.automationEngine applicationDidTransitionToBackground];
+
+    UAScheduleDelay *delay = [UAScheduleDelay delayWithBuilderBlock:^(UAScheduleDelayBuilder * builder) {
+        builder.appState = UAScheduleDelayAppStateForeground;
+    }];
+    NSArray<NSString *> *scheduleIDs = [self waitingSchedulesWithDelay:delay count:1];
+
+    [[self.mockDelegate reject] isScheduleReadyToExecute:OCMOCK_ANY];
+    [[self.mockDelegate reject] executeSchedule:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    self.dispatcher.holdAsyncBlocks = YES;
+    appState = UAApplicationStateActive;
+    [self.automationEngine applicationDidTransitionToForeground];
+    [self.testStore waitForIdle];
+    XCTAssertEqual(1, self.dispatcher.heldBlockCount);
+
+    // App backgrounds before the dispatch runs
+    appState = UAApplicationStateBackground;
+    [self.dispatcher runHeldBlocks];
+
+    [self.mockDelegate verify];
+    [self verifySchedules:scheduleIDs state:UAScheduleStateWaitingScheduleConditions];
+}
+
+- (void)testExecutionStateAppliedToExpiredSchedule {
+    NSDate *end = [NSDate dateWithTimeInterval:100 sinceDate:self.testDate.now];
+    NSArray<NSString *> *scheduleIDs = [self waitingSchedulesWithDelay:[self screenDelay:@"test screen"] count:1 end:end];
+
+    [self stubReadyResult:UAAutomationScheduleReadyResultContinue];
+    [[self.mockDelegate expect] executeSchedule:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    self.dispatcher.holdAsyncBlocks = YES;
+    [self emitScreenTracked:@"test screen"];
+    [self.testStore waitForIdle];
+
+    // Schedule expires while the attempt is waiting on the main queue
+    self.testDate.timeOffset = [end timeIntervalSinceDate:self.testDate.now] + 1;
+    [self.dispatcher runHeldBlocks];
+    [self.testStore waitForIdle];
+
+    [self.mockDelegate verify];
+    XCTAssertEqual(1, self.readyChecks);
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched schedule"];
+    [self.testStore getSchedule:scheduleIDs.firstObject includingExpired:YES completionHandler:^(UAScheduleData *scheduleData) {
+        XCTAssertEqual(UAScheduleStateExecuting, [scheduleData.executionState intValue]);
+        [fetched fulfill];
+    }];
+    [self waitForTestExpectations];
+}
+
+- (void)testScheduleCancelledDuringExecutionAttempt {
+    NSArray<NSString *> *scheduleIDs = [self waitingSchedulesWithDelay:[self screenDelay:@"test screen"] count:1];
+
+    [self stubReadyResult:UAAutomationScheduleReadyResultContinue];
+    [[self.mockDelegate reject] executeSchedule:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    self.dispatcher.holdAsyncBlocks = YES;
+    [self emitScreenTracked:@"test screen"];
+    [self.testStore waitForIdle];
+    XCTAssertEqual(1, self.dispatcher.heldBlockCount);
+
+    // Schedule is cancelled while the attempt is waiting on the main queue
+    [self.automationEngine cancelScheduleWithID:scheduleIDs.firstObject];
+    [self.testStore waitForIdle];
+
+    [self.dispatcher runHeldBlocks];
+    [self.testStore waitForIdle];
+    [self.dispatcher runHeldBlocks];
+
+    [self.mockDelegate verify];
+    XCTAssertEqual(0, self.readyChecks);
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched schedule"];
+    [self.testStore getSchedule:scheduleIDs.firstObject includingExpired:YES completionHandler:^(UAScheduleData *scheduleData) {
+        XCTAssertNil(scheduleData);
+        [fetched fulfill];
+    }];
+    [self waitForTestExpectations];
+}
+
+- (void)testScheduleEditedDuringExecutionAttempt {
+    NSArray<NSString *> *scheduleIDs = [self waitingSchedulesWithDelay:[self screenDelay:@"test screen"] count:1];
+
+    [self stubReadyResult:UAAutomationScheduleReadyResultContinue];
+
+    // Only the edited schedule is executed
+    [[self.mockDelegate expect] executeSchedule:[OCMArg checkWithBlock:^BOOL(id obj) {
+        UASchedule *schedule = obj;
+        return schedule.info.limit == 5;
+    }] completionHandler:OCMOCK_ANY];
+    [[self.mockDelegate reject] executeSchedule:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    self.dispatcher.holdAsyncBlocks = YES;
+    [self emitScreenTracked:@"test screen"];
+    [self.testStore waitForIdle];
+    XCTAssertEqual(1, self.dispatcher.heldBlockCount);
+
+    // Schedule is edited while the attempt is waiting on the main queue
+    UAActionScheduleEdits *edits = [UAActionScheduleEdits editsWithBuilderBlock:^(UAActionScheduleEditsBuilder *builder) {
+        builder.limit = @(5);
+    }];
+    [self.automationEngine editScheduleWithID:scheduleIDs.firstObject edits:edits completionHandler:^(UASchedule *schedule) {}];
+    [self.testStore waitForIdle];
+
+    // The stale attempt is checked against the store and attempted again
+    [self.dispatcher runHeldBlocks];
+    XCTAssertEqual(0, self.readyChecks);
+    [self.testStore waitForIdle];
+
+    [self.dispatcher runHeldBlocks];
+    [self.testStore waitForIdle];
+
+    [self.mockDelegate verify];
+    XCTAssertEqual(1, self.readyChecks);
+    [self verifySchedules:scheduleIDs state:UAScheduleStateExecuting];
+}
+
+- (UAScheduleDelay *)screenDelay:(NSString *)screen {
+    return [UAScheduleDelay delayWithBuilderBlock:^(UAScheduleDelayBuilder * builder) {
+        builder.screens = @[screen];
+    }];
+}
+
+- (void)stubReadyResult:(UAAutomationScheduleReadyResult)result {
+    self.readyChecks = 0;
+    [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
+        XCTAssertTrue([NSThread isMainThread]);
+        self.readyChecks++;
+        UAAutomationScheduleReadyResult readyResult = result;
+        [invocation setReturnValue:&readyResult];
+    }] isScheduleReadyToExecute:OCMOCK_ANY];
+}
+
+- (NSArray<NSString *> *)waitingSchedulesWithDelay:(UAScheduleDelay *)delay count:(NSUInteger)count {
+    return [self waitingSchedulesWithDelay:delay count:count end:nil];
+}
+
+/**
+ * Schedules actions triggered by a purchase event, then triggers and prepares them so they are
+ * waiting on the delay's conditions.
+ */
+- (NSArray<NSString *> *)waitingSchedulesWithDelay:(UAScheduleDelay *)delay count:(NSUInteger)count end:(NSDate *)end {
+    NSMutableArray<UAActionScheduleInfo *> *scheduleInfos = [NSMutableArray array];
+    for (NSUInteger i = 0; i < count; i++) {
+        [scheduleInfos addObject:[UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+            builder.actions = @{@"test action": @"test value"};
+
+            UAJSONValueMatcher *valueMatcher = [UAJSONValueMatcher matcherWhereStringEquals:@"purchase"];
+            UAJSONMatcher *jsonMatcher = [UAJSONMatcher matcherWithValueMatcher:valueMatcher scope:@[UACustomEventNameKey]];
+            UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSONMatcher:jsonMatcher];
+            builder.triggers = @[[UAScheduleTrigger customEventTriggerWithPredicate:predicate count:1]];
+            builder.delay = delay;
+            builder.end = end;
+        }]];
+    }
+
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    __block NSArray<NSString *> *scheduleIDs;
+    [self.automationEngine scheduleMultiple:scheduleInfos metadata:@{} completionHandler:^(NSArray<UASchedule *> *schedules) {
+        scheduleIDs = [schedules valueForKey:@"identifier"];
+        [scheduled fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        void (^handler)(UAAutomationSchedulePrepareResult) = (__bridge void (^)(UAAutomationSchedulePrepareResult))arg;
+        handler(UAAutomationSchedulePrepareResultContinue);
+    }] prepareSchedule:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    [self emitEvent:[UACustomEvent eventWithName:@"purchase"]];
+
+    // Triggering and preparing take several store operations
+    for (NSUInteger i = 0; i < 3; i++) {
+        [self.testStore waitForIdle];
+    }
+
+    [self verifySchedules:scheduleIDs state:UAScheduleStateWaitingScheduleConditions];
+    return scheduleIDs;
+}
+
+/**
+ * Schedules a schedule that never triggers and waits for it to be saved.
+ *
+ * @param end The end date.
+ * @param editGracePeriod The edit grace period.
+ * @return The schedule identifier.
+ */
+- (NSString *)scheduleWithEnd:(NSDate *)end editGracePeriod:(NSTimeInterval)editGracePeriod {
+    UAActionScheduleInfo *scheduleInfo = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"oh": @"hi"};
+        builder.triggers = @[[UAScheduleTrigger screenTriggerForScreenName:@"NEVERTRIGGERTHISNAME" count:1]];
+        builder.end = end;
+        builder.editGracePeriod = editGracePeriod;
+    }];
+
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    __block NSString *identifier;
+    [self.automationEngine schedule:scheduleInfo metadata:@{} completionHandler:^(UASchedule *schedule) {
+        identifier = schedule.identifier;
+        [scheduled fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    return identifier;
+}
+
+- (void)verifySchedules:(NSArray<NSString *> *)scheduleIDs state:(UAScheduleState)state {
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched schedules"];
+    [self.testStore getSchedulesWithStates:@[@(state)] completionHandler:^(NSArray<UAScheduleData *> *schedulesData) {
+        XCTAssertEqualObjects([NSSet setWithArray:scheduleIDs], [NSSet setWithArray:[schedulesData valueForKey:@"identifier"]]);
+        [fetched fulfill];
+    }];
+    [self waitForTestExpectations];
+}
+
 /**
  * Helper method for simulating a full transition from the background to the active state.
  */
@@ -1334,6 +2086,201 @@
 }
 
 
+- (void)testCustomEventTriggerPerformance {
+    // 100 schedules with 5 predicated triggers each for 500 triggers total
+    NSMutableArray<UAScheduleInfo *> *infos = [NSMutableArray array];
+    for (NSUInteger i = 0; i < UAAUTOMATIONENGINETESTS_SCHEDULE_LIMIT; i++) {
+        UAActionScheduleInfo *info = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+            NSMutableArray *triggers = [NSMutableArray array];
+            for (NSUInteger j = 0; j < 5; j++) {
+                NSString *eventName = [NSString stringWithFormat:@"event-%lu-%lu", (unsigned long)i, (unsigned long)j];
+                UAJSONValueMatcher *valueMatcher = [UAJSONValueMatcher matcherWhereStringEquals:eventName];
+                UAJSONMatcher *jsonMatcher = [UAJSONMatcher matcherWithValueMatcher:valueMatcher scope:@[UACustomEventNameKey]];
+                UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSONMatcher:jsonMatcher];
+                [triggers addObject:[UAScheduleTrigger customEventTriggerWithPredicate:predicate count:1]];
+            }
+
+            builder.actions = @{@"cool": @"story"};
+            builder.triggers = triggers;
+        }];
+
+        [infos addObject:info];
+    }
+
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    [self.automationEngine scheduleMultiple:infos metadata:@{} completionHandler:^(NSArray<UASchedule *> *schedules) {
+        XCTAssertEqual(UAAUTOMATIONENGINETESTS_SCHEDULE_LIMIT, schedules.count);
+        [scheduled fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    // None of the events match a predicate, so every event evaluates all 500 triggers
+    UACustomEvent *event = [UACustomEvent eventWithName:@"not-matching" value:@(100)];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 1000; i++) {
+            [self emitEvent:event];
+        }
+
+        [self.testStore waitForIdle];
+    }];
+}
+
+- (void)testScheduleLookupPerformance {
+    NSUInteger count = 1000;
+
+    // The fetch indexes only exist in SQLite stores
+    NSString *storeName = [NSString stringWithFormat:@"UAAutomationEngine.lookup.%@.test", [NSUUID UUID].UUIDString];
+    UAAutomationStore *store = [UAAutomationStore automationStoreWithStoreName:storeName
+                                                                 scheduleLimit:count
+                                                                      inMemory:NO
+                                                                          date:self.testDate];
+
+    NSMutableArray<UASchedule *> *schedules = [NSMutableArray array];
+    for (NSUInteger i = 0; i < count; i++) {
+        UAActionScheduleInfo *info = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+            builder.actions = @{@"cool": @"story"};
+            builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:1]];
+            builder.group = [NSString stringWithFormat:@"group-%lu", (unsigned long)(i % 100)];
+        }];
+
+        NSString *identifier = [NSString stringWithFormat:@"schedule-%lu", (unsigned long)i];
+        [schedules addObject:[UASchedule scheduleWithIdentifier:identifier info:info metadata:@{}]];
+    }
+
+    XCTestExpectation *saved = [self expectationWithDescription:@"saved"];
+    [store saveSchedules:schedules completionHandler:^(BOOL result) {
+        XCTAssertTrue(result);
+        [saved fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    // Look up every schedule by identifier, every group, and every schedule by state
+    [self measureBlock:^{
+        __block NSUInteger found = 0;
+
+        for (UASchedule *schedule in schedules) {
+            [store getSchedule:schedule.identifier completionHandler:^(UAScheduleData *scheduleData) {
+                if (scheduleData) {
+                    found++;
+                }
+            }];
+        }
+
+        for (NSUInteger i = 0; i < 100; i++) {
+            NSString *group = [NSString stringWithFormat:@"group-%lu", (unsigned long)i];
+            [store getSchedules:group completionHandler:^(NSArray<UAScheduleData *> *schedulesData) {
+                XCTAssertEqual(10, schedulesData.count);
+            }];
+        }
+
+        [store getSchedulesWithStates:@[@(UAScheduleStateIdle)] completionHandler:^(NSArray<UAScheduleData *> *schedulesData) {
+            XCTAssertEqual(count, schedulesData.count);
+        }];
+
+        [store waitForIdle];
+        XCTAssertEqual(count, found);
+    }];
+
+    [store shutDown];
+    [store waitForIdle];
+    [self deleteStoreWithName:storeName];
+}
+
+- (void)testMigrationFromVersion6 {
+    NSString *storeName = [NSString stringWithFormat:@"UAAutomationEngine.migration.%@.test", [NSUUID UUID].UUIDString];
+
+    // Create a version 6 store
+    NSURL *modelURL = [[UAirship resources] URLForResource:@"UAAutomation 6" withExtension:@"mom" subdirectory:@"UAAutomation.momd"];
+    NSManagedObjectModel *model = [[NSManagedObjectModel alloc] initWithContentsOfURL:modelURL];
+    XCTAssertNotNil(model);
+
+    // The current schedule data class does not match the old model
+    for (NSEntityDescription *entity in model.entities) {
+        entity.managedObjectClassName = NSStringFromClass([NSManagedObject class]);
+    }
+
+    NSManagedObjectContext *context = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    context.persistentStoreCoordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:model];
+
+    XCTestExpectation *created = [self expectationWithDescription:@"created"];
+    [context addPersistentSqlStore:storeName completionHandler:^(BOOL success, NSError *error) {
+        XCTAssertTrue(success);
+        [created fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    NSURL *storeURL = context.persistentStoreCoordinator.persistentStores.firstObject.URL;
+
+    NSArray *sources = @[@"remote-data", @"app-defined"];
+    [context performBlockAndWait:^{
+        for (NSString *source in sources) {
+            NSManagedObject *scheduleData = [NSEntityDescription insertNewObjectForEntityForName:@"UAScheduleData" inManagedObjectContext:context];
+            [scheduleData setValue:source forKey:@"identifier"];
+            [scheduleData setValue:source forKey:@"group"];
+            [scheduleData setValue:@(2) forKey:@"dataVersion"];
+            [scheduleData setValue:[NSJSONSerialization stringWithObject:@{@"source":source, @"extra":@{@"source":@"remote-data"}}] forKey:@"data"];
+            [scheduleData setValue:[NSDate distantFuture] forKey:@"end"];
+
+            NSManagedObject *triggerData = [NSEntityDescription insertNewObjectForEntityForName:@"UAScheduleTriggerData" inManagedObjectContext:context];
+            [triggerData setValue:@(UAScheduleTriggerForeground) forKey:@"type"];
+            [triggerData setValue:@(1) forKey:@"goal"];
+            [triggerData setValue:scheduleData forKey:@"schedule"];
+        }
+
+        NSError *error;
+        XCTAssertTrue([context save:&error], @"%@", error);
+        [context.persistentStoreCoordinator removePersistentStore:context.persistentStoreCoordinator.persistentStores.firstObject error:nil];
+    }];
+
+    // Open it as the current version
+    UAAutomationStore *store = [UAAutomationStore automationStoreWithStoreName:storeName
+                                                                 scheduleLimit:10
+                                                                      inMemory:NO
+                                                                          date:self.testDate];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [store getAllSchedules:^(NSArray<UAScheduleData *> *schedulesData) {
+        XCTAssertEqual(sources.count, schedulesData.count);
+        for (UAScheduleData *scheduleData in schedulesData) {
+            XCTAssertEqual(UAScheduleDataVersion, [scheduleData.dataVersion unsignedIntegerValue]);
+            XCTAssertEqualObjects(scheduleData.identifier, scheduleData.source);
+        }
+        [fetched fulfill];
+    }];
+
+    XCTestExpectation *fetchedBySource = [self expectationWithDescription:@"fetched by source"];
+    [store getScheduleIDsByGroupWithPredicate:[NSPredicate predicateWithFormat:@"source == %@", @"remote-data"] completionHandler:^(NSDictionary<NSString *, NSString *> *scheduleIDs) {
+        XCTAssertEqualObjects(@{@"remote-data":@"remote-data"}, scheduleIDs);
+        [fetchedBySource fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    [store shutDown];
+    [store waitForIdle];
+
+    // Verify the store was migrated to the current model
+    NSDictionary *metadata = [NSPersistentStoreCoordinator metadataForPersistentStoreOfType:NSSQLiteStoreType URL:storeURL options:nil error:nil];
+    NSURL *currentModelURL = [[UAirship resources] URLForResource:@"UAAutomation" withExtension:@"momd"];
+    NSManagedObjectModel *currentModel = [[NSManagedObjectModel alloc] initWithContentsOfURL:currentModelURL];
+    XCTAssertTrue([currentModel isConfiguration:nil compatibleWithStoreMetadata:metadata]);
+    XCTAssertFalse([model isConfiguration:nil compatibleWithStoreMetadata:metadata]);
+
+    [self deleteStoreWithName:storeName];
+}
+
+- (void)deleteStoreWithName:(NSString *)storeName {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    for (NSNumber *directory in @[@(NSLibraryDirectory), @(NSCachesDirectory)]) {
+        NSURL *directoryURL = [[fileManager URLsForDirectory:directory.unsignedIntegerValue inDomains:NSUserDomainMask] lastObject];
+        NSURL *storeURL = [[directoryURL URLByAppendingPathComponent:@"com.urbanairship.no-backup"] URLByAppendingPathComponent:storeName];
+        for (NSString *suffix in @[@"", @"-wal", @"-shm"]) {
+            NSURL *fileURL = [NSURL fileURLWithPath:[storeURL.path stringByAppendingString:suffix]];
+            [fileManager removeItemAtURL:fileURL error:nil];
+        }
+    }
+}
+
 - (void)verifyStateTrigger:(UAScheduleTrigger *)trigger {
     NSString *uuid = [NSUUID UUID].UUIDString;
     UAActionScheduleInfo *info = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder * _Nonnull builder) {
@@ -1491,6 +2438,7 @@
 }
 
 - (UAScheduleInfo *)createScheduleInfoWithBuilder:(UAScheduleInfoBuilder *)builder {
+    self.createScheduleInfoCount++;
     return [[UAActionScheduleInfo alloc] initWithBuilder:builder];
 }
 
@@ -0,0 +1,291 @@
+/* Copyright Airship and Contributors */
+
+#import <CoreData/CoreData.h>
+
+#import "UABaseTest.h"
+#import "UAAutomationStore+Internal.h"
+#import "UAScheduleData+Internal.h"
+#import "UAScheduleTriggerData+Internal.h"
+#import "UASchedule+Internal.h"
+#import "UAActionScheduleInfo.h"
+#import "UAScheduleDelay.h"
+#import "UATestDate.h"
+
+@interface UAAutomationStoreTest : UABaseTest
+@property (nonatomic, strong) UAAutomationStore *store;
+@property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) id saveObserver;
+@property (atomic, assign) NSUInteger triggerSaveCount;
+@end
+
+@implementation UAAutomationStoreTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.store = [UAAutomationStore automationStoreWithStoreName:@"UAAutomationStoreTest"
+                                                  scheduleLimit:100
+                                                       inMemory:YES
+                                                           date:self.testDate];
+
+    // Count saves that write trigger progress
+    UA_WEAKIFY(self)
+    self.saveObserver = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification
+                                                                          object:nil
+                                                                           queue:nil
+                                                                      usingBlock:^(NSNotification *notification) {
+        UA_STRONGIFY(self)
+        for (NSManagedObject *object in notification.userInfo[NSUpdatedObjectsKey]) {
+            if ([object isKindOfClass:[UAScheduleTriggerData class]]) {
+                self.triggerSaveCount++;
+                return;
+            }
+        }
+    }];
+
+    [self.store waitForIdle];
+}
+
+- (void)tearDown {
+    [[NSNotificationCenter defaultCenter] removeObserver:self.saveObserver];
+
+    [self.store shutDown];
+    [self.store waitForIdle];
+    self.store = nil;
+
+    [super tearDown];
+}
+
+/**
+ * Test triggers are loaded from the store when it opens.
+ */
+- (void)testTriggerIndexLoadedOnOpen {
+    NSString *storeName = [NSString stringWithFormat:@"UAAutomationStoreTest.%@", [NSUUID UUID].UUIDString];
+    UAAutomationStore *store = [UAAutomationStore automationStoreWithStoreName:storeName
+                                                                 scheduleLimit:100
+                                                                      inMemory:NO
+                                                                          date:self.testDate];
+    [self saveSchedules:@[[self scheduleWithID:@"foreground" group:nil triggers:@[[UAScheduleTrigger foregroundTriggerWithCount:2]]],
+                          [self scheduleWithID:@"background" group:nil triggers:@[[UAScheduleTrigger backgroundTriggerWithCount:2]]]]
+                  store:store];
+    [store shutDown];
+    [store waitForIdle];
+
+    // Reopen the store
+    store = [UAAutomationStore automationStoreWithStoreName:storeName
+                                              scheduleLimit:100
+                                                   inMemory:NO
+                                                       date:self.testDate];
+
+    XCTAssertEqualObjects(@[@"foreground"], [self activeTriggerScheduleIDs:UAScheduleTriggerAppForeground store:store]);
+    XCTAssertEqualObjects(@[@"background"], [self activeTriggerScheduleIDs:UAScheduleTriggerAppBackground store:store]);
+    XCTAssertEqualObjects(@[], [self activeTriggerScheduleIDs:UAScheduleTriggerScreen store:store]);
+
+    [store shutDown];
+    [store waitForIdle];
+    [self deleteStoreWithName:storeName];
+}
+
+/**
+ * Test trigger progress is kept on the indexed triggers between lookups.
+ */
+- (void)testTriggerProgressUpdatedInMemory {
+    [self saveSchedules:@[[self scheduleWithID:@"foo" group:nil triggers:@[[UAScheduleTrigger foregroundTriggerWithCount:2]]]]
+                  store:self.store];
+
+    [self.store getActiveTriggers:nil type:UAScheduleTriggerAppForeground completionHandler:^(NSArray<UAScheduleTriggerData *> *triggers) {
+        XCTAssertEqual(1, triggers.count);
+        triggers.firstObject.goalProgress = @(1);
+    }];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.store getActiveTriggers:@"foo" type:UAScheduleTriggerAppForeground completionHandler:^(NSArray<UAScheduleTriggerData *> *triggers) {
+        XCTAssertEqual(1, triggers.count);
+        XCTAssertEqualObjects(@(1), triggers.firstObject.goalProgress);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+/**
+ * Test new, edited and deleted schedules keep the index in sync.
+ */
+- (void)testTriggerIndexFollowsScheduleChanges {
+    [self saveSchedules:@[[self scheduleWithID:@"foo" group:@"group" triggers:@[[UAScheduleTrigger foregroundTriggerWithCount:1]]],
+                          [self scheduleWithID:@"bar" group:@"group" triggers:@[[UAScheduleTrigger foregroundTriggerWithCount:1]]],
+                          [self scheduleWithID:@"baz" group:nil triggers:@[[UAScheduleTrigger foregroundTriggerWithCount:1]]]]
+                  store:self.store];
+
+    NSArray *expected = @[@"bar", @"baz", @"foo"];
+    XCTAssertEqualObjects(expected, [self activeTriggerScheduleIDs:UAScheduleTriggerAppForeground store:self.store]);
+
+    // Pausing a schedule deactivates its triggers, and new schedules from an edit are indexed
+    XCTestExpectation *edited = [self expectationWithDescription:@"edited"];
+    [self.store editSchedulesWithIDs:@[@"foo"] editBlock:^(NSArray<UAScheduleData *> *schedulesData) {
+        schedulesData.firstObject.executionState = @(UAScheduleStatePaused);
+    } newSchedules:@[[self scheduleWithID:@"new" group:nil triggers:@[[UAScheduleTrigger foregroundTriggerWithCount:1]]]] completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [edited fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    expected = @[@"bar", @"baz", @"new"];
+    XCTAssertEqualObjects(expected, [self activeTriggerScheduleIDs:UAScheduleTriggerAppForeground store:self.store]);
+
+    // Deleted schedules are removed from the index
+    [self.store deleteSchedule:@"baz"];
+    expected = @[@"bar", @"new"];
+    XCTAssertEqualObjects(expected, [self activeTriggerScheduleIDs:UAScheduleTriggerAppForeground store:self.store]);
+
+    [self.store deleteSchedules:@"group"];
+    XCTAssertEqualObjects(@[@"new"], [self activeTriggerScheduleIDs:UAScheduleTriggerAppForeground store:self.store]);
+
+    [self.store deleteAllSchedules];
+    XCTAssertEqualObjects(@[], [self activeTriggerScheduleIDs:UAScheduleTriggerAppForeground store:self.store]);
+}
+
+/**
+ * Test cancellation triggers are only active while the schedule is pending execution.
+ */
+- (void)testCancellationTriggersIndexed {
+    UAActionScheduleInfo *info = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"cool": @"story"};
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:1]];
+        builder.delay = [UAScheduleDelay delayWithBuilderBlock:^(UAScheduleDelayBuilder *builder) {
+            builder.seconds = 100;
+            builder.cancellationTriggers = @[[UAScheduleTrigger backgroundTriggerWithCount:1]];
+        }];
+    }];
+
+    [self saveSchedules:@[[UASchedule scheduleWithIdentifier:@"foo" info:info metadata:@{}]] store:self.store];
+    XCTAssertEqualObjects(@[], [self activeTriggerScheduleIDs:UAScheduleTriggerAppBackground store:self.store]);
+
+    XCTestExpectation *edited = [self expectationWithDescription:@"edited"];
+    [self.store editSchedulesWithIDs:@[@"foo"] editBlock:^(NSArray<UAScheduleData *> *schedulesData) {
+        schedulesData.firstObject.executionState = @(UAScheduleStateTimeDelayed);
+    } newSchedules:@[] completionHandler:^(BOOL success) {
+        [edited fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    XCTAssertEqualObjects(@[@"foo"], [self activeTriggerScheduleIDs:UAScheduleTriggerAppBackground store:self.store]);
+    XCTAssertEqualObjects(@[], [self activeTriggerScheduleIDs:UAScheduleTriggerAppForeground store:self.store]);
+}
+
+/**
+ * Test trigger progress changes from several lookups are written in a single delayed save.
+ */
+- (void)testTriggerProgressSaveCoalesced {
+    [self saveSchedules:@[[self scheduleWithID:@"foo" group:nil triggers:@[[UAScheduleTrigger foregroundTriggerWithCount:10]]]]
+                  store:self.store];
+
+    for (NSUInteger i = 1; i <= 5; i++) {
+        [self.store getActiveTriggers:nil type:UAScheduleTriggerAppForeground completionHandler:^(NSArray<UAScheduleTriggerData *> *triggers) {
+            triggers.firstObject.goalProgress = @(i);
+        }];
+    }
+
+    [self.store waitForIdle];
+    XCTAssertEqual(0, self.triggerSaveCount);
+
+    // Wait past the save delay
+    XCTestExpectation *delayed = [self expectationWithDescription:@"delayed"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(1.5 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        [delayed fulfill];
+    });
+    [self waitForTestExpectations];
+    [self.store waitForIdle];
+
+    XCTAssertEqual(1, self.triggerSaveCount);
+}
+
+/**
+ * Test pending trigger progress is saved when the app enters the background.
+ */
+- (void)testTriggerProgressSavedOnBackground {
+    [self saveSchedules:@[[self scheduleWithID:@"foo" group:nil triggers:@[[UAScheduleTrigger foregroundTriggerWithCount:10]]]]
+                  store:self.store];
+
+    [self.store getActiveTriggers:nil type:UAScheduleTriggerAppForeground completionHandler:^(NSArray<UAScheduleTriggerData *> *triggers) {
+        triggers.firstObject.goalProgress = @(1);
+    }];
+    [self.store waitForIdle];
+    XCTAssertEqual(0, self.triggerSaveCount);
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationDidEnterBackgroundNotification object:nil];
+    [self.store waitForIdle];
+
+    XCTAssertEqual(1, self.triggerSaveCount);
+}
+
+/**
+ * Test pending trigger progress is saved before the app terminates.
+ */
+- (void)testTriggerProgressSavedOnTerminate {
+    [self saveSchedules:@[[self scheduleWithID:@"foo" group:nil triggers:@[[UAScheduleTrigger foregroundTriggerWithCount:10]]]]
+                  store:self.store];
+
+    [self.store getActiveTriggers:nil type:UAScheduleTriggerAppForeground completionHandler:^(NSArray<UAScheduleTriggerData *> *triggers) {
+        triggers.firstObject.goalProgress = @(1);
+    }];
+
+    // The save finishes before the notification returns
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationWillTerminateNotification object:nil];
+    XCTAssertEqual(1, self.triggerSaveCount);
+}
+
+#pragma mark -
+#pragma mark Helpers
+
+- (UASchedule *)scheduleWithID:(NSString *)identifier group:(NSString *)group triggers:(NSArray<UAScheduleTrigger *> *)triggers {
+    UAActionScheduleInfo *info = [UAActionScheduleInfo scheduleInfoWithBuilderBlock:^(UAActionScheduleInfoBuilder *builder) {
+        builder.actions = @{@"cool": @"story"};
+        builder.triggers = triggers;
+        builder.group = group;
+    }];
+
+    return [UASchedule scheduleWithIdentifier:identifier info:info metadata:@{}];
+}
+
+- (void)saveSchedules:(NSArray<UASchedule *> *)schedules store:(UAAutomationStore *)store {
+    XCTestExpectation *saved = [self expectationWithDescription:@"saved"];
+    [store saveSchedules:schedules completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [saved fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+/**
+ * Returns the sorted schedule identifiers of the active triggers.
+ */
+- (NSArray<NSString *> *)activeTriggerScheduleIDs:(UAScheduleTriggerType)type store:(UAAutomationStore *)store {
+    __block NSArray<NSString *> *scheduleIDs;
+    [store getActiveTriggers:nil type:type completionHandler:^(NSArray<UAScheduleTriggerData *> *triggers) {
+        NSMutableArray<NSString *> *identifiers = [NSMutableArray array];
+        for (UAScheduleTriggerData *trigger in triggers) {
+            [identifiers addObject:(trigger.schedule ?: trigger.delay.schedule).identifier];
+        }
+
+        scheduleIDs = [identifiers sortedArrayUsingSelector:@selector(compare:)];
+    }];
+
+    [store waitForIdle];
+    return scheduleIDs;
+}
+
+- (void)deleteStoreWithName:(NSString *)storeName {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    for (NSNumber *directory in @[@(NSLibraryDirectory), @(NSCachesDirectory)]) {
+        NSURL *directoryURL = [[fileManager URLsForDirectory:directory.unsignedIntegerValue inDomains:NSUserDomainMask] lastObject];
+        NSURL *storeURL = [[directoryURL URLByAppendingPathComponent:@"com.urbanairship.no-backup"] URLByAppendingPathComponent:storeName];
+        for (NSString *suffix in @[@"", @"-wal", @"-shm"]) {
+            [fileManager removeItemAtURL:[NSURL fileURLWithPath:[storeURL.path stringByAppendingString:suffix]] error:nil];
+        }
+    }
+}
+
+@end
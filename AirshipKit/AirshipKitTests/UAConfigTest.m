@@ -315,6 +315,7 @@
     XCTAssertTrue(copy.channelCaptureEnabled == config.channelCaptureEnabled);
     XCTAssertTrue(copy.customConfig == config.customConfig);
     XCTAssertTrue(copy.channelCreationDelayEnabled == config.channelCreationDelayEnabled);
+    XCTAssertTrue(copy.deferredComponentInitializationEnabled == config.deferredComponentInitializationEnabled);
     XCTAssertTrue(copy.defaultDetectProvisioningMode == config.defaultDetectProvisioningMode);
     XCTAssertTrue(copy.messageCenterStyleConfig == config.messageCenterStyleConfig);
     XCTAssertTrue(copy.itunesID == config.itunesID);
@@ -340,6 +341,7 @@
     XCTAssertTrue(config.channelCaptureEnabled);
     XCTAssertEqual(config.customConfig.count, 0);
     XCTAssertFalse(config.channelCreationDelayEnabled);
+    XCTAssertFalse(config.deferredComponentInitializationEnabled);
     XCTAssertTrue(config.defaultDetectProvisioningMode);
     XCTAssertTrue(config.requestAuthorizationToUseNotifications);
 }
@@ -0,0 +1,233 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+
+#import "UAEventBodyWriter+Internal.h"
+#import "UARequest+Internal.h"
+#import "UAJSONSerialization+Internal.h"
+
+@interface UAEventBodyWriterTest : UABaseTest
+@property (nonatomic, strong) UAEventBodyWriter *writer;
+@end
+
+@implementation UAEventBodyWriterTest
+
+- (void)setUp {
+    [super setUp];
+    self.writer = [UAEventBodyWriter bodyWriterWithCompression:NO];
+}
+
+- (NSData *)dataWithJSON:(id)object {
+    return [NSJSONSerialization dataWithJSONObject:object options:0 error:nil];
+}
+
+- (id)finishedJSON {
+    NSData *body = [self.writer finish];
+    XCTAssertNotNil(body);
+    return [NSJSONSerialization JSONObjectWithData:body options:0 error:nil];
+}
+
+/**
+ * Test events are wrapped in the envelope with the session ID added to their data.
+ */
+- (void)testAppendEvents {
+    XCTAssertTrue([self.writer appendEventWithID:@"event 1"
+                                            type:@"custom_event"
+                                            time:@"100.000"
+                                       sessionID:@"session"
+                                            data:[self dataWithJSON:@{@"cool": @"story", @"nested": @{@"value": @(1)}}]]);
+
+    XCTAssertTrue([self.writer appendEventWithID:@"event 2"
+                                            type:@"app_foreground"
+                                            time:@"200.000"
+                                       sessionID:@"session"
+                                            data:[self dataWithJSON:@{}]]);
+
+    NSArray *expected = @[@{@"event_id": @"event 1",
+                            @"type": @"custom_event",
+                            @"time": @"100.000",
+                            @"data": @{@"cool": @"story", @"nested": @{@"value": @(1)}, @"session_id": @"session"}},
+                          @{@"event_id": @"event 2",
+                            @"type": @"app_foreground",
+                            @"time": @"200.000",
+                            @"data": @{@"session_id": @"session"}}];
+
+    XCTAssertEqual(2, self.writer.eventCount);
+    XCTAssertEqualObjects(expected, [self finishedJSON]);
+}
+
+/**
+ * Test nil fields are omitted like they were when the body was built from dictionaries.
+ */
+- (void)testNilFields {
+    XCTAssertTrue([self.writer appendEventWithID:@"event"
+                                            type:nil
+                                            time:nil
+                                       sessionID:nil
+                                            data:[self dataWithJSON:@{@"cool": @"story"}]]);
+
+    NSArray *expected = @[@{@"event_id": @"event", @"data": @{@"cool": @"story"}}];
+    XCTAssertEqualObjects(expected, [self finishedJSON]);
+}
+
+/**
+ * Test envelope values are escaped.
+ */
+- (void)testEscaping {
+    NSString *type = @"quote \" backslash \\ newline \n tab \t control \x01 unicode é";
+
+    XCTAssertTrue([self.writer appendEventWithID:@"event"
+                                            type:type
+                                            time:@"100"
+                                       sessionID:@"session"
+                                            data:[self dataWithJSON:@{}]]);
+
+    NSArray *events = [self finishedJSON];
+    XCTAssertEqualObjects(type, events[0][@"type"]);
+}
+
+/**
+ * Test data with surrounding whitespace is spliced and data that is not a JSON object is rejected.
+ */
+- (void)testEventData {
+    NSData *whitespace = [@" \n{ \"cool\" : \"story\" }\n " dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertTrue([self.writer appendEventWithID:@"event" type:@"type" time:@"100" sessionID:@"session" data:whitespace]);
+
+    XCTAssertFalse([self.writer appendEventWithID:@"array" type:@"type" time:@"100" sessionID:@"session" data:[self dataWithJSON:@[@"cool"]]]);
+    XCTAssertFalse([self.writer appendEventWithID:@"invalid" type:@"type" time:@"100" sessionID:@"session" data:[@"{\"cool\"" dataUsingEncoding:NSUTF8StringEncoding]]);
+    XCTAssertFalse([self.writer appendEventWithID:@"nil" type:@"type" time:@"100" sessionID:@"session" data:nil]);
+
+    NSArray *expected = @[@{@"event_id": @"event",
+                            @"type": @"type",
+                            @"time": @"100",
+                            @"data": @{@"cool": @"story", @"session_id": @"session"}}];
+
+    XCTAssertEqual(1, self.writer.eventCount);
+    XCTAssertEqualObjects(expected, [self finishedJSON]);
+}
+
+/**
+ * Test a session ID already in the event data is replaced instead of written twice.
+ */
+- (void)testExistingSessionID {
+    XCTAssertTrue([self.writer appendEventWithID:@"event 1"
+                                            type:@"custom_event"
+                                            time:@"100.000"
+                                       sessionID:@"session"
+                                            data:[self dataWithJSON:@{@"cool": @"story", @"session_id": @"old session"}]]);
+
+    XCTAssertTrue([self.writer appendEventWithID:@"event 2"
+                                            type:@"custom_event"
+                                            time:@"200.000"
+                                       sessionID:nil
+                                            data:[self dataWithJSON:@{@"cool": @"story", @"session_id": @"old session"}]]);
+
+    NSData *body = [self.writer finish];
+    NSString *bodyString = [[NSString alloc] initWithData:body encoding:NSUTF8StringEncoding];
+    XCTAssertEqual(1, [bodyString componentsSeparatedByString:@"\"session_id\""].count - 1);
+
+    NSArray *expected = @[@{@"event_id": @"event 1",
+                            @"type": @"custom_event",
+                            @"time": @"100.000",
+                            @"data": @{@"cool": @"story", @"session_id": @"session"}},
+                          @{@"event_id": @"event 2",
+                            @"type": @"custom_event",
+                            @"time": @"200.000",
+                            @"data": @{@"cool": @"story"}}];
+
+    XCTAssertEqualObjects(expected, [NSJSONSerialization JSONObjectWithData:body options:0 error:nil]);
+}
+
+/**
+ * Test the default writer produces a gzip body.
+ */
+- (void)testCompressed {
+    UAEventBodyWriter *writer = [UAEventBodyWriter bodyWriter];
+    XCTAssertTrue(writer.isCompressed);
+
+    for (NSUInteger i = 0; i < 500; i++) {
+        [writer appendEventWithID:[NSUUID UUID].UUIDString
+                             type:@"custom_event"
+                             time:@"100.000"
+                        sessionID:@"session"
+                             data:[self dataWithJSON:@{@"cool": @"story"}]];
+    }
+
+    NSData *body = [writer finish];
+    XCTAssertTrue(body.length > 2);
+
+    const uint8_t *bytes = body.bytes;
+    XCTAssertEqual(0x1f, (int)bytes[0]);
+    XCTAssertEqual(0x8b, (int)bytes[1]);
+
+    // Finishing again returns the same body and appending is rejected
+    XCTAssertEqualObjects(body, [writer finish]);
+    XCTAssertFalse([writer appendEventWithID:@"event" type:@"type" time:@"100" sessionID:nil data:[self dataWithJSON:@{}]]);
+}
+
+/**
+ * Benchmark for building a compressed body by decoding each event, building the envelope
+ * dictionaries and compressing the serialized batch, like uploads did before the body writer.
+ */
+- (void)testDecodedBodyPerformance {
+    NSArray<NSData *> *eventData = [self benchmarkEventData];
+
+    [self measureBlock:^{
+        NSMutableArray *events = [NSMutableArray arrayWithCapacity:eventData.count];
+        for (NSUInteger i = 0; i < eventData.count; i++) {
+            NSMutableDictionary *data = [[NSJSONSerialization JSONObjectWithData:eventData[i] options:0 error:nil] mutableCopy];
+            [data setValue:@"session" forKey:@"session_id"];
+
+            [events addObject:@{@"event_id": [NSString stringWithFormat:@"event %lu", (unsigned long)i],
+                                @"type": @"custom_event",
+                                @"time": @"100.000",
+                                @"data": data}];
+        }
+
+        UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+            builder.URL = [NSURL URLWithString:@"https://combine.urbanairship.com/warp9/"];
+            builder.method = @"POST";
+            builder.body = [UAJSONSerialization dataWithJSONObject:events options:0 error:nil];
+            builder.compressBody = YES;
+        }];
+
+        XCTAssertTrue(request.body.length);
+    }];
+}
+
+/**
+ * Benchmark for building the same compressed body with the body writer.
+ */
+- (void)testBodyWriterPerformance {
+    NSArray<NSData *> *eventData = [self benchmarkEventData];
+
+    [self measureBlock:^{
+        UAEventBodyWriter *writer = [UAEventBodyWriter bodyWriter];
+        for (NSUInteger i = 0; i < eventData.count; i++) {
+            [writer appendEventWithID:[NSString stringWithFormat:@"event %lu", (unsigned long)i]
+                                 type:@"custom_event"
+                                 time:@"100.000"
+                            sessionID:@"session"
+                                 data:eventData[i]];
+        }
+
+        XCTAssertTrue([writer finish].length);
+    }];
+}
+
+/**
+ * Stored data for a full batch of custom events.
+ */
+- (NSArray<NSData *> *)benchmarkEventData {
+    NSMutableArray<NSData *> *eventData = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 2000; i++) {
+        [eventData addObject:[self dataWithJSON:@{@"event_name": @"purchase",
+                                                  @"event_value": @(i),
+                                                  @"transaction_id": [NSUUID UUID].UUIDString,
+                                                  @"properties": @{@"category": @"shoes", @"count": @(i % 10)}}]];
+    }
+
+    return eventData;
+}
+
+@end
@@ -5,6 +5,7 @@
 #import "UAEventManager+Internal.h"
 #import "UAEventStore+Internal.h"
 #import "UAEventAPIClient+Internal.h"
+#import "UAEventBodyWriter+Internal.h"
 #import "UAPreferenceDataStore+Internal.h"
 #import "UARuntimeConfig.h"
 #import "UACustomEvent.h"
@@ -38,6 +39,8 @@
 @property (nonatomic, strong) id mockAppStateTracker;
 @property (nonatomic, strong) id mockAirship;
 @property (nonatomic, strong) id mockChannel;
+@property (nonatomic, strong) id mockBodyWriter;
+@property (nonatomic, strong) NSMutableArray<UAEventBodyWriter *> *bodyWriters;
 
 @end
 
@@ -52,6 +55,15 @@
 
     self.mockChannel = [self mockForClass:[UAChannel class]];
 
+    // Use uncompressed body writers so uploaded bodies can be inspected
+    self.bodyWriters = [NSMutableArray array];
+    self.mockBodyWriter = [self mockForClass:[UAEventBodyWriter class]];
+    [[[self.mockBodyWriter stub] andDo:^(NSInvocation *invocation) {
+        UAEventBodyWriter *writer = [UAEventBodyWriter bodyWriterWithCompression:NO];
+        [self.bodyWriters addObject:writer];
+        [invocation setReturnValue:&writer];
+    }] bodyWriter];
+
     self.mockAirship = [self mockForClass:[UAirship class]];
     [UAirship setSharedAirship:self.mockAirship];
     [[[self.mockAirship stub] andReturn:self.mockChannel] channel];
@@ -363,15 +375,15 @@
     // Expect a call to the client, return a 200 response
     [[[self.mockClient expect] andDo:^(NSInvocation *invocation) {
         void *arg;
-        [invocation getArgument:&arg atIndex:3];
+        [invocation getArgument:&arg atIndex:4];
         void (^returnBlock)(NSHTTPURLResponse *response)= (__bridge void (^)(NSHTTPURLResponse *))arg;
 
         // Return a success response
         NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:200 HTTPVersion:nil headerFields:nil];
         returnBlock(response);
         [clientCalled fulfill];
-    }] uploadEvents:[OCMArg checkWithBlock:^BOOL(id obj) {
-        NSArray *events = (NSArray *)obj;
+    }] uploadEventBody:[OCMArg checkWithBlock:^BOOL(id obj) {
+        NSArray *events = [NSJSONSerialization JSONObjectWithData:obj options:0 error:nil];
         if (events.count != 1) {
             return NO;
         }
@@ -394,7 +406,7 @@
         }
 
         return YES;
-    }] completionHandler:OCMOCK_ANY];
+    }] gzipped:NO completionHandler:OCMOCK_ANY];
 
     // Expect the store to delete the event
     [[self.mockStore expect] deleteEventsWithIDs:@[@"mock_event_id"]];
@@ -409,6 +421,76 @@
     [self.mockStore verify];
 }
 
+/**
+ * Test uploading continues batch by batch until the store is drained.
+ */
+- (void)testScheduleUploadDrainsStoreInBatches {
+    // Set a channel ID
+    [[[self.mockChannel stub] andReturn:@"channel ID"] identifier];
+
+    // Run the operation as when added
+    [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
+        __weak NSOperation *operation = nil;
+        [invocation getArgument:&operation atIndex:2];
+        [operation start];
+
+        BOOL result = YES;
+        [invocation setReturnValue:&result];
+    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+
+    NSMutableArray<NSArray *> *batches = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 2; i++) {
+        UAEventTestData *eventData = [[UAEventTestData alloc] init];
+        eventData.type = @"mock_event";
+        eventData.time = @"100";
+        eventData.identifier = [NSString stringWithFormat:@"mock_event_id_%lu", (unsigned long)i];
+        eventData.sessionID = @"mock_event_session";
+        eventData.data = [NSJSONSerialization dataWithJSONObject:@{@"cool": @"story"} options:0 error:nil];
+        [batches addObject:@[eventData]];
+    }
+
+    // Return each batch, then an empty store
+    XCTestExpectation *drained = [self expectationWithDescription:@"Store drained"];
+    [[[[self.mockStore stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        void (^returnBlock)(NSArray *result)= (__bridge void (^)(NSArray *))arg;
+
+        if (batches.count) {
+            NSArray *batch = batches.firstObject;
+            [batches removeObjectAtIndex:0];
+            returnBlock(batch);
+        } else {
+            returnBlock(@[]);
+            [drained fulfill];
+        }
+    }] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
+
+    __block NSUInteger uploadCount = 0;
+    [[[self.mockClient stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^returnBlock)(NSHTTPURLResponse *response)= (__bridge void (^)(NSHTTPURLResponse *))arg;
+
+        uploadCount++;
+        NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:200 HTTPVersion:nil headerFields:nil];
+        returnBlock(response);
+    }] uploadEventBody:OCMOCK_ANY gzipped:NO completionHandler:OCMOCK_ANY];
+
+    // Expect each batch to be deleted
+    [[self.mockStore expect] deleteEventsWithIDs:@[@"mock_event_id_0"]];
+    [[self.mockStore expect] deleteEventsWithIDs:@[@"mock_event_id_1"]];
+
+    // Start the upload
+    [self.eventManager scheduleUpload];
+
+    [self waitForTestExpectations];
+
+    XCTAssertEqual(2, uploadCount);
+    [self.mockQueue verify];
+    [self.mockStore verify];
+}
+
 /**
  * Test uploading events when uploads are disabled.
  */
@@ -427,7 +509,7 @@
     [[[self.mockStore reject] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
 
     // Reject any calls to the client
-    [[self.mockClient reject] uploadEvents:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [[[self.mockClient reject] ignoringNonObjectArgs] uploadEventBody:OCMOCK_ANY gzipped:NO completionHandler:OCMOCK_ANY];
 
     // test
     [self.eventManager scheduleUpload];
@@ -491,13 +573,13 @@
     // Expect a call to the client, return a 200 response
     [[[self.mockClient expect] andDo:^(NSInvocation *invocation) {
         void *arg;
-        [invocation getArgument:&arg atIndex:3];
+        [invocation getArgument:&arg atIndex:4];
         void (^returnBlock)(NSHTTPURLResponse *response)= (__bridge void (^)(NSHTTPURLResponse *))arg;
 
         // Return a 400 response
         NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:400 HTTPVersion:nil headerFields:nil];
         returnBlock(response);
-    }] uploadEvents:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    }] uploadEventBody:OCMOCK_ANY gzipped:NO completionHandler:OCMOCK_ANY];
 
     // Expect the store to delete the event
     [[self.mockStore reject] deleteEventsWithIDs:OCMOCK_ANY];
@@ -541,7 +623,7 @@
 
     // Reject store and client calls
     [[[self.mockStore reject] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
-    [[self.mockClient reject] uploadEvents:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [[[self.mockClient reject] ignoringNonObjectArgs] uploadEventBody:OCMOCK_ANY gzipped:NO completionHandler:OCMOCK_ANY];
 
     // Start the upload
     [self.eventManager scheduleUpload];
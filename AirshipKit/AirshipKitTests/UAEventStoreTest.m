@@ -0,0 +1,263 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAEventStore+Internal.h"
+#import "UACustomEvent.h"
+
+@interface UAEventStoreTest : UABaseTest
+@property (nonatomic, strong) UAEventStore *eventStore;
+@property (nonatomic, strong) id mockDelegate;
+@end
+
+@implementation UAEventStoreTest
+
+- (void)setUp {
+    [super setUp];
+
+    [self deleteStore];
+
+    self.mockDelegate = [self mockForProtocol:@protocol(UAEventStoreDelegate)];
+    self.eventStore = [UAEventStore eventStoreWithConfig:self.config];
+    self.eventStore.delegate = self.mockDelegate;
+}
+
+- (void)tearDown {
+    [self waitForStore:self.eventStore];
+    self.eventStore = nil;
+    [self deleteStore];
+
+    [super tearDown];
+}
+
+/**
+ * Test the running total is loaded from the existing rows when the store opens.
+ */
+- (void)testTotalBytesSeededOnOpen {
+    [self saveEventCount:3 store:self.eventStore];
+    NSArray<NSNumber *> *eventBytes = [self eventBytes:self.eventStore];
+    XCTAssertEqual(3, eventBytes.count);
+
+    NSUInteger totalBytes = [[eventBytes valueForKeyPath:@"@sum.self"] unsignedIntegerValue];
+    NSUInteger oldestBytes = eventBytes.firstObject.unsignedIntegerValue;
+
+    // Reopen the store
+    self.eventStore = nil;
+    self.eventStore = [UAEventStore eventStoreWithConfig:self.config];
+    self.eventStore.delegate = self.mockDelegate;
+
+    // Only the oldest event needs to go
+    XCTestExpectation *trimmed = [self expectationWithDescription:@"trimmed"];
+    [[[self.mockDelegate expect] andDo:^(NSInvocation *invocation) {
+        [trimmed fulfill];
+    }] eventStore:self.eventStore didTrimEvents:1 bytes:oldestBytes];
+
+    [self.eventStore trimEventsToStoreSize:totalBytes - oldestBytes];
+
+    [self waitForTestExpectations];
+    [self.mockDelegate verify];
+    XCTAssertEqual(2, [self eventBytes:self.eventStore].count);
+}
+
+/**
+ * Test nothing is deleted while the store is under the limit.
+ */
+- (void)testTrimUnderLimit {
+    [self saveEventCount:5 store:self.eventStore];
+    NSUInteger totalBytes = [[[self eventBytes:self.eventStore] valueForKeyPath:@"@sum.self"] unsignedIntegerValue];
+
+    [[[self.mockDelegate reject] ignoringNonObjectArgs] eventStore:OCMOCK_ANY didTrimEvents:0 bytes:0];
+
+    [self.eventStore trimEventsToStoreSize:totalBytes];
+    [self.eventStore trimEventsToStoreSize:totalBytes * 2];
+
+    XCTAssertEqual(5, [self eventBytes:self.eventStore].count);
+    [self.mockDelegate verify];
+}
+
+/**
+ * Test trimming removes the oldest events across multiple chunks.
+ */
+- (void)testTrimOldestInChunks {
+    // More than two trim chunks
+    NSArray<NSString *> *eventIDs = [self saveEventCount:250 store:self.eventStore];
+    NSArray<NSNumber *> *eventBytes = [self eventBytes:self.eventStore];
+    XCTAssertEqual(250, eventBytes.count);
+
+    NSArray<NSNumber *> *keptBytes = [eventBytes subarrayWithRange:NSMakeRange(240, 10)];
+    NSUInteger maxSize = [[keptBytes valueForKeyPath:@"@sum.self"] unsignedIntegerValue];
+
+    [self.eventStore trimEventsToStoreSize:maxSize];
+
+    // Only the 10 newest events are left
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.eventStore fetchEventsWithMaxBatchSize:NSUIntegerMax completionHandler:^(NSArray<UAEventData *> *events) {
+        XCTAssertEqualObjects([eventIDs subarrayWithRange:NSMakeRange(240, 10)], [events valueForKey:@"identifier"]);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+/**
+ * Test the delegate is called with the number and size of the trimmed events.
+ */
+- (void)testTrimNotifiesDelegate {
+    [self saveEventCount:150 store:self.eventStore];
+    NSArray<NSNumber *> *eventBytes = [self eventBytes:self.eventStore];
+
+    NSArray<NSNumber *> *trimmedBytes = [eventBytes subarrayWithRange:NSMakeRange(0, 120)];
+    NSArray<NSNumber *> *keptBytes = [eventBytes subarrayWithRange:NSMakeRange(120, 30)];
+
+    NSUInteger expectedBytes = [[trimmedBytes valueForKeyPath:@"@sum.self"] unsignedIntegerValue];
+    NSUInteger maxSize = [[keptBytes valueForKeyPath:@"@sum.self"] unsignedIntegerValue];
+
+    XCTestExpectation *trimmed = [self expectationWithDescription:@"trimmed"];
+    [[[self.mockDelegate expect] andDo:^(NSInvocation *invocation) {
+        [trimmed fulfill];
+    }] eventStore:self.eventStore didTrimEvents:120 bytes:expectedBytes];
+
+    [self.eventStore trimEventsToStoreSize:maxSize];
+
+    [self waitForTestExpectations];
+    [self.mockDelegate verify];
+}
+
+/**
+ * Test fetching stops before the event that would go over the max batch size.
+ */
+- (void)testFetchStopsAtMaxBatchSize {
+    // More than one fetch batch
+    NSArray<NSString *> *eventIDs = [self saveEventCount:120 store:self.eventStore];
+    NSArray<NSNumber *> *eventBytes = [self eventBytes:self.eventStore];
+
+    // Room for 75 events plus part of the next one
+    NSUInteger maxBatchSize = [[[eventBytes subarrayWithRange:NSMakeRange(0, 75)] valueForKeyPath:@"@sum.self"] unsignedIntegerValue];
+    maxBatchSize += eventBytes[75].unsignedIntegerValue - 1;
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.eventStore fetchEventsWithMaxBatchSize:maxBatchSize completionHandler:^(NSArray<UAEventData *> *events) {
+        XCTAssertEqualObjects([eventIDs subarrayWithRange:NSMakeRange(0, 75)], [events valueForKey:@"identifier"]);
+        XCTAssertLessThanOrEqual([[events valueForKeyPath:@"@sum.bytes"] unsignedIntegerValue], maxBatchSize);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+/**
+ * Test events are fetched oldest first.
+ */
+- (void)testFetchOldestFirst {
+    NSArray<NSString *> *eventIDs = [self saveEventCount:10 store:self.eventStore];
+    NSArray<NSNumber *> *eventBytes = [self eventBytes:self.eventStore];
+    NSUInteger maxBatchSize = [[[eventBytes subarrayWithRange:NSMakeRange(0, 3)] valueForKeyPath:@"@sum.self"] unsignedIntegerValue];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.eventStore fetchEventsWithMaxBatchSize:maxBatchSize completionHandler:^(NSArray<UAEventData *> *events) {
+        XCTAssertEqualObjects([eventIDs subarrayWithRange:NSMakeRange(0, 3)], [events valueForKey:@"identifier"]);
+
+        for (NSUInteger i = 1; i < events.count; i++) {
+            XCTAssertNotEqual(NSOrderedDescending, [events[i - 1].storeDate compare:events[i].storeDate]);
+        }
+
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+/**
+ * Test an event larger than the max batch size is still fetched on its own, so it can not stall uploads.
+ */
+- (void)testFetchOversizedEvent {
+    UACustomEvent *largeEvent = [UACustomEvent eventWithName:@"large"];
+    for (NSUInteger i = 0; i < 4; i++) {
+        [largeEvent setStringProperty:[@"" stringByPaddingToLength:255 withString:@"a" startingAtIndex:0]
+                               forKey:[NSString stringWithFormat:@"value-%lu", (unsigned long)i]];
+    }
+    [self.eventStore saveEvent:largeEvent sessionID:@"session"];
+
+    NSArray<NSString *> *eventIDs = [self saveEventCount:2 store:self.eventStore];
+    NSArray<NSNumber *> *eventBytes = [self eventBytes:self.eventStore];
+
+    // Room for the two small events, but not the large one
+    NSUInteger maxBatchSize = eventBytes[1].unsignedIntegerValue + eventBytes[2].unsignedIntegerValue;
+    XCTAssertGreaterThan(eventBytes[0].unsignedIntegerValue, maxBatchSize);
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.eventStore fetchEventsWithMaxBatchSize:maxBatchSize completionHandler:^(NSArray<UAEventData *> *events) {
+        XCTAssertEqualObjects(@[largeEvent.eventID], [events valueForKey:@"identifier"]);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    // Once it is deleted the next events are fetched
+    [self.eventStore deleteEventsWithIDs:@[largeEvent.eventID]];
+
+    fetched = [self expectationWithDescription:@"fetched"];
+    [self.eventStore fetchEventsWithMaxBatchSize:maxBatchSize completionHandler:^(NSArray<UAEventData *> *events) {
+        XCTAssertEqualObjects(eventIDs, [events valueForKey:@"identifier"]);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+#pragma mark -
+#pragma mark Helpers
+
+- (NSArray<NSString *> *)saveEventCount:(NSUInteger)count store:(UAEventStore *)store {
+    NSMutableArray<NSString *> *eventIDs = [NSMutableArray array];
+    for (NSUInteger i = 0; i < count; i++) {
+        UACustomEvent *event = [UACustomEvent eventWithName:[NSString stringWithFormat:@"event-%lu", (unsigned long)i]];
+        [store saveEvent:event sessionID:@"session"];
+        [eventIDs addObject:event.eventID];
+    }
+
+    [self waitForStore:store];
+    return eventIDs;
+}
+
+/**
+ * Returns the size of each stored event, oldest first.
+ */
+- (NSArray<NSNumber *> *)eventBytes:(UAEventStore *)store {
+    __block NSArray<NSNumber *> *eventBytes;
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [store fetchEventsWithMaxBatchSize:NSUIntegerMax completionHandler:^(NSArray<UAEventData *> *events) {
+        eventBytes = [events valueForKey:@"bytes"];
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    return eventBytes;
+}
+
+/**
+ * Waits for the blocks already queued on the store's context.
+ */
+- (void)waitForStore:(UAEventStore *)store {
+    XCTestExpectation *idle = [self expectationWithDescription:@"idle"];
+    [store fetchEventsWithMaxBatchSize:0 completionHandler:^(NSArray<UAEventData *> *events) {
+        [idle fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+- (void)deleteStore {
+    NSString *storeName = [NSString stringWithFormat:@"Events-%@.sqlite", self.config.appKey];
+
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    for (NSNumber *directory in @[@(NSLibraryDirectory), @(NSCachesDirectory)]) {
+        NSURL *directoryURL = [[fileManager URLsForDirectory:directory.unsignedIntegerValue inDomains:NSUserDomainMask] lastObject];
+        NSURL *storeURL = [[directoryURL URLByAppendingPathComponent:@"com.urbanairship.no-backup"] URLByAppendingPathComponent:storeName];
+        for (NSString *suffix in @[@"", @"-wal", @"-shm"]) {
+            [fileManager removeItemAtURL:[NSURL fileURLWithPath:[storeURL.path stringByAppendingString:suffix]] error:nil];
+        }
+    }
+}
+
+@end
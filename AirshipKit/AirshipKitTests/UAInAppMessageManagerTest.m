@@ -22,6 +22,8 @@
 #import "UAInAppMessage+Internal.h"
 #import "UAInAppRemoteDataClient+Internal.h"
 #import "NSObject+AnonymousKVO+Internal.h"
+#import "UAAutomationStore+Internal.h"
+#import "UADate+Internal.h"
 
 
 @interface UAInAppMessageManagerTest : UABaseTest
@@ -1219,4 +1221,43 @@
     [self.mockAssetCache verify];
 }
 
+- (void)testRemoteDataSchedulePredicate {
+    UAAutomationStore *store = [UAAutomationStore automationStoreWithStoreName:@"UAInAppMessageManagerTest.source"
+                                                                 scheduleLimit:10
+                                                                      inMemory:YES
+                                                                          date:[[UADate alloc] init]];
+
+    UAInAppMessageScheduleInfo *(^scheduleInfo)(NSString *, UAInAppMessageSource) = ^(NSString *messageID, UAInAppMessageSource source) {
+        return [UAInAppMessageScheduleInfo scheduleInfoWithBuilderBlock:^(UAInAppMessageScheduleInfoBuilder *builder) {
+            builder.message = [UAInAppMessage messageWithBuilderBlock:^(UAInAppMessageBuilder *builder) {
+                builder.identifier = messageID;
+                builder.source = source;
+                // Extras that look like a remote-data source should not match
+                builder.extras = @{@"source":@"remote-data"};
+                builder.displayContent = [UAInAppMessageCustomDisplayContent displayContentWithValue:@{@"cool":@"story"}];
+            }];
+            builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:1]];
+        }];
+    };
+
+    NSArray *schedules = @[[UASchedule scheduleWithIdentifier:@"remote" info:scheduleInfo(@"remote message", UAInAppMessageSourceRemoteData) metadata:@{}],
+                           [UASchedule scheduleWithIdentifier:@"app" info:scheduleInfo(@"app message", UAInAppMessageSourceAppDefined) metadata:@{}],
+                           [UASchedule scheduleWithIdentifier:@"legacy" info:scheduleInfo(@"legacy message", UAInAppMessageSourceLegacyPush) metadata:@{}]];
+
+    XCTestExpectation *saved = [self expectationWithDescription:@"saved"];
+    [store saveSchedules:schedules completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [saved fulfill];
+    }];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [store getScheduleIDsByGroupWithPredicate:[UAInAppMessageManager remoteDataSchedulePredicate] completionHandler:^(NSDictionary<NSString *, NSString *> *scheduleIDs) {
+        XCTAssertEqualObjects(@{@"remote message":@"remote"}, scheduleIDs);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [store shutDown];
+}
+
 @end
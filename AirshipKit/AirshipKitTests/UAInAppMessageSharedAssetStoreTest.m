@@ -0,0 +1,168 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAInAppMessageSharedAssetStore+Internal.h"
+
+@interface UAInAppMessageSharedAssetStoreTest : UABaseTest
+@property (nonatomic, strong) UAInAppMessageSharedAssetStore *store;
+@property (nonatomic, strong) NSURL *rootURL;
+@property (nonatomic, strong) id mockSession;
+@property (nonatomic, strong) id mockTask;
+@property (nonatomic, strong) NSMutableArray *downloadHandlers;
+@end
+
+@implementation UAInAppMessageSharedAssetStoreTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.rootURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:@"com.urbanairship.test.sharedassets"];
+    [[NSFileManager defaultManager] removeItemAtURL:self.rootURL error:nil];
+
+    self.downloadHandlers = [NSMutableArray array];
+    self.mockTask = [self mockForClass:[NSURLSessionDownloadTask class]];
+    self.mockSession = [self mockForClass:[NSURLSession class]];
+    [[[self.mockSession stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        void (^completionHandler)(NSURL *, NSURLResponse *, NSError *) = (__bridge void (^)(NSURL *, NSURLResponse *, NSError *))arg;
+        [self.downloadHandlers addObject:[completionHandler copy]];
+
+        id mockTask = self.mockTask;
+        [invocation setReturnValue:(void *)&mockTask];
+    }] downloadTaskWithURL:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    self.store = [UAInAppMessageSharedAssetStore storeWithRootURL:self.rootURL byteBudget:100 session:self.mockSession];
+    XCTAssertNotNil(self.store);
+}
+
+- (void)tearDown {
+    [self.store removeAll];
+    [[NSFileManager defaultManager] removeItemAtURL:self.rootURL error:nil];
+    [super tearDown];
+}
+
+/**
+ * Completes the oldest pending download with a file of the given size.
+ */
+- (void)finishDownload:(NSURL *)assetURL size:(NSUInteger)size status:(NSInteger)status {
+    NSURL *temporaryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    [[NSMutableData dataWithLength:size] writeToURL:temporaryURL atomically:YES];
+
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:assetURL statusCode:status HTTPVersion:nil headerFields:nil];
+
+    void (^completionHandler)(NSURL *, NSURLResponse *, NSError *) = self.downloadHandlers.firstObject;
+    [self.downloadHandlers removeObjectAtIndex:0];
+    completionHandler(temporaryURL, response, nil);
+}
+
+- (NSURL *)fetch:(NSURL *)assetURL scheduleID:(NSString *)scheduleID {
+    __block NSURL *result;
+    [self.store fetchAssetWithURL:assetURL scheduleID:scheduleID completionHandler:^(NSURL *fileURL, NSURLResponse *response, NSError *error) {
+        result = fileURL;
+    }];
+    return result;
+}
+
+/**
+ * Test concurrent fetches of the same URL share one download and one file.
+ */
+- (void)testFetchesCoalesced {
+    NSURL *assetURL = [NSURL URLWithString:@"https://example.com/hero.png"];
+
+    NSMutableArray<NSURL *> *fileURLs = [NSMutableArray array];
+    for (NSString *scheduleID in @[@"one", @"two", @"three"]) {
+        [self.store fetchAssetWithURL:assetURL scheduleID:scheduleID completionHandler:^(NSURL *fileURL, NSURLResponse *response, NSError *error) {
+            [fileURLs addObject:fileURL];
+        }];
+    }
+
+    XCTAssertEqual(1, self.downloadHandlers.count);
+    [self finishDownload:assetURL size:10 status:200];
+
+    XCTAssertEqual(3, fileURLs.count);
+    XCTAssertEqual(1, [NSSet setWithArray:fileURLs].count);
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:fileURLs.firstObject.path]);
+    XCTAssertEqual(10, self.store.totalBytes);
+
+    // Already stored
+    XCTAssertEqualObjects(fileURLs.firstObject, [self fetch:assetURL scheduleID:@"four"]);
+    XCTAssertEqual(0, self.downloadHandlers.count);
+}
+
+/**
+ * Test failed downloads are reported to every waiting fetch and not stored.
+ */
+- (void)testFailedDownload {
+    NSURL *assetURL = [NSURL URLWithString:@"https://example.com/hero.png"];
+
+    __block NSUInteger failures = 0;
+    for (NSString *scheduleID in @[@"one", @"two"]) {
+        [self.store fetchAssetWithURL:assetURL scheduleID:scheduleID completionHandler:^(NSURL *fileURL, NSURLResponse *response, NSError *error) {
+            XCTAssertNil(fileURL);
+            XCTAssertEqual(503, ((NSHTTPURLResponse *)response).statusCode);
+            failures++;
+        }];
+    }
+
+    [self finishDownload:assetURL size:10 status:503];
+
+    XCTAssertEqual(2, failures);
+    XCTAssertNil([self.store retainAssetWithURL:assetURL scheduleID:@"one"]);
+    XCTAssertEqual(0, self.store.totalBytes);
+}
+
+/**
+ * Test assets in use are kept and unused assets are evicted least recently used first.
+ */
+- (void)testEviction {
+    NSURL *first = [NSURL URLWithString:@"https://example.com/first.png"];
+    NSURL *second = [NSURL URLWithString:@"https://example.com/second.png"];
+    NSURL *third = [NSURL URLWithString:@"https://example.com/third.png"];
+
+    [self fetch:first scheduleID:@"one"];
+    [self finishDownload:first size:40 status:200];
+
+    [self fetch:second scheduleID:@"two"];
+    [self finishDownload:second size:40 status:200];
+
+    // Over budget, but all of them are in use
+    [self fetch:third scheduleID:@"three"];
+    [self finishDownload:third size:40 status:200];
+    XCTAssertEqual(120, self.store.totalBytes);
+
+    // Releasing the first asset makes it the only one that can be evicted
+    [self.store releaseAssetsForScheduleID:@"one"];
+    XCTAssertEqual(80, self.store.totalBytes);
+    XCTAssertNil([self.store retainAssetWithURL:first scheduleID:@"one"]);
+
+    // Within budget, so unused assets are kept
+    [self.store releaseAssetsForScheduleID:@"two"];
+    [self.store releaseAssetsForScheduleID:@"three"];
+    XCTAssertEqual(80, self.store.totalBytes);
+
+    // The second asset is the least recently used
+    NSURL *fourth = [NSURL URLWithString:@"https://example.com/fourth.png"];
+    [self fetch:fourth scheduleID:@"four"];
+    [self finishDownload:fourth size:40 status:200];
+    XCTAssertEqual(80, self.store.totalBytes);
+
+    XCTAssertNil([self.store retainAssetWithURL:second scheduleID:@"five"]);
+    XCTAssertNotNil([self.store retainAssetWithURL:third scheduleID:@"five"]);
+    XCTAssertNotNil([self.store retainAssetWithURL:fourth scheduleID:@"five"]);
+}
+
+/**
+ * Test the store index survives reopening the store.
+ */
+- (void)testReload {
+    NSURL *assetURL = [NSURL URLWithString:@"https://example.com/hero.png"];
+    [self fetch:assetURL scheduleID:@"one"];
+    [self finishDownload:assetURL size:10 status:200];
+
+    UAInAppMessageSharedAssetStore *reloaded = [UAInAppMessageSharedAssetStore storeWithRootURL:self.rootURL byteBudget:100 session:self.mockSession];
+    XCTAssertEqual(10, reloaded.totalBytes);
+    XCTAssertNotNil([reloaded retainAssetWithURL:assetURL scheduleID:@"two"]);
+}
+
+@end
@@ -0,0 +1,97 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAInAppMessageUtils+Internal.h"
+
+// Display size used for decoding, roughly a full screen on a 3x device
+static CGFloat const UAInAppMessageUtilsTestMaxPixelSize = 2688;
+
+@interface UAInAppMessageUtilsTest : UABaseTest
+@end
+
+@implementation UAInAppMessageUtilsTest
+
+/**
+ * Creates PNG data for a solid image of the given size in pixels.
+ */
+- (NSData *)imageDataWithPixelSize:(CGSize)size {
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat defaultFormat];
+    format.scale = 1;
+
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:size format:format];
+    return [renderer PNGDataWithActions:^(UIGraphicsImageRendererContext *context) {
+        [[UIColor redColor] setFill];
+        [context fillRect:CGRectMake(0, 0, size.width, size.height)];
+        [[UIColor blueColor] setFill];
+        [context fillRect:CGRectMake(0, 0, size.width / 2, size.height / 2)];
+    }];
+}
+
+/**
+ * Test images smaller than the max pixel size are decoded at their original size.
+ */
+- (void)testDecodeSmallImage {
+    NSData *data = [self imageDataWithPixelSize:CGSizeMake(300, 200)];
+
+    UIImage *image = [UAInAppMessageUtils decodedImageWithData:data maxPixelSize:1000];
+    XCTAssertNotNil(image);
+    XCTAssertEqual(300, CGImageGetWidth(image.CGImage));
+    XCTAssertEqual(200, CGImageGetHeight(image.CGImage));
+    XCTAssertEqual(1, image.scale);
+    XCTAssertTrue(CGSizeEqualToSize(CGSizeMake(300, 200), image.size));
+}
+
+/**
+ * Test large images are downsampled to the max pixel size but keep their point size.
+ */
+- (void)testDecodeDownsamplesLargeImage {
+    NSData *data = [self imageDataWithPixelSize:CGSizeMake(2000, 1000)];
+
+    UIImage *image = [UAInAppMessageUtils decodedImageWithData:data maxPixelSize:500];
+    XCTAssertNotNil(image);
+    XCTAssertEqual(500, CGImageGetWidth(image.CGImage));
+    XCTAssertEqual(250, CGImageGetHeight(image.CGImage));
+    XCTAssertEqualWithAccuracy(2000, image.size.width, 0.5);
+    XCTAssertEqualWithAccuracy(1000, image.size.height, 0.5);
+}
+
+/**
+ * Test invalid data is not decoded.
+ */
+- (void)testDecodeInvalidData {
+    NSData *data = [@"not an image" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertNil([UAInAppMessageUtils decodedImageWithData:data maxPixelSize:500]);
+    XCTAssertNil([UAInAppMessageUtils decodedImageWithData:[NSData data] maxPixelSize:500]);
+}
+
+#pragma mark -
+#pragma mark Benchmarks
+
+- (void)measureDecodeWithPixelSize:(CGSize)size {
+    NSData *data = [self imageDataWithPixelSize:size];
+    XCTAssertNotNil([UAInAppMessageUtils decodedImageWithData:data maxPixelSize:UAInAppMessageUtilsTestMaxPixelSize]);
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10; i++) {
+            [UAInAppMessageUtils decodedImageWithData:data maxPixelSize:UAInAppMessageUtilsTestMaxPixelSize];
+        }
+    }];
+}
+
+- (void)testDecodePerformance512 {
+    [self measureDecodeWithPixelSize:CGSizeMake(512, 512)];
+}
+
+- (void)testDecodePerformance1024 {
+    [self measureDecodeWithPixelSize:CGSizeMake(1024, 1024)];
+}
+
+- (void)testDecodePerformance2048 {
+    [self measureDecodeWithPixelSize:CGSizeMake(2048, 2048)];
+}
+
+- (void)testDecodePerformance4096 {
+    [self measureDecodeWithPixelSize:CGSizeMake(4096, 4096)];
+}
+
+@end
@@ -7,7 +7,9 @@
 #import "UARemoteDataPayload+Internal.h"
 #import "UAUtils+Internal.h"
 #import "UAPreferenceDataStore+Internal.h"
-#import "UAInAppMessageManager.h"
+#import "UAInAppMessageManager+Internal.h"
+#import "UAInAppMessage+Internal.h"
+#import "UAInAppMessageScheduleInfo+Internal.h"
 #import "UAPush+Internal.h"
 #import "UASchedule+Internal.h"
 #import "UAScheduleEdits+Internal.h"
@@ -23,6 +25,7 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
 @property (nonatomic, strong) id mockChannel;
 
 @property (nonatomic, strong) NSMutableArray<UASchedule *> *allSchedules;
+@property (nonatomic, strong) NSMutableArray<NSDictionary *> *editBatches;
 @end
 
 @implementation UAInAppRemoteDataClientTest
@@ -60,7 +63,54 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
         void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
         completionHandler(self.allSchedules);
     }] getAllSchedules:OCMOCK_ANY];
-    
+
+    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        void (^completionHandler)(NSDictionary<NSString *, NSString *> *) = (__bridge void (^)(NSDictionary<NSString *, NSString *> *))arg;
+
+        NSMutableDictionary *scheduleIDs = [NSMutableDictionary dictionary];
+        for (UASchedule *schedule in self.allSchedules) {
+            UAInAppMessage *message = ((UAInAppMessageScheduleInfo *)schedule.info).message;
+            if (message.source == UAInAppMessageSourceRemoteData && message.identifier.length) {
+                scheduleIDs[message.identifier] = schedule.identifier;
+            }
+        }
+        completionHandler(scheduleIDs);
+    }] getRemoteDataScheduleIDs:OCMOCK_ANY];
+
+    // Forward batches to the single schedule calls so tests can verify each change
+    self.editBatches = [NSMutableArray array];
+    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits = (__bridge NSDictionary *)arg;
+
+        [invocation getArgument:&arg atIndex:3];
+        NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos = (__bridge NSArray *)arg;
+
+        [self.editBatches addObject:@{@"edits": [edits copy], @"infos": [scheduleInfos copy]}];
+
+        [invocation getArgument:&arg atIndex:4];
+        NSDictionary *metadata = (__bridge NSDictionary *)arg;
+
+        [invocation getArgument:&arg atIndex:5];
+        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
+
+        for (NSString *scheduleID in edits) {
+            [self.mockScheduler editScheduleWithID:scheduleID edits:edits[scheduleID] completionHandler:^(UASchedule *schedule) {}];
+        }
+
+        __block NSArray<UASchedule *> *schedules = @[];
+        if (scheduleInfos.count) {
+            [self.mockScheduler scheduleMessagesWithScheduleInfo:scheduleInfos metadata:metadata completionHandler:^(NSArray<UASchedule *> *result) {
+                schedules = result;
+            }];
+        }
+
+        completionHandler(schedules);
+    }] editSchedules:OCMOCK_ANY newScheduleInfos:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
     self.remoteDataClient = [UAInAppRemoteDataClient clientWithScheduler:self.mockScheduler remoteDataManager:self.mockRemoteDataManager dataStore:self.dataStore channel:self.mockChannel];
     XCTAssertNotNil(self.remoteDataClient);
     
@@ -951,6 +1001,74 @@ NSString * const UAInAppMessagesScheduledMessagesKey = @"UAInAppRemoteDataClient
     XCTAssertNil([self.dataStore dictionaryForKey:UAInAppMessagesScheduledMessagesKey]);
 }
 
+/**
+ * Test changed, ended, and new messages are applied with a single batch.
+ */
+- (void)testChangesAppliedInOneBatch {
+    NSDictionary *(^messageJSON)(NSString *, NSString *, NSString *) = ^NSDictionary *(NSString *messageID, NSString *created, NSString *updated) {
+        return @{@"message": @{
+                         @"name": @"Simple Message",
+                         @"message_id": messageID,
+                         @"display_type": @"banner",
+                         @"display": @{@"body" : @{@"text" : @"hi there"}},
+                         },
+                 @"created": created,
+                 @"last_updated": updated,
+                 @"triggers": @[@{@"type":@"app_init", @"goal":@1}]
+                 };
+    };
+
+    // Existing remote-data schedules
+    for (NSString *messageID in @[@"changed", @"ended"]) {
+        UAInAppMessageScheduleInfo *info = [UAInAppMessageScheduleInfo scheduleInfoWithJSON:messageJSON(messageID, @"2017-12-04T19:07:54.564", @"2017-12-04T19:07:54.564")
+                                                                                     source:UAInAppMessageSourceRemoteData
+                                                                                      error:nil];
+        [self.allSchedules addObject:[UASchedule scheduleWithIdentifier:[messageID stringByAppendingString:@"-schedule"] info:info metadata:@{}]];
+    }
+
+    [self.dataStore setObject:[UAUtils parseISO8601DateFromString:@"2017-12-05T00:00:00.000"] forKey:@"UAInAppRemoteDataClient.LastPayloadTimeStamp"];
+    [self.dataStore setObject:@{@"cool" : @"story"} forKey:@"UAInAppRemoteDataClient.LastPayloadMetadata"];
+
+    NSArray *inAppMessages = @[messageJSON(@"changed", @"2017-12-04T19:07:54.564", @"2017-12-06T00:00:00.000"),
+                               messageJSON(@"new", @"2017-12-06T00:00:00.000", @"2017-12-06T00:00:00.000")];
+
+    UARemoteDataPayload *payload = [[UARemoteDataPayload alloc] initWithType:@"in_app_messages"
+                                                                   timestamp:[UAUtils parseISO8601DateFromString:@"2017-12-07T00:00:00.000"]
+                                                                        data:@{@"in_app_messages":inAppMessages}
+                                                                    metadata:@{@"cool" : @"story"}];
+
+    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^completionHandler)(UASchedule *) = (__bridge void (^)(UASchedule *))arg;
+        completionHandler(nil);
+    }] editScheduleWithID:OCMOCK_ANY edits:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
+        completionHandler(@[]);
+    }] scheduleMessagesWithScheduleInfo:OCMOCK_ANY metadata:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    // test
+    self.publishBlock(@[payload]);
+    [self.remoteDataClient.operationQueue waitUntilAllOperationsAreFinished];
+
+    // verify
+    XCTAssertEqual(1, self.editBatches.count);
+
+    NSDictionary<NSString *, UAInAppMessageScheduleEdits *> *edits = self.editBatches.firstObject[@"edits"];
+    XCTAssertEqual(2, edits.count);
+    XCTAssertEqualObjects([NSDate distantFuture], edits[@"changed-schedule"].end);
+    XCTAssertEqualObjects(payload.timestamp, edits[@"ended-schedule"].end);
+    XCTAssertEqualObjects(payload.timestamp, edits[@"ended-schedule"].start);
+
+    NSArray<UAInAppMessageScheduleInfo *> *scheduleInfos = self.editBatches.firstObject[@"infos"];
+    XCTAssertEqual(1, scheduleInfos.count);
+    XCTAssertEqualObjects(@"new", scheduleInfos.firstObject.message.identifier);
+}
+
 - (UASchedule *)getScheduleForScheduleId:(NSString *)scheduleId {
     for (UASchedule *schedule in self.allSchedules) {
         if ([scheduleId isEqualToString:schedule.identifier]) {
@@ -90,6 +90,74 @@
 
 }
 
+/**
+ * Test syncing unchanged messages does not save the context.
+ */
+- (void)testSyncUnchangedMessages {
+    NSArray *messages = @[ [self createMessageDictionaryWithMessageID:@"message-0"],
+                           [self createMessageDictionaryWithMessageID:@"message-1"]];
+
+    [self.inboxStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+    }];
+    [self.inboxStore waitForIdle];
+
+    XCTestExpectation *saved = [self expectationForNotification:NSManagedObjectContextDidSaveNotification object:nil handler:^BOOL(NSNotification *notification) {
+        NSSet *updated = notification.userInfo[NSUpdatedObjectsKey];
+        for (NSManagedObject *object in updated) {
+            if ([object.entity.name isEqualToString:kUAInboxDBEntityName]) {
+                return YES;
+            }
+        }
+        return NO;
+    }];
+    saved.inverted = YES;
+
+    XCTestExpectation *synced = [self expectationWithDescription:@"synced"];
+    [self.inboxStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [synced fulfill];
+    }];
+
+    [self waitForExpectations:@[synced, saved] timeout:1];
+}
+
+/**
+ * Test syncing a large inbox where only some messages changed.
+ */
+- (void)testSyncLargeInbox {
+    NSMutableArray *messages = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 500; i++) {
+        [messages addObject:[self createMessageDictionaryWithMessageID:[NSString stringWithFormat:@"message-%lu", (unsigned long)i]]];
+    }
+
+    [self.inboxStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+    }];
+
+    NSMutableDictionary *message = [messages[250] mutableCopy];
+    message[@"title"] = @"differentTitle";
+    messages[250] = message;
+    [messages addObject:[self createMessageDictionaryWithMessageID:@"message-new"]];
+
+    [self.inboxStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+    }];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched messages"];
+    [self.inboxStore fetchMessagesWithPredicate:nil completionHandler:^(NSArray<UAInboxMessageData *> *messages) {
+        XCTAssertEqual(501, messages.count);
+
+        NSPredicate *modified = [NSPredicate predicateWithFormat:@"title == %@", @"differentTitle"];
+        NSArray *modifiedMessages = [messages filteredArrayUsingPredicate:modified];
+        XCTAssertEqual(1, modifiedMessages.count);
+        XCTAssertEqualObjects(@"message-250", [modifiedMessages.firstObject messageID]);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
 - (NSDictionary *)createMessageDictionaryWithMessageID:(NSString *)messageID {
     return @{@"message_id": messageID,
              @"title": @"someTitle",
@@ -0,0 +1,111 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAJSONPredicate.h"
+#import "UAJSONCompiledPredicate+Internal.h"
+
+@interface UAJSONCompiledPredicateTests : UABaseTest
+@property (nonatomic, copy) NSArray *predicateFixtures;
+@property (nonatomic, copy) NSArray *objectFixtures;
+@end
+
+@implementation UAJSONCompiledPredicateTests
+
+- (void)setUp {
+    [super setUp];
+
+    // Predicates from the JSON predicate, matcher and value matcher tests
+    NSDictionary *fooMatcher = @{ @"scope": @[@"foo"], @"value": @{ @"equals": @"bar" } };
+    NSDictionary *storyMatcher = @{ @"scope": @[@"cool"], @"value": @{ @"equals": @"story" } };
+    NSDictionary *stringMatcher = @{ @"value": @{ @"equals": @"cool" } };
+
+    self.predicateFixtures = @[
+        stringMatcher,
+        @{ @"value": @{ @"equals": @"cool" }, @"ignore_case": @YES },
+        @{ @"key": @"property", @"value": @{ @"equals": @"cool" } },
+        @{ @"key": @"property", @"value": @{ @"equals": @"cool" }, @"ignore_case": @YES },
+        @{ @"scope": @[@"property"], @"key": @"nested", @"value": @{ @"equals": @"cool" } },
+        @{ @"scope": @"property", @"value": @{ @"is_present": @YES } },
+        @{ @"scope": @"property", @"value": @{ @"is_present": @NO } },
+        @{ @"value": @{ @"equals": @NO } },
+        @{ @"value": @{ @"equals": @(123.35) } },
+        @{ @"value": @{ @"equals": @[@"cool", @"story"] }, @"ignore_case": @YES },
+        @{ @"value": @{ @"equals": @{ @"cool": @"STORY" } }, @"ignore_case": @YES },
+        @{ @"value": @{ @"at_least": @(100) } },
+        @{ @"value": @{ @"at_most": @(100) } },
+        @{ @"value": @{ @"at_least": @(10), @"at_most": @(100) } },
+        @{ @"value": @{ @"version_matches": @"1.0+" } },
+        @{ @"value": @{ @"version_matches": @"[1.0, 2.0[" } },
+        @{ @"value": @{ @"array_contains": stringMatcher } },
+        @{ @"value": @{ @"array_contains": stringMatcher, @"index": @(1) } },
+        @{ @"value": @{ @"array_contains": stringMatcher, @"index": @(-1) } },
+        @{ @"not": @[stringMatcher] },
+        @{ @"and": @[fooMatcher, storyMatcher] },
+        @{ @"or": @[fooMatcher, storyMatcher] },
+        @{ @"and": @[fooMatcher, @{ @"not": @[storyMatcher] }] },
+        @{ @"or": @[@{ @"and": @[fooMatcher, storyMatcher] }, @{ @"not": @[fooMatcher] }] },
+        @{ @"and": @[@{ @"scope": @[@"property"], @"key": @"nested", @"value": @{ @"equals": @"cool" } },
+                     @{ @"scope": @[@"property"], @"key": @"other", @"value": @{ @"is_present": @YES } }] },
+    ];
+
+    self.objectFixtures = @[
+        [NSNull null],
+        @"cool",
+        @"COOL",
+        @"CooL",
+        @"not cool",
+        @(1),
+        @(YES),
+        @(NO),
+        @(10),
+        @(100),
+        @(123.35),
+        @(1000),
+        @"1.0",
+        @"1.5.3",
+        @"2.0",
+        @[@"cool", @"story"],
+        @[@"COOL", @"STORY"],
+        @[@"story", @"cool"],
+        @[],
+        @{ @"cool": @"story" },
+        @{ @"cool": @"STORY" },
+        @{ @"property": @"cool" },
+        @{ @"property": @"COOL" },
+        @{ @"property": @"not cool" },
+        @{ @"property": @{ @"nested": @"cool", @"other": @"value" } },
+        @{ @"property": @{ @"nested": @"cool" } },
+        @{ @"foo": @"bar", @"cool": @"story" },
+        @{ @"foo": @"bar", @"cool": @"story", @"something": @"else" },
+        @{ @"foo": @"bar", @"cool": @"book" },
+        @{ @"foo": @"not bar" },
+    ];
+}
+
+- (void)testFixturesMatchPredicate {
+    for (NSDictionary *json in self.predicateFixtures) {
+        NSError *error;
+        UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSON:json error:&error];
+        XCTAssertNotNil(predicate, @"Invalid predicate fixture %@: %@", json, error);
+
+        UAJSONCompiledPredicate *compiledPredicate = [UAJSONCompiledPredicate compiledPredicateWithPredicate:predicate];
+
+        XCTAssertEqual([predicate evaluateObject:nil], [compiledPredicate evaluateObject:nil], @"Predicate: %@ Object: nil", json);
+
+        for (id object in self.objectFixtures) {
+            XCTAssertEqual([predicate evaluateObject:object], [compiledPredicate evaluateObject:object], @"Predicate: %@ Object: %@", json, object);
+        }
+    }
+}
+
+- (void)testEmptyCompoundPredicates {
+    UAJSONPredicate *andPredicate = [UAJSONPredicate andPredicateWithSubpredicates:@[]];
+    UAJSONPredicate *orPredicate = [UAJSONPredicate orPredicateWithSubpredicates:@[]];
+
+    for (id object in self.objectFixtures) {
+        XCTAssertEqual([andPredicate evaluateObject:object], [[UAJSONCompiledPredicate compiledPredicateWithPredicate:andPredicate] evaluateObject:object]);
+        XCTAssertEqual([orPredicate evaluateObject:object], [[UAJSONCompiledPredicate compiledPredicateWithPredicate:orPredicate] evaluateObject:object]);
+    }
+}
+
+@end
@@ -0,0 +1,88 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAPersistentQueueLog+Internal.h"
+
+@interface UAPersistentQueueLogTest : UABaseTest
+@property (nonatomic, copy) NSString *path;
+@end
+
+@implementation UAPersistentQueueLogTest
+
+- (void)setUp {
+    [super setUp];
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:self.path error:nil];
+    [super tearDown];
+}
+
+- (UAPersistentQueueLog *)reopenedLog {
+    return [[UAPersistentQueueLog alloc] initWithPath:self.path];
+}
+
+- (void)testReload {
+    UAPersistentQueueLog *log = [[UAPersistentQueueLog alloc] initWithPath:self.path];
+    [log appendObjects:@[@"one", @"two", @"three"]];
+    [log popObject];
+
+    XCTAssertEqualObjects((@[@"two", @"three"]), [[self reopenedLog] objects]);
+
+    [log setObjects:@[@"four"]];
+    XCTAssertEqualObjects(@[@"four"], [[self reopenedLog] objects]);
+
+    [log clear];
+    XCTAssertEqualObjects(@[], [[self reopenedLog] objects]);
+}
+
+- (void)testSharedLogs {
+    UAPersistentQueueLog *log = [UAPersistentQueueLog logWithPath:self.path];
+    XCTAssertEqual(log, [UAPersistentQueueLog logWithPath:self.path]);
+}
+
+/**
+ * Test popped records are compacted away without losing the remaining records.
+ */
+- (void)testCompaction {
+    UAPersistentQueueLog *log = [[UAPersistentQueueLog alloc] initWithPath:self.path];
+
+    NSString *padding = [@"" stringByPaddingToLength:512 withString:@"x" startingAtIndex:0];
+    NSMutableArray *objects = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 1000; i++) {
+        [objects addObject:[NSString stringWithFormat:@"%lu-%@", (unsigned long)i, padding]];
+    }
+
+    [log appendObjects:objects];
+    unsigned long long fullSize = [[[NSFileManager defaultManager] attributesOfItemAtPath:self.path error:nil] fileSize];
+
+    for (NSUInteger i = 0; i < 900; i++) {
+        XCTAssertEqualObjects(objects[i], [log popObject]);
+    }
+
+    unsigned long long compactedSize = [[[NSFileManager defaultManager] attributesOfItemAtPath:self.path error:nil] fileSize];
+    XCTAssertTrue(compactedSize < fullSize / 2);
+
+    NSArray *remaining = [objects subarrayWithRange:NSMakeRange(900, 100)];
+    XCTAssertEqualObjects(remaining, [log objects]);
+    XCTAssertEqualObjects(remaining, [[self reopenedLog] objects]);
+}
+
+/**
+ * Test a partially written record is dropped.
+ */
+- (void)testTruncatedRecord {
+    UAPersistentQueueLog *log = [[UAPersistentQueueLog alloc] initWithPath:self.path];
+    [log appendObjects:@[@"one", @"two"]];
+    log = nil;
+
+    NSFileHandle *handle = [NSFileHandle fileHandleForWritingAtPath:self.path];
+    unsigned long long length = [handle seekToEndOfFile];
+    [handle truncateFileAtOffset:length - 1];
+    [handle closeFile];
+
+    XCTAssertEqualObjects(@[@"one"], [[self reopenedLog] objects]);
+}
+
+@end
@@ -0,0 +1,93 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAPersistentQueue+Internal.h"
+
+static NSString * const UAPersistentQueueTestKey = @"com.urbanairship.test.persistent_queue";
+
+@interface UAPersistentQueueTest : UABaseTest
+@property (nonatomic, strong) UAPersistentQueue *queue;
+@end
+
+@implementation UAPersistentQueueTest
+
+- (void)setUp {
+    [super setUp];
+    self.queue = [UAPersistentQueue persistentQueueWithDataStore:self.dataStore key:UAPersistentQueueTestKey];
+}
+
+- (void)testAddPeekPop {
+    XCTAssertNil([self.queue peekObject]);
+    XCTAssertNil([self.queue popObject]);
+
+    [self.queue addObject:@"one"];
+    [self.queue addObjects:@[@"two", @"three"]];
+
+    XCTAssertEqualObjects(@"one", [self.queue peekObject]);
+    XCTAssertEqualObjects((@[@"one", @"two", @"three"]), [self.queue objects]);
+
+    XCTAssertEqualObjects(@"one", [self.queue popObject]);
+    XCTAssertEqualObjects(@"two", [self.queue popObject]);
+    XCTAssertEqualObjects(@"three", [self.queue peekObject]);
+    XCTAssertEqualObjects(@"three", [self.queue popObject]);
+
+    XCTAssertNil([self.queue peekObject]);
+    XCTAssertEqualObjects(@[], [self.queue objects]);
+}
+
+- (void)testSetObjectsAndClear {
+    [self.queue addObjects:@[@"one", @"two"]];
+
+    [self.queue setObjects:@[@"three"]];
+    XCTAssertEqualObjects(@[@"three"], [self.queue objects]);
+
+    [self.queue clear];
+    XCTAssertEqualObjects(@[], [self.queue objects]);
+}
+
+/**
+ * Test queues with the same data store and key share their contents.
+ */
+- (void)testSharedContents {
+    [self.queue addObjects:@[@"one", @"two"]];
+
+    UAPersistentQueue *other = [UAPersistentQueue persistentQueueWithDataStore:self.dataStore key:UAPersistentQueueTestKey];
+    XCTAssertEqualObjects(@"one", [other popObject]);
+
+    XCTAssertEqualObjects(@[@"two"], [self.queue objects]);
+
+    // Different key
+    UAPersistentQueue *unrelated = [UAPersistentQueue persistentQueueWithDataStore:self.dataStore key:@"com.urbanairship.test.other_queue"];
+    XCTAssertEqualObjects(@[], [unrelated objects]);
+}
+
+/**
+ * Test objects stored in the data store are migrated to the log.
+ */
+- (void)testMigration {
+    NSString *key = @"com.urbanairship.test.legacy_queue";
+    [self.dataStore setObject:[NSKeyedArchiver archivedDataWithRootObject:@[@"one", @"two"]] forKey:key];
+
+    UAPersistentQueue *queue = [UAPersistentQueue persistentQueueWithDataStore:self.dataStore key:key];
+    [queue addObject:@"three"];
+
+    XCTAssertEqualObjects((@[@"one", @"two", @"three"]), [queue objects]);
+    XCTAssertNil([self.dataStore objectForKey:key]);
+}
+
+/**
+ * Test resetting the data store clears the queue, including a queue that already opened its log.
+ */
+- (void)testDataStoreReset {
+    [self.queue addObjects:@[@"one", @"two"]];
+
+    [self.dataStore removeAll];
+
+    XCTAssertEqualObjects(@[], [self.queue objects]);
+
+    [self.queue addObject:@"three"];
+    UAPersistentQueue *other = [UAPersistentQueue persistentQueueWithDataStore:self.dataStore key:UAPersistentQueueTestKey];
+    XCTAssertEqualObjects(@[@"three"], [other objects]);
+}
+
+@end
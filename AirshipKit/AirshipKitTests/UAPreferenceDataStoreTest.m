@@ -63,4 +63,83 @@
     XCTAssertNil([self.dataStore objectForKey:@"key"]);
 }
 
+- (void)testWritesAreCoalesced {
+    NSString *prefix = [NSString stringWithFormat:@"%@.", [NSUUID UUID].UUIDString];
+    UAPreferenceDataStore *dataStore = [UAPreferenceDataStore preferenceDataStoreWithKeyPrefix:prefix];
+    NSString *prefixedKey = [prefix stringByAppendingString:@"key"];
+
+    [dataStore setObject:@"value" forKey:@"key"];
+
+    // Readable right away, but not written to NSUserDefaults until flushed
+    XCTAssertEqualObjects(@"value", [dataStore stringForKey:@"key"]);
+    XCTAssertNil([[NSUserDefaults standardUserDefaults] objectForKey:prefixedKey]);
+
+    // Other data stores with the same prefix see the pending value
+    UAPreferenceDataStore *other = [UAPreferenceDataStore preferenceDataStoreWithKeyPrefix:prefix];
+    XCTAssertEqualObjects(@"value", [other stringForKey:@"key"]);
+
+    [UAPreferenceDataStore flushPendingWrites];
+    XCTAssertEqualObjects(@"value", [[NSUserDefaults standardUserDefaults] objectForKey:prefixedKey]);
+
+    [dataStore removeObjectForKey:@"key"];
+    XCTAssertNil([dataStore objectForKey:@"key"]);
+
+    [UAPreferenceDataStore flushPendingWrites];
+    XCTAssertNil([[NSUserDefaults standardUserDefaults] objectForKey:prefixedKey]);
+
+    [dataStore removeAll];
+}
+
+- (void)testPendingWritesAreRemoved {
+    [self.dataStore setObject:@"value" forKey:@"key"];
+    [self.dataStore removeAll];
+    [UAPreferenceDataStore flushPendingWrites];
+
+    XCTAssertNil([self.dataStore objectForKey:@"key"]);
+}
+
+- (void)testTypedValues {
+    [self.dataStore setInteger:5 forKey:@"integer"];
+    [self.dataStore setDouble:200.12 forKey:@"double"];
+    [self.dataStore setBool:YES forKey:@"bool"];
+    [self.dataStore setObject:@"10" forKey:@"string"];
+    [self.dataStore setObject:@[@"first", @(2)] forKey:@"array"];
+
+    XCTAssertEqual(5, [self.dataStore integerForKey:@"integer"]);
+    XCTAssertEqualObjects(@"5", [self.dataStore stringForKey:@"integer"]);
+    XCTAssertEqual(200.12, [self.dataStore doubleForKey:@"double"]);
+    XCTAssertTrue([self.dataStore boolForKey:@"bool"]);
+    XCTAssertEqual(10, [self.dataStore integerForKey:@"string"]);
+    XCTAssertNil([self.dataStore stringArrayForKey:@"array"]);
+    XCTAssertNil([self.dataStore dictionaryForKey:@"array"]);
+    XCTAssertEqual(0, [self.dataStore integerForKey:@"array"]);
+    XCTAssertEqual(1.5, [self.dataStore doubleForKey:@"missing" defaultValue:1.5]);
+}
+
+- (void)testMutableValuesAreCopied {
+    NSMutableArray *array = [NSMutableArray arrayWithObject:@"first"];
+    [self.dataStore setObject:array forKey:@"array"];
+    [array addObject:@"second"];
+
+    XCTAssertEqualObjects(@[@"first"], [self.dataStore arrayForKey:@"array"]);
+}
+
+- (void)testArchivedObject {
+    NSDate *date = [NSDate dateWithTimeIntervalSince1970:100];
+    [self.dataStore setArchivedObject:date forKey:@"archived"];
+
+    XCTAssertTrue([[self.dataStore dataForKey:@"archived"] isKindOfClass:[NSData class]]);
+    XCTAssertEqualObjects(date, [self.dataStore unarchivedObjectOfClass:[NSDate class] forKey:@"archived"]);
+    XCTAssertNil([self.dataStore unarchivedObjectOfClass:[NSString class] forKey:@"archived"]);
+
+    // Replacing the raw value drops the unarchived object
+    NSDate *otherDate = [NSDate dateWithTimeIntervalSince1970:200];
+    [self.dataStore setObject:[NSKeyedArchiver archivedDataWithRootObject:otherDate] forKey:@"archived"];
+    XCTAssertEqualObjects(otherDate, [self.dataStore unarchivedObjectOfClass:[NSDate class] forKey:@"archived"]);
+
+    [self.dataStore setArchivedObject:nil forKey:@"archived"];
+    XCTAssertNil([self.dataStore unarchivedObjectOfClass:[NSDate class] forKey:@"archived"]);
+    XCTAssertFalse([self.dataStore keyExists:@"archived"]);
+}
+
 @end
@@ -25,11 +25,11 @@
 
 @implementation UATestRemoteDataStore
 
-- (void)overwriteCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads completionHandler:(void (^)(BOOL))completionHandler {
+- (void)updateCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads completionHandler:(void (^)(BOOL, NSSet<NSString *> *))completionHandler {
     if (self.failOverwriteCachedRemoteDataWithResponse) {
-        completionHandler(NO);
+        completionHandler(NO, [NSSet set]);
     } else {
-        [super overwriteCachedRemoteDataWithResponse:remoteDataPayloads completionHandler:completionHandler];
+        [super updateCachedRemoteDataWithResponse:remoteDataPayloads completionHandler:completionHandler];
     }
 }
 
@@ -577,6 +577,52 @@
     [subscription dispose];
 }
 
+// two clients (test) subscribe to different payload types
+// simulate a change to only one of the types
+// only the subscriber to the changed type should be notified
+- (void)testOnlyChangedTypesPublished {
+    // setup
+    NSMutableArray<UARemoteDataPayload *> *testPayloads = [[self createNPayloadsAndSetupTest:2 metadata:self.expectedMetadata] mutableCopy];
+
+    XCTestExpectation *firstExpectation = [self expectationWithDescription:@"Received first type"];
+    __block XCTestExpectation *secondExpectation = [self expectationWithDescription:@"Received second type"];
+
+    __block NSUInteger firstCallbackCount = 0;
+    UADisposable *firstSubscription = [self.remoteDataManager subscribeWithTypes:@[testPayloads[0].type] block:^(NSArray<UARemoteDataPayload *> * _Nonnull remoteDataArray) {
+        XCTAssertEqual(0, firstCallbackCount, @"Unchanged type should not be published again");
+        XCTAssertEqualObjects(@[testPayloads[0]], remoteDataArray);
+        firstCallbackCount++;
+        [firstExpectation fulfill];
+    }];
+
+    __block NSUInteger secondCallbackCount = 0;
+    UADisposable *secondSubscription = [self.remoteDataManager subscribeWithTypes:@[testPayloads[1].type] block:^(NSArray<UARemoteDataPayload *> * _Nonnull remoteDataArray) {
+        XCTAssertEqualObjects(@[testPayloads[1]], remoteDataArray);
+        secondCallbackCount++;
+        [secondExpectation fulfill];
+    }];
+
+    [self refresh];
+    [self waitForTestExpectations];
+
+    // setup with the second payload changed
+    testPayloads[1] = [self changePayload:testPayloads[1]];
+    [self setupTestWithPayloads:testPayloads];
+    secondExpectation = [self expectationWithDescription:@"Received changed type"];
+
+    // test
+    [self refresh];
+
+    // verify
+    [self waitForTestExpectations];
+    XCTAssertEqual(1, firstCallbackCount);
+    XCTAssertEqual(2, secondCallbackCount);
+
+    // cleanup
+    [firstSubscription dispose];
+    [secondSubscription dispose];
+}
+
 // client (test) subscribes to remote data manager
 // simulate multiple payloads from cloud, with at least two of a single type
 // all payloads should be published to client
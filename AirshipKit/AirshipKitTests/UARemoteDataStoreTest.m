@@ -30,8 +30,8 @@
     XCTestExpectation *testExpectation = [self expectationWithDescription:@"fetched remote data"];
     
     UARemoteDataPayload *testPayload = [self createRemoteDataPayload];
-    [self.remoteDataStore overwriteCachedRemoteDataWithResponse:@[testPayload]
-                            completionHandler:^(BOOL success) {
+    [self.remoteDataStore updateCachedRemoteDataWithResponse:@[testPayload]
+                            completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
                                 XCTAssertTrue(success);
                             }];
     
@@ -59,8 +59,8 @@
                                                       ];
     
     
-    [self.remoteDataStore overwriteCachedRemoteDataWithResponse:testPayloads
-                                   completionHandler:^(BOOL success) {
+    [self.remoteDataStore updateCachedRemoteDataWithResponse:testPayloads
+                                   completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
                                        XCTAssertTrue(success);
                                    }];
     
@@ -92,8 +92,8 @@
     
     
     // Sync only the modified message
-    [self.remoteDataStore overwriteCachedRemoteDataWithResponse:@[testPayload]
-                                   completionHandler:^(BOOL success) {
+    [self.remoteDataStore updateCachedRemoteDataWithResponse:@[testPayload]
+                                   completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
                                        XCTAssertTrue(success);
                             }];
     
@@ -116,6 +116,63 @@
     
 }
 
+- (void)testChangedTypes {
+    NSArray<UARemoteDataPayload *> *testPayloads = @[ [self createRemoteDataPayload],
+                                                      [self createRemoteDataPayload],
+                                                      [self createRemoteDataPayload]
+                                                      ];
+
+    XCTestExpectation *firstUpdate = [self expectationWithDescription:@"first update"];
+    [self.remoteDataStore updateCachedRemoteDataWithResponse:testPayloads
+                                           completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
+                                               XCTAssertTrue(success);
+                                               XCTAssertEqualObjects([NSSet setWithArray:[testPayloads valueForKey:@"type"]], changedTypes);
+                                               [firstUpdate fulfill];
+                                           }];
+
+    [self waitForTestExpectations];
+
+    // Same payloads
+    XCTestExpectation *secondUpdate = [self expectationWithDescription:@"second update"];
+    [self.remoteDataStore updateCachedRemoteDataWithResponse:testPayloads
+                                           completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
+                                               XCTAssertTrue(success);
+                                               XCTAssertEqual(0, changedTypes.count);
+                                               [secondUpdate fulfill];
+                                           }];
+
+    [self waitForTestExpectations];
+
+    // Update the first payload and drop the last one
+    UARemoteDataPayload *updatedPayload = [testPayloads[0] copy];
+    updatedPayload.timestamp = [testPayloads[0].timestamp dateByAddingTimeInterval:60];
+    updatedPayload.data = @{@"cool": @"story"};
+
+    XCTestExpectation *thirdUpdate = [self expectationWithDescription:@"third update"];
+    [self.remoteDataStore updateCachedRemoteDataWithResponse:@[updatedPayload, testPayloads[1]]
+                                           completionHandler:^(BOOL success, NSSet<NSString *> *changedTypes) {
+                                               XCTAssertTrue(success);
+                                               NSSet *expected = [NSSet setWithArray:@[testPayloads[0].type, testPayloads[2].type]];
+                                               XCTAssertEqualObjects(expected, changedTypes);
+                                               [thirdUpdate fulfill];
+                                           }];
+
+    XCTestExpectation *fetch = [self expectationWithDescription:@"fetched remote data"];
+    [self.remoteDataStore fetchRemoteDataFromCacheWithPredicate:nil
+                                              completionHandler:^(NSArray<UARemoteDataStorePayload *> *remoteDataStorePayloads) {
+                                                  XCTAssertEqual(2, remoteDataStorePayloads.count);
+                                                  for (UARemoteDataStorePayload *dataStorePayload in remoteDataStorePayloads) {
+                                                      UARemoteDataPayload *expected = [dataStorePayload.type isEqualToString:updatedPayload.type] ? updatedPayload : testPayloads[1];
+                                                      XCTAssertEqualObjects(expected.type, dataStorePayload.type);
+                                                      XCTAssertEqualObjects(expected.timestamp, dataStorePayload.timestamp);
+                                                      XCTAssertEqualObjects(expected.data, dataStorePayload.data);
+                                                  }
+                                                  [fetch fulfill];
+                                              }];
+
+    [self waitForTestExpectations];
+}
+
 - (UARemoteDataPayload *)createRemoteDataPayload {
     UARemoteDataPayload *testPayload = [[UARemoteDataPayload alloc] initWithType:[[NSProcessInfo processInfo] globallyUniqueString]
                                                                        timestamp:[NSDate date]
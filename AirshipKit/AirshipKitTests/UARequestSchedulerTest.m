@@ -0,0 +1,167 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UARequestScheduler+Internal.h"
+
+@interface UARequestSchedulerTest : UABaseTest
+@property (nonatomic, strong) UARequestScheduler *scheduler;
+@end
+
+@implementation UARequestSchedulerTest
+
+- (void)setUp {
+    [super setUp];
+    self.scheduler = [UARequestScheduler schedulerWithMaxConcurrentRequestsPerHost:1];
+}
+
+/**
+ * Returns an operation that blocks until the semaphore is signaled.
+ */
+- (NSOperation *)blockingOperation:(dispatch_semaphore_t)semaphore {
+    return [NSBlockOperation blockOperationWithBlock:^{
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    }];
+}
+
+/**
+ * Test waiting requests to the same host start in priority order.
+ */
+- (void)testPriority {
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [self.scheduler scheduleOperation:[self blockingOperation:semaphore] host:@"example.com" priority:UARequestPriorityRegistration];
+
+    NSMutableArray<NSNumber *> *order = [NSMutableArray array];
+    XCTestExpectation *finished = [self expectationWithDescription:@"requests finished"];
+    finished.expectedFulfillmentCount = 3;
+
+    for (NSNumber *priority in @[@(UARequestPriorityAnalytics), @(UARequestPriorityRemoteData), @(UARequestPriorityRegistration)]) {
+        NSOperation *operation = [NSBlockOperation blockOperationWithBlock:^{
+            @synchronized (order) {
+                [order addObject:priority];
+            }
+            [finished fulfill];
+        }];
+
+        [self.scheduler scheduleOperation:operation host:@"example.com" priority:priority.integerValue];
+    }
+
+    dispatch_semaphore_signal(semaphore);
+    [self waitForTestExpectations];
+
+    NSArray *expected = @[@(UARequestPriorityRegistration), @(UARequestPriorityRemoteData), @(UARequestPriorityAnalytics)];
+    XCTAssertEqualObjects(expected, order);
+}
+
+/**
+ * Test waiting requests to different hosts start in priority order.
+ */
+- (void)testPriorityAcrossHosts {
+    self.scheduler = [UARequestScheduler schedulerWithMaxConcurrentRequests:1 maxConcurrentRequestsPerHost:1];
+
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [self.scheduler scheduleOperation:[self blockingOperation:semaphore] host:@"device-api.example.com" priority:UARequestPriorityRegistration];
+
+    NSMutableArray<NSString *> *order = [NSMutableArray array];
+    XCTestExpectation *finished = [self expectationWithDescription:@"requests finished"];
+    finished.expectedFulfillmentCount = 4;
+
+    NSArray *requests = @[@[@"combine.example.com", @(UARequestPriorityAnalytics)],
+                          @[@"remote-data.example.com", @(UARequestPriorityRemoteData)],
+                          @[@"combine.example.com", @(UARequestPriorityAnalytics)],
+                          @[@"device-api.example.com", @(UARequestPriorityRegistration)]];
+
+    for (NSArray *request in requests) {
+        NSString *name = [NSString stringWithFormat:@"%@ %@", request[0], request[1]];
+        NSOperation *operation = [NSBlockOperation blockOperationWithBlock:^{
+            @synchronized (order) {
+                [order addObject:name];
+            }
+            [finished fulfill];
+        }];
+
+        [self.scheduler scheduleOperation:operation host:request[0] priority:[request[1] integerValue]];
+    }
+
+    dispatch_semaphore_signal(semaphore);
+    [self waitForTestExpectations];
+
+    NSArray *expected = @[[NSString stringWithFormat:@"device-api.example.com %@", @(UARequestPriorityRegistration)],
+                          [NSString stringWithFormat:@"remote-data.example.com %@", @(UARequestPriorityRemoteData)],
+                          [NSString stringWithFormat:@"combine.example.com %@", @(UARequestPriorityAnalytics)],
+                          [NSString stringWithFormat:@"combine.example.com %@", @(UARequestPriorityAnalytics)]];
+    XCTAssertEqualObjects(expected, order);
+}
+
+/**
+ * Test a request waiting on another request does not hold a slot.
+ */
+- (void)testDependencyDoesNotHoldSlot {
+    self.scheduler = [UARequestScheduler schedulerWithMaxConcurrentRequests:1 maxConcurrentRequestsPerHost:1];
+
+    NSMutableArray<NSString *> *order = [NSMutableArray array];
+    XCTestExpectation *finished = [self expectationWithDescription:@"requests finished"];
+    finished.expectedFulfillmentCount = 2;
+
+    NSOperation *first = [NSBlockOperation blockOperationWithBlock:^{
+        @synchronized (order) {
+            [order addObject:@"first"];
+        }
+        [finished fulfill];
+    }];
+
+    NSOperation *second = [NSBlockOperation blockOperationWithBlock:^{
+        @synchronized (order) {
+            [order addObject:@"second"];
+        }
+        [finished fulfill];
+    }];
+    [second addDependency:first];
+
+    // Scheduled before the operation it depends on, with a higher priority
+    [self.scheduler scheduleOperation:second host:@"example.com" priority:UARequestPriorityRegistration];
+    [self.scheduler scheduleOperation:first host:@"example.com" priority:UARequestPriorityAnalytics];
+
+    [self waitForTestExpectations];
+
+    NSArray *expected = @[@"first", @"second"];
+    XCTAssertEqualObjects(expected, order);
+}
+
+/**
+ * Test a cancelled request that is waiting for a slot finishes without waiting for the slot.
+ */
+- (void)testCancelledRequestDoesNotWaitForSlot {
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [self.scheduler scheduleOperation:[self blockingOperation:semaphore] host:@"example.com" priority:UARequestPriorityRegistration];
+
+    NSOperation *cancelled = [NSBlockOperation blockOperationWithBlock:^{
+        XCTFail(@"Cancelled operation should not run");
+    }];
+    [self.scheduler scheduleOperation:cancelled host:@"example.com" priority:UARequestPriorityAnalytics];
+
+    [self keyValueObservingExpectationForObject:cancelled keyPath:@"isFinished" expectedValue:@YES];
+
+    [cancelled cancel];
+    [self.scheduler startPendingOperations];
+
+    [self waitForTestExpectations];
+    dispatch_semaphore_signal(semaphore);
+}
+
+/**
+ * Test requests to one host do not wait for requests to another host.
+ */
+- (void)testHostsRunIndependently {
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [self.scheduler scheduleOperation:[self blockingOperation:semaphore] host:@"slow.example.com" priority:UARequestPriorityRegistration];
+
+    XCTestExpectation *finished = [self expectationWithDescription:@"request finished"];
+    [self.scheduler scheduleOperation:[NSBlockOperation blockOperationWithBlock:^{
+        [finished fulfill];
+    }] host:@"fast.example.com" priority:UARequestPriorityAnalytics];
+
+    [self waitForTestExpectations];
+    dispatch_semaphore_signal(semaphore);
+}
+
+@end
@@ -3,11 +3,13 @@
 #import "UABaseTest.h"
 #import "UARequestSession+Internal.h"
 #import "UAURLRequestOperation+Internal.h"
-#import "UADelayOperation+Internal.h"
+#import "UATestDispatcher.h"
 
 @interface UARequestSessionTest : UABaseTest
 @property (nonatomic, strong) id mockNSURLSession;
-@property (nonatomic, strong) id mockQueue;
+@property (nonatomic, strong) id mockScheduler;
+@property (nonatomic, strong) NSMutableArray<NSOperation *> *scheduledOperations;
+@property (nonatomic, strong) UATestDispatcher *testDispatcher;
 @property (nonatomic, strong) UARequestSession *session;
 @end
 
@@ -16,22 +18,42 @@
 - (void)setUp {
     [super setUp];
 
-    self.mockQueue = [self mockForClass:[NSOperationQueue class]];
+    self.scheduledOperations = [NSMutableArray array];
+    self.mockScheduler = [self mockForClass:[UARequestScheduler class]];
 
-    // Stub the queue to run UAURLRequestOperation immediately
-    [[[self.mockQueue stub] andDo:^(NSInvocation *invocation) {
+    // Stub the scheduler to run UAURLRequestOperation immediately
+    [[[self.mockScheduler stub] andDo:^(NSInvocation *invocation) {
         void *arg;
         [invocation getArgument:&arg atIndex:2];
         NSOperation *operation = (__bridge NSOperation *)arg;
+        [self.scheduledOperations addObject:operation];
         [operation start];
-    }] addOperation:[OCMArg checkWithBlock:^BOOL(id obj) {
+    }] scheduleOperation:[OCMArg checkWithBlock:^BOOL(id obj) {
         return [obj isKindOfClass:[UAURLRequestOperation class]];
-    }]];
+    }] host:OCMOCK_ANY priority:UARequestPriorityRegistration];
 
     self.mockNSURLSession = [self mockForClass:[NSURLSession class]];
+    self.testDispatcher = [UATestDispatcher testDispatcher];
     self.session = [UARequestSession sessionWithConfig:self.config
                                           NSURLSession:self.mockNSURLSession
-                                                 queue:self.mockQueue];
+                                             scheduler:self.mockScheduler
+                                              priority:UARequestPriorityRegistration
+                                            dispatcher:self.testDispatcher];
+}
+
+/**
+ * Stubs the NSURLSession to capture the completion handler of each data task.
+ */
+- (NSMutableArray<UARequestCompletionHandler> *)captureDataTasks {
+    NSMutableArray<UARequestCompletionHandler> *completionHandlers = [NSMutableArray array];
+
+    [(NSURLSession *)[[self.mockNSURLSession stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        [completionHandlers addObject:[(__bridge UARequestCompletionHandler)arg copy]];
+    }] dataTaskWithRequest:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    return completionHandlers;
 }
 
 - (void)testDataTask {
@@ -139,28 +161,166 @@
     // Verify the session was called
     [self.mockNSURLSession verify];
 
-    // Verify a delay was added for 30 seconds
-    [[self.mockQueue expect] addOperation:[OCMArg checkWithBlock:^BOOL(id obj) {
-        if (![obj isKindOfClass:[UADelayOperation class]]) {
-            return NO;
-        }
+    // Call the captured completion handler with the return data
+    completionHandler(nil, nil, nil);
+    XCTAssertTrue(retryBlockCalled);
 
-        UADelayOperation *operation = (UADelayOperation *)obj;
-        return operation.seconds == 30;
-    }]];
+    // Verify the retry waits on the dispatcher instead of the queue, with a jittered delay of 15 to 30 seconds
+    XCTAssertEqual(1, self.testDispatcher.scheduledBlocks.count);
+    NSTimeInterval delay = self.testDispatcher.scheduledBlocks.firstObject.time;
+    XCTAssertGreaterThanOrEqual(delay, 15);
+    XCTAssertLessThanOrEqual(delay, 30);
+
+    // Verify the request runs again after the delay
+    completionHandler = nil;
+    [self.testDispatcher advanceTime:30];
+    XCTAssertNotNil(completionHandler);
+    XCTAssertEqual(0, self.testDispatcher.scheduledBlocks.count);
+}
 
-    completionHandler(nil, nil, nil);
+/**
+ * Test other requests run while a request is waiting to be retried.
+ */
+- (void)testRetryDoesNotBlockQueue {
+    NSMutableArray<UARequestCompletionHandler> *completionHandlers = [self captureDataTasks];
 
-    [self.mockQueue verify];
+    UARequest *failing = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"POST";
+        builder.URL = [NSURL URLWithString:@"https://example.com/failing"];
+    }];
 
-    // Call the captured completion handler with the return data
-    XCTAssertTrue(retryBlockCalled);
+    UARequest *other = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"POST";
+        builder.URL = [NSURL URLWithString:@"https://example.com/other"];
+    }];
+
+    [self.session dataTaskWithRequest:failing retryWhere:^BOOL(NSData *data, NSURLResponse *response) {
+        return YES;
+    } completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        XCTFail(@"Completion handler should not be called during retries");
+    }];
+
+    completionHandlers[0](nil, nil, nil);
+    XCTAssertEqual(1, self.testDispatcher.scheduledBlocks.count);
+
+    __block BOOL otherCompleted = NO;
+    [self.session dataTaskWithRequest:other completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        otherCompleted = YES;
+    }];
+
+    XCTAssertEqual(2, completionHandlers.count);
+    completionHandlers[1](nil, nil, nil);
+    XCTAssertTrue(otherCompleted);
+}
+
+/**
+ * Test the completion handler is called with the last response once the retry budget is used up.
+ */
+- (void)testRetryBudget {
+    NSMutableArray<UARequestCompletionHandler> *completionHandlers = [self captureDataTasks];
+
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"POST";
+        builder.URL = [NSURL URLWithString:@"https://example.com"];
+    }];
+
+    __block NSUInteger retryBlockCalls = 0;
+    __block NSURLResponse *lastResponse;
+    [self.session dataTaskWithRequest:request retryWhere:^BOOL(NSData *data, NSURLResponse *response) {
+        retryBlockCalls++;
+        return YES;
+    } completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        lastResponse = response;
+    }];
+
+    NSURLResponse *response = [[NSURLResponse alloc] init];
+    for (NSUInteger i = 0; i < UARequestSessionMaxRetries; i++) {
+        XCTAssertEqual(i + 1, completionHandlers.count);
+        completionHandlers.lastObject(nil, response, nil);
+        XCTAssertNil(lastResponse);
+
+        // The delay doubles up to the max backoff, so advancing by the max always runs the retry
+        [self.testDispatcher advanceTime:3000];
+    }
+
+    XCTAssertEqual(UARequestSessionMaxRetries + 1, completionHandlers.count);
+    completionHandlers.lastObject(nil, response, nil);
+
+    XCTAssertEqual(response, lastResponse);
+    XCTAssertEqual(UARequestSessionMaxRetries, retryBlockCalls);
+    XCTAssertEqual(0, self.testDispatcher.scheduledBlocks.count);
+}
+
+/**
+ * Test cancelling drops retries that are waiting.
+ */
+- (void)testCancelPendingRetry {
+    NSMutableArray<UARequestCompletionHandler> *completionHandlers = [self captureDataTasks];
+
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"POST";
+        builder.URL = [NSURL URLWithString:@"https://example.com"];
+    }];
+
+    [self.session dataTaskWithRequest:request retryWhere:^BOOL(NSData *data, NSURLResponse *response) {
+        return YES;
+    } completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        XCTFail(@"Completion handler should not be called during retries");
+    }];
+
+    completionHandlers[0](nil, nil, nil);
+    [self.session cancelAllRequests];
+
+    [self.testDispatcher advanceTime:30];
+    XCTAssertEqual(1, completionHandlers.count);
 }
 
 - (void)testCancel {
-    [[self.mockQueue expect] cancelAllOperations];
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"POST";
+        builder.URL = [NSURL URLWithString:@"https://example.com"];
+    }];
+
+    [self.session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        XCTFail(@"Completion handler should not be called for cancelled requests");
+    }];
+
+    XCTAssertEqual(1, self.scheduledOperations.count);
+    XCTAssertFalse(self.scheduledOperations.firstObject.isCancelled);
+
     [self.session cancelAllRequests];
+    XCTAssertTrue(self.scheduledOperations.firstObject.isCancelled);
+}
 
-    [self.mockQueue verify];
+/**
+ * Test requests from a session are scheduled with the request host and run in order.
+ */
+- (void)testRequestsRunInOrder {
+    id mockScheduler = [self mockForClass:[UARequestScheduler class]];
+    NSMutableArray<NSOperation *> *operations = [NSMutableArray array];
+    [[[mockScheduler stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        [operations addObject:(__bridge NSOperation *)arg];
+    }] scheduleOperation:OCMOCK_ANY host:@"example.com" priority:UARequestPriorityAnalytics];
+
+    UARequestSession *session = [UARequestSession sessionWithConfig:self.config
+                                                       NSURLSession:self.mockNSURLSession
+                                                          scheduler:mockScheduler
+                                                           priority:UARequestPriorityAnalytics
+                                                         dispatcher:self.testDispatcher];
+
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"POST";
+        builder.URL = [NSURL URLWithString:@"https://example.com/api"];
+    }];
+
+    [session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {}];
+    [session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {}];
+
+    XCTAssertEqual(2, operations.count);
+    XCTAssertEqual(0, operations[0].dependencies.count);
+    XCTAssertEqualObjects(@[operations[0]], operations[1].dependencies);
 }
+
 @end
@@ -109,4 +109,48 @@
     [self.queue waitUntilAllOperationsAreFinished];
 }
 
+- (void)testConcurrentChains {
+    self.queue.maxConcurrentOperationCount = 2;
+
+    // First chain stalls until the second chain finishes
+    XCTestExpectation *secondChainFinished = [self expectationWithDescription:@"second chain finished"];
+    XCTestExpectation *firstChainFinished = [self expectationWithDescription:@"first chain finished"];
+    XCTestExpectation *stalledStarted = [self expectationWithDescription:@"stalled started"];
+
+    __block UARetriableCompletionHandler stalledHandler;
+    UARetriable *stalled = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
+        stalledHandler = completionHandler;
+        [stalledStarted fulfill];
+    }];
+
+    UARetriable *afterStalled = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
+        completionHandler(UARetriableResultSuccess);
+        [firstChainFinished fulfill];
+    }];
+
+    __block NSMutableArray *order = [NSMutableArray array];
+    UARetriable *first = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
+        [order addObject:@"first"];
+        completionHandler(UARetriableResultSuccess);
+    }];
+
+    UARetriable *second = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
+        [order addObject:@"second"];
+        completionHandler(UARetriableResultSuccess);
+        [secondChainFinished fulfill];
+    }];
+
+    [self.pipeline addChainedRetriables:@[stalled, afterStalled]];
+    [self.pipeline addChainedRetriables:@[first, second]];
+
+    [self waitForExpectations:@[stalledStarted, secondChainFinished] timeout:5];
+
+    NSArray *expectedOrder = @[@"first", @"second"];
+    XCTAssertEqualObjects(expectedOrder, order);
+
+    // Unblock the first chain
+    stalledHandler(UARetriableResultSuccess);
+    [self waitForExpectations:@[firstChainFinished] timeout:5];
+}
+
 @end
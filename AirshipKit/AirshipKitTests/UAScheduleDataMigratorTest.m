@@ -139,6 +139,32 @@
     return data;
 }
 
+- (void)testMigration2To3 {
+    NSArray<NSDictionary *> *data = @[@{@"source":@"remote-data", @"display_type":@"modal"},
+                                      @{@"source":@"app-defined", @"extra":@{@"source":@"remote-data"}},
+                                      @{@"display_type":@"banner"}];
+    NSArray *expectedSources = @[@"remote-data", @"app-defined", [NSNull null]];
+
+    for (NSUInteger index = 0; index < data.count; index++) {
+        // Add the old version of the data, without a source
+        UAScheduleData *scheduleData = [NSEntityDescription insertNewObjectForEntityForName:@"UAScheduleData"
+                                                                     inManagedObjectContext:self.managedContext];
+        scheduleData.data = [NSJSONSerialization stringWithObject:data[index]];
+        scheduleData.source = nil;
+        scheduleData.dataVersion = @(2);
+
+        // Migrate
+        [UAScheduleDataMigrator migrateScheduleData:scheduleData
+                                         oldVersion:2
+                                         newVersion:3];
+
+        // Verify the source was copied and the data is unchanged
+        XCTAssertEqual(3, [scheduleData.dataVersion unsignedIntegerValue]);
+        XCTAssertEqualObjects(expectedSources[index], scheduleData.source ?: [NSNull null]);
+        XCTAssertEqualObjects(data[index], [NSJSONSerialization objectWithString:scheduleData.data]);
+    }
+}
+
 - (void)executeTestFromVersion:(NSUInteger)fromVersion toVersion:(NSUInteger)toVersion originalData:(NSArray<NSDictionary *> *)originalData expectedData:(NSArray<NSDictionary *> *)expectedData {
     XCTAssertEqual(originalData.count, expectedData.count);
     for (NSUInteger index = 0; index < originalData.count; index++) {
@@ -147,6 +173,7 @@
                                                                      inManagedObjectContext:self.managedContext];
         scheduleData.data = [NSJSONSerialization stringWithObject:originalData[index]];
         scheduleData.dataVersion = @(fromVersion);
+        long long modificationStamp = [scheduleData.modificationStamp longLongValue];
         
         // Migrate
         [UAScheduleDataMigrator migrateScheduleData:scheduleData
@@ -157,6 +184,9 @@
         XCTAssertEqual(toVersion, [scheduleData.dataVersion unsignedIntegerValue]);
         NSDictionary *migratedData = [NSJSONSerialization objectWithString:scheduleData.data];
         XCTAssertEqualObjects(expectedData[index], migratedData);
+
+        // Verify the schedule is marked as modified
+        XCTAssertEqual(modificationStamp + 1, [scheduleData.modificationStamp longLongValue]);
     }
 }
 
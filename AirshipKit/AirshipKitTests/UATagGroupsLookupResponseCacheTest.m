@@ -0,0 +1,68 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UATagGroupsLookupResponseCache+Internal.h"
+
+@interface UATagGroupsLookupResponseCacheTest : UABaseTest
+@property (nonatomic, strong) UATagGroupsLookupResponseCache *cache;
+@property (nonatomic, strong) UATagGroupsLookupResponse *response;
+@property (nonatomic, strong) UATagGroups *tagGroups;
+@end
+
+@implementation UATagGroupsLookupResponseCacheTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.cache = [UATagGroupsLookupResponseCache cacheWithDataStore:self.dataStore];
+    self.tagGroups = [UATagGroups tagGroupsWithTags:@{@"foo" : @[@"bar", @"baz"]}];
+    self.response = [UATagGroupsLookupResponse responseWithTagGroups:self.tagGroups status:200 lastModifiedTimestamp:@"2018-03-02T22:56:09"];
+}
+
+/**
+ * Test values written by one cache are loaded by another cache on the same data store.
+ */
+- (void)testLoadFromDataStore {
+    self.cache.response = self.response;
+    self.cache.requestedTagGroups = self.tagGroups;
+
+    XCTAssertNotNil(self.cache.refreshDate);
+
+    UATagGroupsLookupResponseCache *cache = [UATagGroupsLookupResponseCache cacheWithDataStore:self.dataStore];
+    XCTAssertEqualObjects(self.tagGroups, cache.response.tagGroups);
+    XCTAssertEqual(200, cache.response.status);
+    XCTAssertEqualObjects(self.tagGroups, cache.requestedTagGroups);
+    XCTAssertEqualObjects(self.cache.refreshDate, cache.refreshDate);
+}
+
+/**
+ * Test repeated reads are served by the data store's decoded object cache.
+ */
+- (void)testReadsReuseDecodedValues {
+    self.cache.response = self.response;
+    self.cache.requestedTagGroups = self.tagGroups;
+
+    UATagGroupsLookupResponse *response = self.cache.response;
+    UATagGroups *requestedTagGroups = self.cache.requestedTagGroups;
+
+    for (NSUInteger i = 0; i < 10; i++) {
+        XCTAssertEqual(response, self.cache.response);
+        XCTAssertEqual(requestedTagGroups, self.cache.requestedTagGroups);
+    }
+}
+
+/**
+ * Test clearing the data store clears the cached values.
+ */
+- (void)testDataStoreReset {
+    self.cache.response = self.response;
+    self.cache.requestedTagGroups = self.tagGroups;
+
+    [self.dataStore removeAll];
+
+    XCTAssertNil(self.cache.response);
+    XCTAssertNil(self.cache.requestedTagGroups);
+    XCTAssertNil(self.cache.refreshDate);
+}
+
+@end
@@ -19,6 +19,7 @@
 @synthesize channelCaptureEnabled;
 @synthesize openURLWhitelistingEnabled;
 @synthesize channelCreationDelayEnabled;
+@synthesize deferredComponentInitializationEnabled;
 @synthesize customConfig;
 @synthesize requestAuthorizationToUseNotifications;
 @synthesize deviceAPIURL;
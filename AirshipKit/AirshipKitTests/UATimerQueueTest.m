@@ -0,0 +1,166 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UATimerQueue+Internal.h"
+#import "UATestDate.h"
+
+@interface UATimerQueueTest : UABaseTest
+@property (nonatomic, strong) UATimerQueue *timerQueue;
+@property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) NSMutableArray<NSTimer *> *scheduledTimers;
+@property (nonatomic, strong) NSMutableArray<NSString *> *fired;
+@end
+
+@implementation UATimerQueueTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.scheduledTimers = [NSMutableArray array];
+    self.fired = [NSMutableArray array];
+
+    UATimerScheduler *timerScheduler = [UATimerScheduler timerSchedulerWithSchedulerBlock:^(NSTimer *timer) {
+        [self.scheduledTimers addObject:timer];
+    }];
+
+    self.timerQueue = [UATimerQueue timerQueueWithTimerScheduler:timerScheduler date:self.testDate];
+}
+
+- (void)tearDown {
+    [self.timerQueue cancelAll];
+    [super tearDown];
+}
+
+- (void)addTimer:(NSString *)identifier group:(NSString *)group timeInterval:(NSTimeInterval)timeInterval {
+    [self.timerQueue addTimerWithIdentifier:identifier group:group timeInterval:timeInterval block:^{
+        [self.fired addObject:identifier];
+    }];
+}
+
+/**
+ * Returns the only valid scheduled timer.
+ */
+- (NSTimer *)validTimer {
+    NSPredicate *valid = [NSPredicate predicateWithFormat:@"valid == YES"];
+    NSArray *timers = [self.scheduledTimers filteredArrayUsingPredicate:valid];
+    XCTAssertLessThanOrEqual(timers.count, 1);
+    return timers.firstObject;
+}
+
+- (void)advanceTime:(NSTimeInterval)time {
+    self.testDate.absoluteTime = [self.testDate.absoluteTime dateByAddingTimeInterval:time];
+    [[self validTimer] fire];
+}
+
+/**
+ * Test timers fire in order with a single backing timer.
+ */
+- (void)testFireOrder {
+    [self addTimer:@"c" group:nil timeInterval:30];
+    [self addTimer:@"a" group:nil timeInterval:10];
+    [self addTimer:@"b" group:nil timeInterval:20];
+
+    XCTAssertEqual(3, self.timerQueue.count);
+    XCTAssertEqualWithAccuracy(10, [self validTimer].timeInterval, 0.01);
+
+    [self advanceTime:10];
+    XCTAssertEqualObjects(@[@"a"], self.fired);
+    XCTAssertEqualWithAccuracy(10, [self validTimer].timeInterval, 0.01);
+
+    [self advanceTime:20];
+    XCTAssertEqualObjects((@[@"a", @"b", @"c"]), self.fired);
+    XCTAssertEqual(0, self.timerQueue.count);
+    XCTAssertNil([self validTimer]);
+}
+
+/**
+ * Test a timer that fires early still fires the timers it was scheduled for.
+ */
+- (void)testFireEarly {
+    [self addTimer:@"a" group:nil timeInterval:10];
+    [self addTimer:@"b" group:nil timeInterval:20];
+
+    [[self validTimer] fire];
+    XCTAssertEqualObjects(@[@"a"], self.fired);
+    XCTAssertEqual(1, self.timerQueue.count);
+}
+
+/**
+ * Test cancelling by identifier.
+ */
+- (void)testCancelByIdentifier {
+    [self addTimer:@"a" group:nil timeInterval:10];
+    [self addTimer:@"b" group:nil timeInterval:20];
+
+    [self.timerQueue cancelTimerWithIdentifier:@"a"];
+    XCTAssertEqual(1, self.timerQueue.count);
+
+    // Backing timer moves to the next timer
+    XCTAssertEqualWithAccuracy(20, [self validTimer].timeInterval, 0.01);
+
+    [self advanceTime:20];
+    XCTAssertEqualObjects(@[@"b"], self.fired);
+}
+
+/**
+ * Test cancelling by group.
+ */
+- (void)testCancelByGroup {
+    [self addTimer:@"a" group:@"foo" timeInterval:10];
+    [self addTimer:@"b" group:@"bar" timeInterval:20];
+    [self addTimer:@"c" group:@"foo" timeInterval:30];
+
+    [self.timerQueue cancelTimersWithGroup:@"foo"];
+    XCTAssertEqual(1, self.timerQueue.count);
+
+    [self advanceTime:30];
+    XCTAssertEqualObjects(@[@"b"], self.fired);
+}
+
+/**
+ * Test adding a timer with an existing identifier replaces it.
+ */
+- (void)testReplace {
+    [self addTimer:@"a" group:nil timeInterval:10];
+    [self addTimer:@"a" group:nil timeInterval:30];
+    XCTAssertEqual(1, self.timerQueue.count);
+
+    [self advanceTime:10];
+    XCTAssertEqualObjects(@[], self.fired);
+
+    [self advanceTime:20];
+    XCTAssertEqualObjects(@[@"a"], self.fired);
+}
+
+/**
+ * Test cancelling all timers invalidates the backing timer.
+ */
+- (void)testCancelAll {
+    [self addTimer:@"a" group:@"foo" timeInterval:10];
+    [self addTimer:@"b" group:nil timeInterval:20];
+
+    [self.timerQueue cancelAll];
+    XCTAssertEqual(0, self.timerQueue.count);
+    XCTAssertNil([self validTimer]);
+}
+
+/**
+ * Test many timers with cancellations fire in order.
+ */
+- (void)testManyTimers {
+    for (NSUInteger i = 0; i < 500; i++) {
+        NSString *identifier = [NSString stringWithFormat:@"%03lu", (unsigned long)(499 - i)];
+        [self addTimer:identifier group:(i % 2) ? @"odd" : @"even" timeInterval:500 - i];
+    }
+
+    [self.timerQueue cancelTimersWithGroup:@"odd"];
+    XCTAssertEqual(250, self.timerQueue.count);
+
+    [self advanceTime:500];
+
+    XCTAssertEqual(250, self.fired.count);
+    XCTAssertEqualObjects([self.fired sortedArrayUsingSelector:@selector(compare:)], self.fired);
+}
+
+@end
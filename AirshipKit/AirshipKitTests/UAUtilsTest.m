@@ -220,6 +220,100 @@
     XCTAssertEqualWithAccuracy(seconds,0.123,0.0001);
 }
 
+/**
+ * Test the fixed layout parser matches the date formatters.
+ */
+- (void)testParseISO8601MatchesFormatters {
+    NSArray *timestamps = @[@"1970",
+                            @"1999-02",
+                            @"2000-02-29",
+                            @"2020-12-15T11",
+                            @"2020-12-15 11:45",
+                            @"2020-12-15T23:59:59",
+                            @"2020-12-15 11:45:22",
+                            @"2020-12-15T11:45:22.123",
+                            @"1969-07-20T20:17:40"];
+
+    for (NSString *timestamp in timestamps) {
+        NSDate *expected = [UAUtils parseISO8601DateWithFormatters:timestamp];
+        NSDate *date = [UAUtils parseISO8601DateFromString:timestamp];
+        XCTAssertNotNil(date, @"Failed to parse %@", timestamp);
+        XCTAssertEqualWithAccuracy(expected.timeIntervalSince1970, date.timeIntervalSince1970, 0.0001, @"Mismatch for %@", timestamp);
+    }
+}
+
+/**
+ * Test fractional seconds with a space delimiter.
+ */
+- (void)testParseISO8601FractionalSecondsWithSpace {
+    NSDate *date = [UAUtils parseISO8601DateFromString:@"2020-12-15 11:45:22.5"];
+    NSDate *expected = [UAUtils parseISO8601DateFromString:@"2020-12-15T11:45:22"];
+    XCTAssertEqualWithAccuracy([date timeIntervalSinceDate:expected], 0.5, 0.0001);
+}
+
+/**
+ * Test invalid timestamps.
+ */
+- (void)testParseISO8601Invalid {
+    XCTAssertNil([UAUtils parseISO8601DateFromString:@""]);
+    XCTAssertNil([UAUtils parseISO8601DateFromString:@"not a date"]);
+    XCTAssertNil([UAUtils parseISO8601DateFromString:@"2020-12-15T"]);
+}
+
+/**
+ * Benchmark parsing 10,000 timestamps.
+ */
+- (void)testParseISO8601Performance {
+    NSArray<NSString *> *timestamps = [self benchmarkTimestamps];
+
+    [self measureBlock:^{
+        for (NSString *timestamp in timestamps) {
+            [UAUtils parseISO8601DateFromString:timestamp];
+        }
+    }];
+}
+
+/**
+ * Benchmark parsing 10,000 timestamps with date formatters created per call, as
+ * parseISO8601DateFromString: did before the fixed layout parser.
+ */
+- (void)testParseISO8601FormatterPerformance {
+    NSArray<NSString *> *timestamps = [self benchmarkTimestamps];
+    NSArray *formats = @[@"yyyy-MM-dd'T'HH:mm:ss.SSS",
+                         @"yyyy-MM-dd'T'HH:mm:ss",
+                         @"yyyy-MM-dd HH:mm:ss",
+                         @"yyyy-MM-dd'T'HH:mm",
+                         @"yyyy-MM-dd HH:mm",
+                         @"yyyy-MM-dd'T'HH",
+                         @"yyyy-MM-dd HH",
+                         @"yyyy-MM-dd",
+                         @"yyyy-MM",
+                         @"yyyy"];
+
+    [self measureBlock:^{
+        for (NSString *timestamp in timestamps) {
+            NSDateFormatter *dateFormatter = [UAUtils ISODateFormatterUTC];
+            for (NSString *format in formats) {
+                dateFormatter.dateFormat = format;
+                if ([dateFormatter dateFromString:timestamp]) {
+                    break;
+                }
+            }
+        }
+    }];
+}
+
+- (NSArray<NSString *> *)benchmarkTimestamps {
+    NSDateFormatter *dateFormatter = [UAUtils ISODateFormatterUTCWithDelimiter];
+    NSMutableArray *timestamps = [NSMutableArray arrayWithCapacity:10000];
+    for (NSUInteger i = 0; i < 10000; i++) {
+        NSDate *date = [NSDate dateWithTimeIntervalSince1970:1600000000 + (i * 3607)];
+        [timestamps addObject:[dateFormatter stringFromDate:date]];
+    }
+
+    return timestamps;
+}
+
 /**
  * Test isSilentPush is YES when no notification alerts exist in the payload.
  */
@@ -317,4 +317,43 @@
     XCTAssertFalse([matcher evaluateObject:@"3.0"]);
     XCTAssertFalse([matcher evaluateObject:@"999.999.999"]);
 }
+
+- (void)testVersionRangeMatcherCacheEviction {
+    UAVersionMatcher *matcher = [UAVersionMatcher matcherWithVersionConstraint:@"[1.0, 2.0["];
+    XCTAssertNotNil(matcher);
+
+    // More distinct versions than the components cache holds, so entries are evicted while matching
+    for (NSUInteger i = 0; i < 1000; i++) {
+        XCTAssertTrue([matcher evaluateObject:[NSString stringWithFormat:@"1.%lu", (unsigned long)i]]);
+        XCTAssertFalse([matcher evaluateObject:[NSString stringWithFormat:@"2.%lu", (unsigned long)i]]);
+    }
+
+    // The bounds are still intact
+    XCTAssertTrue([matcher evaluateObject:@"1.0"]);
+    XCTAssertFalse([matcher evaluateObject:@"2.0"]);
+}
+
+- (void)testEvaluatePerformance {
+    // Note: "[" marks an exclusive end boundary
+    NSArray<UAVersionMatcher *> *matchers = @[[UAVersionMatcher matcherWithVersionConstraint:@"1.2"],
+                                              [UAVersionMatcher matcherWithVersionConstraint:@"1.2+"],
+                                              [UAVersionMatcher matcherWithVersionConstraint:@"[1.0, 2.0["]];
+
+    NSArray<NSString *> *versions = @[@"1.2", @"1.2.3", @"1.5", @"2.0", @"0.9.9"];
+
+    for (UAVersionMatcher *matcher in matchers) {
+        XCTAssertNotNil(matcher);
+    }
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 1000; i++) {
+            for (UAVersionMatcher *matcher in matchers) {
+                for (NSString *version in versions) {
+                    [matcher evaluateObject:version];
+                }
+            }
+        }
+    }];
+}
+
 @end
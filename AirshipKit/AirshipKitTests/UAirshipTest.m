@@ -1,14 +1,196 @@
 
 #import <UIKit/UIKit.h>
 #import "UABaseTest.h"
-#import "UAirship.h"
+#import "UAirship+Internal.h"
 #import "UAConfig.h"
 
 @interface UAirshipTest : UABaseTest
+@property (nonatomic, strong) NSMutableArray<NSString *> *startupStages;
 @end
 
 @implementation UAirshipTest
 
+- (void)setUp {
+    [super setUp];
+
+    self.startupStages = [NSMutableArray array];
+    [UAirship setStartupMetricsHandler:^(NSString *stage, NSTimeInterval duration) {
+        XCTAssertTrue([NSThread isMainThread]);
+        XCTAssertGreaterThanOrEqual(duration, 0);
+        [self.startupStages addObject:stage];
+    }];
+}
+
+- (void)tearDown {
+    [UAirship setStartupMetricsHandler:nil];
+    [UAirship setSharedAirship:nil];
+    [super tearDown];
+}
+
+- (UAirship *)airshipWithDeferredComponents:(BOOL)deferred {
+    self.config.deferredComponentInitializationEnabled = deferred;
+    UAirship *airship = [[UAirship alloc] initWithRuntimeConfig:self.config dataStore:self.dataStore];
+    [UAirship setSharedAirship:airship];
+    return airship;
+}
+
+/**
+ * Test all components are created during init when deferred initialization is disabled.
+ */
+- (void)testComponentsCreatedWithoutDeferredInitialization {
+    UAirship *airship = [self airshipWithDeferredComponents:NO];
+
+    XCTAssertNotNil(airship.sharedChannel);
+    XCTAssertNotNil(airship.sharedAutomation);
+    XCTAssertNotNil(airship.sharedRemoteDataManager);
+    XCTAssertNotNil(airship.sharedInAppMessageManager);
+    XCTAssertNotNil(airship.sharedInbox);
+
+    NSArray *expected = @[UAirshipStartupStageLaunch,
+                          UAirshipStartupStageAutomation,
+                          UAirshipStartupStageRemoteData,
+                          UAirshipStartupStageInAppMessaging,
+                          UAirshipStartupStageMessageCenter];
+    XCTAssertEqualObjects(expected, self.startupStages);
+}
+
+/**
+ * Test deferred initialization only creates the launch components.
+ */
+- (void)testDeferredInitialization {
+    UAirship *airship = [self airshipWithDeferredComponents:YES];
+
+    XCTAssertNotNil(airship.sharedChannel);
+    XCTAssertNotNil(airship.sharedPush);
+    XCTAssertNotNil(airship.sharedAnalytics);
+    XCTAssertNil(airship.sharedAutomation);
+    XCTAssertNil(airship.sharedRemoteDataManager);
+    XCTAssertNil(airship.sharedInAppMessageManager);
+    XCTAssertNil(airship.sharedInbox);
+
+    XCTAssertEqualObjects(@[UAirshipStartupStageLaunch], self.startupStages);
+}
+
+/**
+ * Test accessors create only the deferred stages they need, once.
+ */
+- (void)testAccessorTriggeredInitialization {
+    UAirship *airship = [self airshipWithDeferredComponents:YES];
+
+    XCTAssertNotNil([UAirship automation]);
+    XCTAssertNil(airship.sharedRemoteDataManager);
+
+    // IAM creates remote data first
+    XCTAssertNotNil([UAirship inAppMessageManager]);
+    XCTAssertEqual(airship.sharedRemoteDataManager, [UAirship remoteDataManager]);
+    XCTAssertNil(airship.sharedInbox);
+
+    XCTAssertNotNil([UAirship automation]);
+
+    NSArray *expected = @[UAirshipStartupStageLaunch,
+                          UAirshipStartupStageAutomation,
+                          UAirshipStartupStageRemoteData,
+                          UAirshipStartupStageInAppMessaging];
+    XCTAssertEqualObjects(expected, self.startupStages);
+}
+
+/**
+ * Test a deferred accessor used off the main thread while the main thread waits on it.
+ */
+- (void)testAccessorTriggeredInitializationOffMainThread {
+    [self airshipWithDeferredComponents:YES];
+
+    __block UAAutomation *automation;
+    dispatch_sync(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        automation = [UAirship automation];
+    });
+
+    XCTAssertNotNil(automation);
+    XCTAssertEqual(automation, [UAirship automation]);
+
+    // Metrics are reported on the main queue
+    XCTestExpectation *reported = [self expectationWithDescription:@"reported"];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [reported fulfill];
+    });
+    [self waitForTestExpectations];
+
+    NSArray *expected = @[UAirshipStartupStageLaunch, UAirshipStartupStageAutomation];
+    XCTAssertEqualObjects(expected, self.startupStages);
+}
+
+/**
+ * Test the scheduled deferred components are created on the run loop after the app becomes active.
+ */
+- (void)testScheduledDeferredComponentsCreatedAfterActive {
+    UAirship *airship = [self airshipWithDeferredComponents:YES];
+
+    [airship scheduleDeferredComponents];
+    [(id<UAAppStateTrackerDelegate>)[UAirship class] applicationDidBecomeActive];
+
+    // Not created within the current run loop
+    XCTAssertNil(airship.sharedAutomation);
+    XCTAssertNil(airship.sharedInbox);
+
+    XCTestExpectation *created = [self expectationWithDescription:@"created"];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [created fulfill];
+    });
+    [self waitForTestExpectations];
+
+    XCTAssertNotNil(airship.sharedAutomation);
+    XCTAssertNotNil(airship.sharedRemoteDataManager);
+    XCTAssertNotNil(airship.sharedInAppMessageManager);
+    XCTAssertNotNil(airship.sharedInbox);
+
+    NSArray *expected = @[UAirshipStartupStageLaunch,
+                          UAirshipStartupStageAutomation,
+                          UAirshipStartupStageRemoteData,
+                          UAirshipStartupStageInAppMessaging,
+                          UAirshipStartupStageMessageCenter];
+    XCTAssertEqualObjects(expected, self.startupStages);
+}
+
+/**
+ * Test deferred stages are created once when their accessors are used from several threads,
+ * including the main thread, at the same time.
+ */
+- (void)testAccessorTriggeredInitializationConcurrently {
+    [self airshipWithDeferredComponents:YES];
+
+    NSUInteger count = 20;
+    NSMutableArray *automations = [NSMutableArray array];
+    NSMutableArray *inAppMessageManagers = [NSMutableArray array];
+
+    // Runs some of the iterations on the main thread
+    dispatch_apply(count, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        UAInAppMessageManager *inAppMessageManager = [UAirship inAppMessageManager];
+        UAAutomation *automation = [UAirship automation];
+
+        @synchronized (automations) {
+            [automations addObject:automation];
+            [inAppMessageManagers addObject:inAppMessageManager];
+        }
+    });
+
+    XCTAssertEqual(count, automations.count);
+    XCTAssertEqual(1, [NSSet setWithArray:automations].count);
+    XCTAssertEqual(1, [NSSet setWithArray:inAppMessageManagers].count);
+
+    // Metrics are reported on the main queue
+    XCTestExpectation *reported = [self expectationWithDescription:@"reported"];
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [reported fulfill];
+    });
+    [self waitForTestExpectations];
+
+    NSSet *expected = [NSSet setWithArray:@[UAirshipStartupStageLaunch,
+                                            UAirshipStartupStageAutomation,
+                                            UAirshipStartupStageRemoteData,
+                                            UAirshipStartupStageInAppMessaging]];
+    XCTAssertEqual(expected.count, self.startupStages.count);
+    XCTAssertEqualObjects(expected, [NSSet setWithArray:self.startupStages]);
+}
 
 /**
  * Test that if takeOff is called on a background thread that an exception is thrown.